@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -13,13 +14,39 @@ extern "C" {
  */
 void grlc_app_init(void);
 
+/** @brief App wake-up reason: UART RX data or TX completion. */
+#define GRLC_APP_EVT_UART 0x01u
+/** @brief App wake-up reason: BLE RX data or BLE TX space. */
+#define GRLC_APP_EVT_BLE 0x02u
+/** @brief Tick return value meaning "no timed work; sleep until an event". */
+#define GRLC_APP_WAIT_FOREVER UINT32_MAX
+
+struct k_event;
+
+/**
+ * @brief Sleep until any bit in @p mask is posted to @p evt or @p wait_ms elapses,
+ *        then clear the bits that fired. Used by the app thread and per-link threads.
+ * @param evt     Event object to wait on.
+ * @param mask    Bits of interest.
+ * @param wait_ms Timeout in milliseconds, or GRLC_APP_WAIT_FOREVER.
+ */
+void grlc_app_wait(struct k_event *evt, uint32_t mask, uint32_t wait_ms);
+
 /**
- * @brief Periodic application tick.
+ * @brief Wake the app thread (ISR-safe).
+ * @param events Bitmask of GRLC_APP_EVT_* flags.
+ */
+void grlc_app_notify(uint32_t events);
+
+/**
+ * @brief Application tick.
  *
  * Services UART DMA, feeds the transport parser, updates heartbeats/LEDs,
  * and performs 1 Hz status work.
+ *
+ * @return Milliseconds until the next timed work is due, or GRLC_APP_WAIT_FOREVER.
  */
-void grlc_app_tick(void);
+uint32_t grlc_app_tick(void);
 
 /**
  * @brief Enable or disable BLE advertising.
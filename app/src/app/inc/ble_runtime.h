@@ -1,9 +1,14 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
 /** @brief Initialize BLE runtime (NUS driver and transport binding). */
 void grlc_ble_runtime_init(void);
 
-/** @brief Periodic BLE runtime tick: update status LED. */
-void grlc_ble_runtime_tick(void);
+/**
+ * @brief BLE runtime tick: update status LED, and pump transport TX when the
+ *        link is not running in its own thread (GRLC_BLE_RT_THREAD=0).
+ * @return Milliseconds until the next timed work is due, or GRLC_APP_WAIT_FOREVER.
+ */
+uint32_t grlc_ble_runtime_tick(void);
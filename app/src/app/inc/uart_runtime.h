@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 
 /**
  * @brief Initialize UART runtime (driver + transport binding).
@@ -8,8 +9,18 @@
 void grlc_uart_runtime_init(void);
 
 /**
- * @brief Periodic UART runtime tick.
+ * @brief UART runtime tick.
  *
- * Drains RX bytes into the transport parser and services UART TX.
+ * Drains RX bytes into the transport parser and services UART TX. A no-op when
+ * the link runs in its own thread (GRLC_UART_RT_THREAD, the default).
+ *
+ * @return Milliseconds until the runtime must be serviced again without an
+ *         event, or GRLC_APP_WAIT_FOREVER.
+ */
+uint32_t grlc_uart_runtime_tick(void);
+
+/**
+ * @brief Log request-to-response latency (RX ISR to first response byte queued)
+ *        observed since the previous call, then reset the window.
  */
-void grlc_uart_runtime_tick(void);
+void grlc_uart_runtime_report_latency(void);
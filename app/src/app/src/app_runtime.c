@@ -8,6 +8,7 @@
 #include <SEGGER_RTT.h>
 #endif
 
+#include "app/inc/app_runtime.h"
 #include "app/inc/ble_runtime.h"
 #include "app/inc/uart_runtime.h"
 #include "drivers/ble_nus/inc/ble_nus.h"
@@ -18,7 +19,39 @@ LOG_MODULE_REGISTER(app_runtime, LOG_LEVEL_INF);
 #define LED0_NODE DT_ALIAS(led0)
 static const struct gpio_dt_spec led = GPIO_DT_SPEC_GET(LED0_NODE, gpios);
 
+#define APP_LED_PERIOD_MS 333U
+#define APP_HB_PERIOD_MS  1000U
+
 static uint32_t last_led_time = 0;
+static uint32_t last_hb = 0;
+
+/* Wake-up sources for the app thread (posted from ISRs and BT callbacks) */
+static K_EVENT_DEFINE(s_app_events);
+
+void grlc_app_notify(uint32_t events)
+{
+    k_event_post(&s_app_events, events);
+}
+
+void grlc_app_wait(struct k_event *evt, uint32_t mask, uint32_t wait_ms)
+{
+    k_timeout_t timeout = (wait_ms == GRLC_APP_WAIT_FOREVER) ? K_FOREVER : K_MSEC(wait_ms);
+    uint32_t ev = k_event_wait(evt, mask, false, timeout);
+    k_event_clear(evt, ev);
+}
+
+/**
+ * @brief Milliseconds remaining until a periodic deadline.
+ * @param now    Current uptime (ms).
+ * @param last   Time the work last ran (ms).
+ * @param period Period of the work (ms).
+ * @return Remaining time, 0 if already due.
+ */
+static uint32_t until_due(uint32_t now, uint32_t last, uint32_t period)
+{
+    uint32_t elapsed = now - last;
+    return (elapsed >= period) ? 0U : (period - elapsed);
+}
 
 void grlc_app_init(void)
 {
@@ -44,26 +77,32 @@ void grlc_app_init(void)
     }
 }
 
-void grlc_app_tick(void)
+uint32_t grlc_app_tick(void)
 {
     uint32_t now = k_uptime_get_32();
+    uint32_t next = GRLC_APP_WAIT_FOREVER;
 
-    if (gpio_is_ready_dt(&led) && (now - last_led_time) >= 333U) {
-        gpio_pin_toggle_dt(&led);
-        last_led_time = now;
+    if (gpio_is_ready_dt(&led)) {
+        if ((now - last_led_time) >= APP_LED_PERIOD_MS) {
+            gpio_pin_toggle_dt(&led);
+            last_led_time = now;
+        }
+        next = until_due(now, last_led_time, APP_LED_PERIOD_MS);
     }
 
     /* Delegate to interface runtimes */
-    grlc_uart_runtime_tick();
-    grlc_ble_runtime_tick();
+    next = MIN(next, grlc_uart_runtime_tick());
+    next = MIN(next, grlc_ble_runtime_tick());
 
-    static uint32_t last_hb = 0;
-    if ((now - last_hb) >= 1000U) {
+    if ((now - last_hb) >= APP_HB_PERIOD_MS) {
 #if defined(CONFIG_USE_SEGGER_RTT)
         SEGGER_RTT_WriteString(0, "RTT: hb\n");
 #endif
+        grlc_uart_runtime_report_latency();
         last_hb = now;
     }
+    next = MIN(next, until_due(now, last_hb, APP_HB_PERIOD_MS));
+    return next;
 }
 
 /*
@@ -87,8 +126,8 @@ static void app_thread(void *a, void *b, void *c)
 
     grlc_app_init();
     while (1) {
-        grlc_app_tick();
-        k_msleep(5);
+        /* Sleep until an RX/TX event arrives or the next timed work is due */
+        grlc_app_wait(&s_app_events, GRLC_APP_EVT_UART | GRLC_APP_EVT_BLE, grlc_app_tick());
     }
 }
 
@@ -6,57 +6,233 @@
 
 #if defined(CONFIG_BT) && defined(CONFIG_BT_ZEPHYR_NUS)
 
+#include "app/inc/app_runtime.h"
+#include "app/inc/ble_runtime.h"
 #include "drivers/ble_nus/inc/ble_nus.h"
 #include "proto/inc/transport.h"
 #include "stack/cmd_transport/inc/cmd_transport.h"
+#include "stack/flash_stream/inc/flash_stream.h"
+#include "stack/flash_writer/inc/flash_writer.h"
+#include "stack/telemetry/inc/telemetry.h"
+#include "utils/circular_buffer/inc/circular_buffer.h"
 
 LOG_MODULE_REGISTER(ble_runtime, LOG_LEVEL_INF);
 
+/* Run BLE transport servicing in its own, lower-priority thread than UART */
+#ifndef GRLC_BLE_RT_THREAD
+#define GRLC_BLE_RT_THREAD 1
+#endif
+#ifndef GRLC_BLE_RT_PRIO
+#define GRLC_BLE_RT_PRIO K_PRIO_PREEMPT(8)
+#endif
+#ifndef GRLC_BLE_RT_STACK_SIZE
+#define GRLC_BLE_RT_STACK_SIZE 2048
+#endif
+
+/*
+ * One link per BLE connection slot, each with its own transport, command
+ * binding and RX ring. NUS RX bytes are copied into the link's ring in BT
+ * host context (single producer) and parsed by the BLE link thread (single
+ * consumer), so command dispatch never runs on the Bluetooth RX thread.
+ *
+ * Both sides count the bytes they pass through the ring. On disconnect the
+ * producer records its count, and the link reset drops everything up to that
+ * mark, so bytes the previous central left queued are never parsed for the
+ * next central on the slot, while bytes the new central already sent are kept.
+ */
+#ifndef GRLC_BLE_RX_RING_SIZE
+#define GRLC_BLE_RX_RING_SIZE 1024
+#endif
+
 #define LED1_NODE DT_ALIAS(led1)
 static const struct gpio_dt_spec ble_led = GPIO_DT_SPEC_GET(LED1_NODE, gpios);
 static uint32_t s_last_led_time;
 
-static struct transport_ctx s_ble_transport;
-static struct cmd_transport_binding s_ble_cmd;
+struct ble_link {
+    struct transport_ctx transport;
+    struct cmd_transport_binding cmd;
+    struct transport_lower_if lower;
+    circular_buffer_t rx_ring;
+    uint8_t rx_storage[GRLC_BLE_RX_RING_SIZE];
+    atomic_t rx_dropped;
+    uint32_t rx_in;  /* bytes queued (BT context only) */
+    uint32_t rx_out; /* bytes parsed or flushed (link thread only) */
+    atomic_t rx_cut; /* rx_in when the last central left */
+};
+
+static struct ble_link s_links[GRLC_BLE_MAX_LINKS];
+static atomic_t s_link_reset; /* bit per link: slot changed hands */
+
+#if GRLC_BLE_RT_THREAD
+static K_EVENT_DEFINE(s_ble_events);
+#endif
 
-static size_t lower_write_ble(const uint8_t *data, size_t len)
+/** @brief Wake whichever thread services the BLE links. */
+static void ble_wake(void)
 {
-    return grlc_ble_send(data, len);
+#if GRLC_BLE_RT_THREAD
+    k_event_post(&s_ble_events, GRLC_APP_EVT_BLE);
+#else
+    grlc_app_notify(GRLC_APP_EVT_BLE);
+#endif
 }
 
-static const struct transport_lower_if lower_if_ble = {
-    .write = lower_write_ble,
-};
+static size_t lower_write_ble(void *ctx, const uint8_t *data, size_t len)
+{
+    const struct ble_link *l = (const struct ble_link *)ctx;
+    return grlc_ble_send((uint8_t)(l - s_links), data, len);
+}
+
+/** @brief NUS RX callback (BT host context): queue bytes and return at once. */
+static void ble_rx_shim(uint8_t link, const uint8_t *data, size_t len, void *user)
+{
+    ARG_UNUSED(user);
+    if (link < GRLC_BLE_MAX_LINKS && data && len) {
+        struct ble_link *l = &s_links[link];
+        size_t n = grlc_cb_write(&l->rx_ring, data, len);
+        l->rx_in += (uint32_t)n;
+        if (n < len) {
+            /* The transport CRC rejects the torn frame; the host retries */
+            atomic_add(&l->rx_dropped, (atomic_val_t)(len - n));
+        }
+        ble_wake();
+    }
+}
+
+/** @brief Connection change (BT context): have the link thread reset the slot. */
+static void ble_conn_shim(uint8_t link, bool connected, void *user)
+{
+    ARG_UNUSED(user);
+    if (link < GRLC_BLE_MAX_LINKS) {
+        if (!connected) {
+            /* Same context as ble_rx_shim: everything queued so far is the old central's */
+            atomic_set(&s_links[link].rx_cut, (atomic_val_t)s_links[link].rx_in);
+        }
+        atomic_set_bit(&s_link_reset, link);
+        ble_wake();
+    }
+}
 
-static void ble_rx_shim(const uint8_t *data, size_t len, void *user)
+/** @brief Drop queued RX, parser, reassembly and pending-response state of a reused slot. */
+static void ble_link_reset(struct ble_link *l)
 {
-    struct transport_ctx *t = (struct transport_ctx *)user;
-    if (t && data && len) {
-        grlc_transport_rx_bytes(t, data, len);
+    int32_t stale = (int32_t)((uint32_t)atomic_get(&l->rx_cut) - l->rx_out);
+    if (stale > 0) {
+        grlc_cb_advance_read(&l->rx_ring, (size_t)stale);
+        l->rx_out += (uint32_t)stale;
     }
+    (void)grlc_telemetry_unsubscribe(&l->cmd, 0);
+    (void)grlc_flash_stream_cancel(&l->cmd);
+    grlc_transport_reset(&l->transport);
+    grlc_cmd_transport_bind(&l->cmd, &l->transport);
 }
 
+/** @brief Feed queued NUS bytes to the link's parser in contiguous spans. */
+static void ble_rx_drain(struct ble_link *l)
+{
+    uint8_t *span;
+    size_t span_len;
+    while (grlc_cb_get_read_block(&l->rx_ring, &span, &span_len) == 0) {
+        grlc_transport_rx_bytes(&l->transport, span, span_len);
+        grlc_cb_advance_read(&l->rx_ring, span_len);
+        l->rx_out += (uint32_t)span_len;
+    }
+    atomic_val_t dropped = atomic_set(&l->rx_dropped, 0);
+    if (dropped) {
+        LOG_WRN("BLE link %u RX ring full: dropped %ld bytes", (unsigned)(l - s_links),
+                (long)dropped);
+    }
+}
+
+/**
+ * @brief Service all BLE links once: RX parsing, TX pump and pending responses.
+ * @return Milliseconds until the next retry, or GRLC_APP_WAIT_FOREVER.
+ */
+static uint32_t ble_service(void)
+{
+    bool busy = false;
+    uint32_t wait = GRLC_APP_WAIT_FOREVER;
+    for (size_t i = 0; i < GRLC_BLE_MAX_LINKS; ++i) {
+        struct ble_link *l = &s_links[i];
+        if (atomic_test_and_clear_bit(&s_link_reset, i)) {
+            ble_link_reset(l);
+        }
+        ble_rx_drain(l);
+        grlc_transport_tx_pump(&l->transport);
+        grlc_cmd_transport_tick(&l->cmd);
+        uint32_t due = grlc_telemetry_service(&l->cmd, k_uptime_get_32());
+        if (due < wait) {
+            wait = due;
+        }
+        due = grlc_flash_stream_service(&l->cmd);
+        if (due < wait) {
+            wait = due;
+        }
+        busy = busy || l->transport.tx_in_progress || l->cmd.pending;
+    }
+    /* Erase-ahead for FLASH_WRITE, now that the responses are queued */
+    (void)grlc_flash_writer_service();
+    /* Notification completions wake us (ble_wake); the timeout is only a safety net */
+    if (busy && wait > 50U) {
+        wait = 50U;
+    }
+    return wait;
+}
+
+#if GRLC_BLE_RT_THREAD
+static void ble_rt_thread(void *a, void *b, void *c)
+{
+    ARG_UNUSED(a);
+    ARG_UNUSED(b);
+    ARG_UNUSED(c);
+    while (1) {
+        grlc_app_wait(&s_ble_events, GRLC_APP_EVT_BLE, ble_service());
+    }
+}
+
+/* Started from grlc_ble_runtime_init() once the transport is bound */
+K_THREAD_DEFINE(garlic_ble_rt, GRLC_BLE_RT_STACK_SIZE, ble_rt_thread, NULL, NULL, NULL,
+                GRLC_BLE_RT_PRIO, 0, SYS_FOREVER_MS);
+#endif
+
 void grlc_ble_runtime_init(void)
 {
     if (gpio_is_ready_dt(&ble_led)) {
         (void)gpio_pin_configure_dt(&ble_led, GPIO_OUTPUT_INACTIVE);
     }
 
-    grlc_cmd_transport_bind(&s_ble_cmd, &s_ble_transport);
-    grlc_transport_init(&s_ble_transport, &lower_if_ble, grlc_cmd_get_transport_cb(), &s_ble_cmd);
-    int ble_rc = grlc_ble_init(ble_rx_shim, &s_ble_transport);
+    for (size_t i = 0; i < GRLC_BLE_MAX_LINKS; ++i) {
+        struct ble_link *l = &s_links[i];
+        l->lower.write_ctx = lower_write_ble;
+        l->lower.ctx = l;
+        grlc_cmd_transport_bind(&l->cmd, &l->transport);
+        grlc_transport_init(&l->transport, &l->lower, grlc_cmd_get_transport_cb(), &l->cmd);
+        grlc_cb_init(&l->rx_ring, l->rx_storage, sizeof(l->rx_storage));
+    }
+    grlc_ble_set_tx_notify(ble_wake);
+    grlc_ble_set_conn_notify(ble_conn_shim, NULL);
+    int ble_rc = grlc_ble_init(ble_rx_shim, NULL);
     if (ble_rc == 0) {
         LOG_INF("BLE ready");
     } else {
         LOG_WRN("BLE init failed: %d", ble_rc);
     }
     grlc_cmd_transport_init();
+#if GRLC_BLE_RT_THREAD
+    k_thread_start(garlic_ble_rt);
+#endif
 }
 
-void grlc_ble_runtime_tick(void)
+uint32_t grlc_ble_runtime_tick(void)
 {
+#if GRLC_BLE_RT_THREAD
+    uint32_t next = GRLC_APP_WAIT_FOREVER;
+#else
+    uint32_t next = ble_service();
+#endif
+
     if (!gpio_is_ready_dt(&ble_led)) {
-        return;
+        return next;
     }
     uint32_t now = k_uptime_get_32();
     bool adv = false, connected = false;
@@ -64,22 +240,30 @@ void grlc_ble_runtime_tick(void)
     if (connected) {
         gpio_pin_set_dt(&ble_led, 1);
     } else if (adv) {
-        if ((now - s_last_led_time) >= 250U) {
+        uint32_t elapsed = now - s_last_led_time;
+        if (elapsed >= 250U) {
             gpio_pin_toggle_dt(&ble_led);
             s_last_led_time = now;
+            elapsed = 0;
         }
+        next = MIN(next, 250U - elapsed);
     } else {
         gpio_pin_set_dt(&ble_led, 0);
     }
+    return next;
 }
 
 #else /* !CONFIG_BT || !CONFIG_BT_ZEPHYR_NUS */
 
+#include "app/inc/app_runtime.h"
+#include "app/inc/ble_runtime.h"
+
 void grlc_ble_runtime_init(void)
 {
 }
-void grlc_ble_runtime_tick(void)
+uint32_t grlc_ble_runtime_tick(void)
 {
+    return GRLC_APP_WAIT_FOREVER;
 }
 
 #endif
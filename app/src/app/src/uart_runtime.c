@@ -2,14 +2,74 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
+#include "app/inc/app_runtime.h"
+#include "app/inc/uart_runtime.h"
 #include "drivers/uart/inc/uart.h"
 #include "proto/inc/transport.h"
 #include "stack/cmd_transport/inc/cmd_transport.h"
+#include "stack/flash_stream/inc/flash_stream.h"
+#include "stack/flash_writer/inc/flash_writer.h"
+#include "stack/telemetry/inc/telemetry.h"
 
 LOG_MODULE_REGISTER(uart_runtime, LOG_LEVEL_INF);
 
+/* Run the UART link in its own thread so other links cannot stall it */
+#ifndef GRLC_UART_RT_THREAD
+#define GRLC_UART_RT_THREAD 1
+#endif
+#ifndef GRLC_UART_RT_PRIO
+#define GRLC_UART_RT_PRIO K_PRIO_PREEMPT(5)
+#endif
+#ifndef GRLC_UART_RT_STACK_SIZE
+#define GRLC_UART_RT_STACK_SIZE 2048
+#endif
+
 static struct transport_ctx s_uart_transport;
 static struct cmd_transport_binding s_uart_cmd;
+static uint32_t s_frames_ok_seen;
+
+/* Request->response latency benchmark (cycle stamps; 0 = no request outstanding) */
+static atomic_t s_rx_stamp;
+static uint32_t s_lat_min_us = UINT32_MAX;
+static uint32_t s_lat_max_us;
+static uint64_t s_lat_sum_us;
+static uint32_t s_lat_count;
+static struct k_spinlock s_lat_lock;
+
+#if GRLC_UART_RT_THREAD
+static K_EVENT_DEFINE(s_uart_events);
+#endif
+
+/**
+ * @brief UART driver hook (ISR context): stamp first RX byte and wake the app.
+ */
+static void uart_notify(uint32_t events)
+{
+    if ((events & UART_NOTIFY_RX) != 0U) {
+        (void)atomic_cas(&s_rx_stamp, 0, (atomic_val_t)(k_cycle_get_32() | 1U));
+    }
+#if GRLC_UART_RT_THREAD
+    k_event_post(&s_uart_events, GRLC_APP_EVT_UART);
+#else
+    grlc_app_notify(GRLC_APP_EVT_UART);
+#endif
+}
+
+/** @brief Close the latency measurement for the request being answered. */
+static void latency_mark_response(void)
+{
+    uint32_t start = (uint32_t)atomic_set(&s_rx_stamp, 0);
+    if (start == 0U) {
+        return;
+    }
+    uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+    k_spinlock_key_t key = k_spin_lock(&s_lat_lock);
+    s_lat_min_us = MIN(s_lat_min_us, us);
+    s_lat_max_us = MAX(s_lat_max_us, us);
+    s_lat_sum_us += us;
+    s_lat_count++;
+    k_spin_unlock(&s_lat_lock, key);
+}
 
 /**
  * @brief Transport lower-layer write over UART DMA.
@@ -45,8 +105,9 @@ static size_t lower_write(const uint8_t *data, size_t len)
     }
     /* Nudge DMA */
     grlc_uart_process();
+    latency_mark_response();
 #ifdef __ZEPHYR__
-    LOG_INF("lw: wrote %u", (unsigned)to_write);
+    LOG_DBG("lw: wrote %u", (unsigned)to_write);
 #endif
     return to_write;
 }
@@ -55,6 +116,84 @@ static const struct transport_lower_if lower_if = {
     .write = lower_write,
 };
 
+/**
+ * @brief Drive a pending SET_LINK switch.
+ *
+ * A valid frame received since the link service last ran confirms the new
+ * settings. Switching is held off while the transport still has frames to
+ * emit; frames seen meanwhile are kept for the next pass so a confirmation
+ * arriving during a response is not lost.
+ */
+static void link_service(void)
+{
+    if (s_uart_transport.tx_in_progress) {
+        return;
+    }
+    struct transport_stats ts;
+    grlc_transport_get_stats(&s_uart_transport, &ts);
+    bool frame_ok = (ts.frames_ok != s_frames_ok_seen);
+    s_frames_ok_seen = ts.frames_ok;
+    (void)grlc_uart_link_service(k_uptime_get_32(), frame_ok);
+}
+
+/** @brief RX ring consumer: parse a span in place. */
+static size_t rx_to_transport(const uint8_t *data, size_t len, void *user)
+{
+    grlc_transport_rx_bytes((struct transport_ctx *)user, data, len);
+    return len;
+}
+
+/**
+ * @brief Service the UART link once: link switch, TX pump, RX drain, pending responses.
+ * @return Milliseconds until the next timed service, or GRLC_APP_WAIT_FOREVER.
+ */
+static uint32_t uart_service(void)
+{
+    link_service();
+    /* First, try to advance any pending TX frames */
+    grlc_transport_tx_pump(&s_uart_transport);
+    grlc_uart_process();
+
+    /* Feed the parser straight from the RX ring: one lock, no staging copy */
+    (void)grlc_uart_rx_consume(rx_to_transport, &s_uart_transport);
+    /* After RX handling, pump any pending TX */
+    grlc_transport_tx_pump(&s_uart_transport);
+    /* Service pending command response if transport was previously busy */
+    grlc_cmd_transport_tick(&s_uart_cmd);
+    /* Subscribed telemetry goes out from this thread, which owns the transport */
+    uint32_t wait = grlc_telemetry_service(&s_uart_cmd, k_uptime_get_32());
+    /* Erase-ahead for FLASH_WRITE, now that the response is queued */
+    (void)grlc_flash_writer_service();
+    uint32_t stream = grlc_flash_stream_service(&s_uart_cmd);
+    if (stream < wait) {
+        wait = stream;
+    }
+
+    /* TX progress is event-driven (UART_NOTIFY_TX); only a link switch needs a timer */
+    enum uart_link_state ls;
+    grlc_uart_link_get(NULL, &ls);
+    if (ls != UART_LINK_STATE_IDLE && wait > 5U) {
+        wait = 5U;
+    }
+    return (wait == GRLC_TELEMETRY_IDLE) ? GRLC_APP_WAIT_FOREVER : wait;
+}
+
+#if GRLC_UART_RT_THREAD
+static void uart_rt_thread(void *a, void *b, void *c)
+{
+    ARG_UNUSED(a);
+    ARG_UNUSED(b);
+    ARG_UNUSED(c);
+    while (1) {
+        grlc_app_wait(&s_uart_events, GRLC_APP_EVT_UART, uart_service());
+    }
+}
+
+/* Started from grlc_uart_runtime_init() once the transport is bound */
+K_THREAD_DEFINE(garlic_uart_rt, GRLC_UART_RT_STACK_SIZE, uart_rt_thread, NULL, NULL, NULL,
+                GRLC_UART_RT_PRIO, 0, SYS_FOREVER_MS);
+#endif
+
 void grlc_uart_runtime_init(void)
 {
     int init_stat = grlc_uart_init();
@@ -66,37 +205,41 @@ void grlc_uart_runtime_init(void)
 
     /* Clear any boot noise or stale bytes before starting transport. */
     grlc_uart_clear_rx_buffer();
+    grlc_uart_set_notify(uart_notify);
 
     grlc_cmd_transport_bind(&s_uart_cmd, &s_uart_transport);
     grlc_transport_init(&s_uart_transport, &lower_if, grlc_cmd_get_transport_cb(), &s_uart_cmd);
     grlc_cmd_transport_init();
+#if GRLC_UART_RT_THREAD
+    k_thread_start(garlic_uart_rt);
+#endif
     LOG_INF("UART transport ready");
 }
 
-void grlc_uart_runtime_tick(void)
+uint32_t grlc_uart_runtime_tick(void)
 {
-    /* First, try to advance any pending TX frames */
-    grlc_transport_tx_pump(&s_uart_transport);
-    grlc_uart_process();
-    size_t avail = grlc_uart_rx_available();
-    if (avail == 0) {
-        /* also advance transport TX when idle on RX */
-        grlc_transport_tx_pump(&s_uart_transport);
-        grlc_cmd_transport_tick(&s_uart_cmd);
-        return;
-    }
+#if GRLC_UART_RT_THREAD
+    return GRLC_APP_WAIT_FOREVER;
+#else
+    return uart_service();
+#endif
+}
+
+void grlc_uart_runtime_report_latency(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&s_lat_lock);
+    uint32_t n = s_lat_count;
+    uint32_t min_us = s_lat_min_us;
+    uint32_t max_us = s_lat_max_us;
+    uint64_t sum_us = s_lat_sum_us;
+    s_lat_min_us = UINT32_MAX;
+    s_lat_max_us = 0;
+    s_lat_sum_us = 0;
+    s_lat_count = 0;
+    k_spin_unlock(&s_lat_lock, key);
 
-    uint8_t buf[256];
-    while ((avail = grlc_uart_rx_available()) > 0) {
-        size_t to_read = avail < sizeof(buf) ? avail : sizeof(buf);
-        size_t n = grlc_uart_read(buf, to_read);
-        if (n == 0) {
-            break;
-        }
-        grlc_transport_rx_bytes(&s_uart_transport, buf, n);
+    if (n > 0U) {
+        LOG_INF("req->resp latency: n=%u min=%uus avg=%uus max=%uus", (unsigned)n,
+                (unsigned)min_us, (unsigned)(sum_us / n), (unsigned)max_us);
     }
-    /* After RX handling, pump any pending TX */
-    grlc_transport_tx_pump(&s_uart_transport);
-    /* Service pending command response if transport was previously busy */
-    grlc_cmd_transport_tick(&s_uart_cmd);
 }
@@ -2,8 +2,18 @@
  * @brief Register BLE control command handler.
  *
  * Provides a command under CMD_ID_BLE_CTRL (0x0200) with the following ops:
- *  - op=0x00 GET_STATUS -> response payload: [adv:1][conn:1][last_disc_reason:1]
+ *  - op=0x00 GET_STATUS -> response payload: [adv:1][conn_count:1]
  *  - op=0x01 SET_ADV [en:1] -> response payload: empty (status indicates result)
+ *  - op=0x02 GET_LINK [link:1 opt] -> response payload: [att_mtu:2][tx_chunk:2][tx_len:2]
+ *                                          [rx_len:2][tx_phy:1][rx_phy:1]
+ *  - op=0x03 GET_CONN [link:1 opt] -> response payload: [interval:2][latency:2][timeout:2]
+ *                                          [profile:1][auto:1]
+ *    (link defaults to the first connected central)
+ *  - op=0x04 SET_PROFILE [profile:1] (0 interactive, 1 bulk, 2 idle, 0xFF auto)
+ *                                          -> response payload: empty
+ *  - op=0x05 SET_BROADCAST [en:1][interval_ms:2 opt] -> response payload: empty
+ *  - op=0x06 GET_BROADCAST -> response payload: [en:1][interval_ms:2][seq:2][sensors:1]
+ *    (connectionless TMP119 telemetry in advertising data, see stack/ble_broadcast)
  */
 
 #pragma once
@@ -1,10 +1,18 @@
 #include "commands/inc/command.h"
 #include "commands/inc/ids.h"
 #include "drivers/ble_nus/inc/ble_nus.h"
+#include "stack/ble_broadcast/inc/ble_broadcast.h"
 
 /* Payload definitions:
- * op=0x00: GET_STATUS -> resp: [adv:1][conn:1]
+ * op=0x00: GET_STATUS -> resp: [adv:1][conn:1] (conn = number of connected centrals)
  * op=0x01: SET_ADV [en:1] -> resp: empty
+ * op=0x02: GET_LINK [link:1 optional, default first connected] -> resp: [att_mtu:u16][tx_chunk:u16][tx_len:u16][rx_len:u16]
+ *                            [tx_phy:u8][rx_phy:u8] (all zero when not connected)
+ * op=0x03: GET_CONN [link:1 optional] -> resp: [interval:u16][latency:u16][timeout:u16][profile:u8][auto:u8]
+ *                            (interval/latency/timeout zero when not connected)
+ * op=0x04: SET_PROFILE [profile:1] (0=interactive, 1=bulk, 2=idle, 0xFF=auto) -> resp: empty
+ * op=0x05: SET_BROADCAST [en:1][interval_ms:u16 optional, 100..60000] -> resp: empty
+ * op=0x06: GET_BROADCAST -> resp: [en:1][interval_ms:u16][seq:u16][sensors:1]
  */
 
 static command_status_t ble_ctrl_handler(const uint8_t *req_payload, size_t req_len,
@@ -19,8 +27,8 @@ static command_status_t ble_ctrl_handler(const uint8_t *req_payload, size_t req_
     } else {
         uint8_t op = req_payload[0];
         if (op == 0x00) { /* GET_STATUS */
-            bool adv = false, conn = false;
-            grlc_ble_get_status(&adv, &conn);
+            bool adv = false;
+            grlc_ble_get_status(&adv, NULL);
             if (!resp_buf || !resp_len || *resp_len < 2) {
                 if (resp_len) {
                     *resp_len = 0;
@@ -28,7 +36,7 @@ static command_status_t ble_ctrl_handler(const uint8_t *req_payload, size_t req_
                 st = CMD_STATUS_ERR_INTERNAL;
             } else {
                 resp_buf[0] = adv ? 1u : 0u;
-                resp_buf[1] = conn ? 1u : 0u;
+                resp_buf[1] = grlc_ble_conn_count();
                 *resp_len = 2;
             }
         } else if (op == 0x01) { /* SET_ADV */
@@ -45,6 +53,83 @@ static command_status_t ble_ctrl_handler(const uint8_t *req_payload, size_t req_
                 }
                 st = (rc == 0) ? CMD_STATUS_OK : CMD_STATUS_ERR_INTERNAL;
             }
+        } else if (op == 0x02) { /* GET_LINK */
+            struct ble_link_info li;
+            grlc_ble_get_link_info(req_len >= 2 ? req_payload[1] : GRLC_BLE_LINK_ANY, &li);
+            if (!resp_buf || !resp_len || *resp_len < 10) {
+                if (resp_len) {
+                    *resp_len = 0;
+                }
+                st = CMD_STATUS_ERR_INTERNAL;
+            } else {
+                const uint16_t v[4] = {li.att_mtu, li.tx_chunk, li.tx_data_len, li.rx_data_len};
+                for (size_t i = 0; i < 4; ++i) {
+                    resp_buf[2 * i] = (uint8_t)(v[i] & 0xFFu);
+                    resp_buf[2 * i + 1] = (uint8_t)(v[i] >> 8);
+                }
+                resp_buf[8] = li.tx_phy;
+                resp_buf[9] = li.rx_phy;
+                *resp_len = 10;
+            }
+        } else if (op == 0x03) { /* GET_CONN */
+            struct ble_conn_info ci;
+            grlc_ble_get_conn_info(req_len >= 2 ? req_payload[1] : GRLC_BLE_LINK_ANY, &ci);
+            if (!resp_buf || !resp_len || *resp_len < 8) {
+                if (resp_len) {
+                    *resp_len = 0;
+                }
+                st = CMD_STATUS_ERR_INTERNAL;
+            } else {
+                const uint16_t v[3] = {ci.interval, ci.latency, ci.timeout};
+                for (size_t i = 0; i < 3; ++i) {
+                    resp_buf[2 * i] = (uint8_t)(v[i] & 0xFFu);
+                    resp_buf[2 * i + 1] = (uint8_t)(v[i] >> 8);
+                }
+                resp_buf[6] = ci.profile;
+                resp_buf[7] = ci.auto_sel;
+                *resp_len = 8;
+            }
+        } else if (op == 0x04) { /* SET_PROFILE */
+            if (resp_len) {
+                *resp_len = 0;
+            }
+            if (req_len < 2) {
+                st = CMD_STATUS_ERR_INVALID;
+            } else {
+                int rc = grlc_ble_set_conn_profile(req_payload[1]);
+                st = (rc == 0) ? CMD_STATUS_OK : CMD_STATUS_ERR_INVALID;
+            }
+        } else if (op == 0x05) { /* SET_BROADCAST */
+            if (resp_len) {
+                *resp_len = 0;
+            }
+            if (req_len != 2 && req_len != 4) {
+                st = CMD_STATUS_ERR_INVALID;
+            } else {
+                uint16_t interval = 0;
+                if (req_len == 4) {
+                    interval = (uint16_t)(req_payload[2] | ((uint16_t)req_payload[3] << 8));
+                }
+                int rc = grlc_ble_bcast_set(req_payload[1] != 0, interval);
+                st = (rc == 0) ? CMD_STATUS_OK : CMD_STATUS_ERR_INVALID;
+            }
+        } else if (op == 0x06) { /* GET_BROADCAST */
+            struct ble_bcast_status bs;
+            grlc_ble_bcast_get(&bs);
+            if (!resp_buf || !resp_len || *resp_len < 6) {
+                if (resp_len) {
+                    *resp_len = 0;
+                }
+                st = CMD_STATUS_ERR_INTERNAL;
+            } else {
+                resp_buf[0] = bs.enabled ? 1u : 0u;
+                resp_buf[1] = (uint8_t)(bs.interval_ms & 0xFFu);
+                resp_buf[2] = (uint8_t)(bs.interval_ms >> 8);
+                resp_buf[3] = (uint8_t)(bs.seq & 0xFFu);
+                resp_buf[4] = (uint8_t)(bs.seq >> 8);
+                resp_buf[5] = bs.sensors;
+                *resp_len = 6;
+            }
         } else {
             if (resp_len) {
                 *resp_len = 0;
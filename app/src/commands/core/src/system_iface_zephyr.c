@@ -1,6 +1,12 @@
+#include <errno.h>
 #include <zephyr/device.h>
+#include <zephyr/devicetree.h>
 #include <zephyr/drivers/flash.h>
 #include <zephyr/kernel.h>
+#include <zephyr/linker/linker-defs.h>
+#if defined(CONFIG_MCUBOOT_IMG_MANAGER)
+#include <zephyr/dfu/mcuboot.h>
+#endif
 #include "commands/inc/system_iface.h"
 
 uint64_t grlc_sys_uptime_ms(void)
@@ -27,3 +33,111 @@ size_t grlc_sys_flash_read(uint32_t addr, uint8_t *dst, size_t len)
     return 0;
 #endif
 }
+
+#if defined(CONFIG_FLASH)
+static const struct device *flash_dev(void)
+{
+    const struct device *flash = DEVICE_DT_GET(DT_CHOSEN(zephyr_flash_controller));
+    return device_is_ready(flash) ? flash : NULL;
+}
+#endif
+
+size_t grlc_sys_flash_page_size(void)
+{
+#if defined(CONFIG_FLASH) && defined(CONFIG_FLASH_PAGE_LAYOUT)
+    const struct device *flash = flash_dev();
+    struct flash_pages_info info;
+    if (flash && flash_get_page_info_by_offs(flash, 0, &info) == 0) {
+        return info.size;
+    }
+#endif
+    return 0;
+}
+
+static bool overlaps(uint64_t a, uint64_t a_end, uint64_t b, uint64_t b_end)
+{
+    return a < b_end && b < a_end;
+}
+
+bool grlc_sys_flash_writable(uint32_t addr, size_t len)
+{
+    uint64_t end = (uint64_t)addr + len;
+    if (len == 0 || end > DT_REG_SIZE(DT_CHOSEN(zephyr_flash))) {
+        return false;
+    }
+    /* The running image as linked, and its partition if the board defines one */
+    uint64_t img = (uint64_t)(uintptr_t)__rom_region_start - CONFIG_FLASH_BASE_ADDRESS;
+    if (overlaps(addr, end, img, img + (uint64_t)(uintptr_t)_flash_used)) {
+        return false;
+    }
+#if DT_HAS_CHOSEN(zephyr_code_partition)
+    uint64_t part = DT_REG_ADDR(DT_CHOSEN(zephyr_code_partition));
+    if (overlaps(addr, end, part, part + DT_REG_SIZE(DT_CHOSEN(zephyr_code_partition)))) {
+        return false;
+    }
+#endif
+#if DT_NODE_EXISTS(DT_NODELABEL(boot_partition))
+    uint64_t boot = DT_REG_ADDR(DT_NODELABEL(boot_partition));
+    if (overlaps(addr, end, boot, boot + DT_REG_SIZE(DT_NODELABEL(boot_partition)))) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+int grlc_sys_flash_erase(uint32_t addr, size_t len)
+{
+#if defined(CONFIG_FLASH)
+    const struct device *flash = flash_dev();
+    return flash ? flash_erase(flash, (off_t)addr, len) : -ENODEV;
+#else
+    (void)addr;
+    (void)len;
+    return -ENOTSUP;
+#endif
+}
+
+int grlc_sys_flash_write(uint32_t addr, const uint8_t *src, size_t len)
+{
+#if defined(CONFIG_FLASH)
+    const struct device *flash = flash_dev();
+    return flash ? flash_write(flash, (off_t)addr, src, len) : -ENODEV;
+#else
+    (void)addr;
+    (void)src;
+    (void)len;
+    return -ENOTSUP;
+#endif
+}
+
+bool grlc_sys_dfu_slot(uint32_t *addr, uint32_t *size)
+{
+#if DT_NODE_EXISTS(DT_NODELABEL(slot1_partition))
+    *addr = DT_REG_ADDR(DT_NODELABEL(slot1_partition));
+    *size = DT_REG_SIZE(DT_NODELABEL(slot1_partition));
+    return true;
+#else
+    (void)addr;
+    (void)size;
+    return false;
+#endif
+}
+
+int grlc_sys_dfu_request_upgrade(bool permanent)
+{
+#if defined(CONFIG_MCUBOOT_IMG_MANAGER)
+    return boot_request_upgrade(permanent ? BOOT_UPGRADE_PERMANENT : BOOT_UPGRADE_TEST);
+#else
+    (void)permanent;
+    return -ENOTSUP;
+#endif
+}
+
+int grlc_sys_dfu_confirm(void)
+{
+#if defined(CONFIG_MCUBOOT_IMG_MANAGER)
+    return boot_is_img_confirmed() ? 0 : boot_write_img_confirmed();
+#else
+    return -ENOTSUP;
+#endif
+}
@@ -0,0 +1,129 @@
+#include <string.h>
+
+#include "commands/inc/command.h"
+#include "commands/inc/ids.h"
+#include "commands/inc/system_iface.h"
+#include "stack/dfu/inc/dfu.h"
+
+#ifndef CMD_DFU_ENABLE
+#define CMD_DFU_ENABLE 1
+#endif
+
+/*
+ * DFU (CMD_ID_DFU = 0x0010): image update into the secondary slot (see stack/dfu)
+ *   0x01: BEGIN [size:u32]          -> resp: [slot_addr:u32][slot_size:u32]; erases
+ *         the first page. UNSUPPORTED without a slot, BOUNDS if the image is too big.
+ *   0x02: DATA [offset:u32][data]   -> resp: [next_offset:u32]; offset must equal the
+ *         bytes accepted so far (INVALID otherwise; STATUS tells where to resume)
+ *   0x03: FINISH [crc32:u32][sha256:32] -> resp: [crc32:u32][sha256:32] computed on
+ *         the device; INVALID if either differs from the request
+ *   0x04: APPLY [permanent:u8]      -> resp: empty; swap on the next REBOOT. INVALID
+ *         unless the image verified and starts with an MCUboot header, UNSUPPORTED
+ *         if the firmware was built without MCUboot
+ *   0x05: STATUS                    -> resp: [active:u8][verified:u8][pending:u8]
+ *                                            [slot:u32][size:u32][written:u32]
+ *   0x06: ABORT                     -> resp: empty
+ *   0x07: CONFIRM                   -> resp: empty; keep the running image after a
+ *         test swap (MCUboot reverts an unconfirmed image on the next reset)
+ *
+ * Flash errors return INTERNAL.
+ */
+
+static command_status_t dfu_handler(const uint8_t *in, size_t in_len, uint8_t *out,
+                                    size_t *out_len)
+{
+    size_t cap = *out_len;
+    *out_len = 0;
+#if CMD_DFU_ENABLE
+    if (!in || in_len < 1) {
+        return CMD_STATUS_ERR_INVALID;
+    }
+    if (cap < 4 + GRLC_SHA256_DIGEST_LEN) {
+        return CMD_STATUS_ERR_BOUNDS;
+    }
+    command_status_t st = CMD_STATUS_OK;
+    switch (in[0]) {
+        case 0x01: { /* BEGIN */
+            if (in_len < 5) {
+                st = CMD_STATUS_ERR_INVALID;
+                break;
+            }
+            uint32_t slot = 0, size = 0;
+            st = grlc_cmd_errno_status(grlc_dfu_begin(grlc_cmd_get_u32(&in[1]), &slot, &size));
+            if (st == CMD_STATUS_OK) {
+                grlc_cmd_put_u32(&out[0], slot);
+                grlc_cmd_put_u32(&out[4], size);
+                *out_len = 8;
+            }
+            break;
+        }
+        case 0x02: { /* DATA */
+            if (in_len < 5) {
+                st = CMD_STATUS_ERR_INVALID;
+                break;
+            }
+            int rc = grlc_dfu_write(grlc_cmd_get_u32(&in[1]), &in[5], in_len - 5);
+            st = grlc_cmd_errno_status(rc);
+            if (st == CMD_STATUS_OK) {
+                struct dfu_status ds;
+                grlc_dfu_get(&ds);
+                grlc_cmd_put_u32(out, ds.written);
+                *out_len = 4;
+            }
+            break;
+        }
+        case 0x03: { /* FINISH */
+            if (in_len < 5 + GRLC_SHA256_DIGEST_LEN) {
+                st = CMD_STATUS_ERR_INVALID;
+                break;
+            }
+            uint32_t crc = 0;
+            uint8_t sha[GRLC_SHA256_DIGEST_LEN];
+            int rc = grlc_dfu_finish(grlc_cmd_get_u32(&in[1]), &in[5], &crc, sha);
+            st = grlc_cmd_errno_status(rc);
+            if (rc == 0) {
+                grlc_cmd_put_u32(&out[0], crc);
+                memcpy(&out[4], sha, sizeof(sha));
+                *out_len = 4 + sizeof(sha);
+            }
+            break;
+        }
+        case 0x04: /* APPLY */
+            st = grlc_cmd_errno_status(grlc_dfu_apply(in_len >= 2 && in[1] != 0));
+            break;
+        case 0x05: { /* STATUS */
+            struct dfu_status ds;
+            grlc_dfu_get(&ds);
+            out[0] = ds.active ? 1u : 0u;
+            out[1] = ds.verified ? 1u : 0u;
+            out[2] = ds.pending ? 1u : 0u;
+            grlc_cmd_put_u32(&out[3], ds.slot);
+            grlc_cmd_put_u32(&out[7], ds.size);
+            grlc_cmd_put_u32(&out[11], ds.written);
+            *out_len = 15;
+            break;
+        }
+        case 0x06: /* ABORT */
+            grlc_dfu_abort();
+            break;
+        case 0x07: /* CONFIRM */
+            st = grlc_cmd_errno_status(grlc_sys_dfu_confirm());
+            break;
+        default:
+            st = CMD_STATUS_ERR_INVALID;
+            break;
+    }
+    return st;
+#else
+    (void)in;
+    (void)in_len;
+    (void)out;
+    (void)cap;
+    return CMD_STATUS_ERR_UNSUPPORTED;
+#endif
+}
+
+void grlc_cmd_register_dfu(void)
+{
+    (void)grlc_cmd_register(CMD_ID_DFU, dfu_handler);
+}
@@ -1,12 +1,20 @@
+#include <errno.h>
 #include <string.h>
 #include "commands/inc/command.h"
 #include "commands/inc/ids.h"
 #include "commands/inc/system_iface.h"
+#include "proto/inc/crc32.h"
+#include "stack/flash_stream/inc/flash_stream.h"
 
 #ifndef CMD_FLASH_READ_ENABLE
 #define CMD_FLASH_READ_ENABLE 1
 #endif
 
+#ifndef CMD_FLASH_CRC_BLOCK
+/** Bytes read from flash per CRC step */
+#define CMD_FLASH_CRC_BLOCK 1024u
+#endif
+
 static command_status_t flash_read_handler(const uint8_t *in, size_t in_len, uint8_t *out,
                                            size_t *out_len)
 {
@@ -42,7 +50,117 @@ static command_status_t flash_read_handler(const uint8_t *in, size_t in_len, uin
 #endif
 }
 
+/*
+ * FLASH_READ_STREAM (CMD_ID_FLASH_READ_STREAM = 0x0007)
+ *   req:  [addr:u32][len:u32][chunk:u16, optional, 0 = GRLC_FLASH_STREAM_CHUNK_MAX]
+ *   resp: [len:u32][chunk:u16], then the chunks follow on GRLC_FLASH_STREAM_SESSION
+ *         (see flash_stream.h). A new request replaces the link's running stream;
+ *         len = 0 only cancels it and reports the bytes left unsent.
+ */
+static command_status_t flash_read_stream_handler(void *ctx, const uint8_t *in, size_t in_len,
+                                                  uint8_t *out, size_t *out_len)
+{
+    struct cmd_transport_binding *b = (struct cmd_transport_binding *)ctx;
+    size_t cap = *out_len;
+    *out_len = 0;
+#if CMD_FLASH_READ_ENABLE
+    if (!b) {
+        /* Not dispatched from a link: nowhere to send the chunks */
+        return CMD_STATUS_ERR_UNSUPPORTED;
+    }
+    if (!in || in_len < 8) {
+        return CMD_STATUS_ERR_INVALID;
+    }
+    if (cap < 6) {
+        return CMD_STATUS_ERR_BOUNDS;
+    }
+    uint32_t addr = (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) |
+                    ((uint32_t)in[3] << 24);
+    uint32_t len = (uint32_t)in[4] | ((uint32_t)in[5] << 8) | ((uint32_t)in[6] << 16) |
+                   ((uint32_t)in[7] << 24);
+    uint16_t chunk = (in_len >= 10) ? (uint16_t)(in[8] | (in[9] << 8)) : 0;
+    if (len == 0) {
+        len = grlc_flash_stream_cancel(b);
+    } else {
+        int rc = grlc_flash_stream_start(b, addr, len, chunk, &chunk);
+        if (rc == -ENOMEM) {
+            return CMD_STATUS_ERR_BUSY;
+        } else if (rc) {
+            return CMD_STATUS_ERR_INVALID;
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        out[i] = (uint8_t)(len >> (8 * i));
+    }
+    out[4] = (uint8_t)(chunk & 0xFF);
+    out[5] = (uint8_t)(chunk >> 8);
+    *out_len = 6;
+    return CMD_STATUS_OK;
+#else
+    (void)b;
+    (void)in;
+    (void)in_len;
+    (void)out;
+    (void)cap;
+    return CMD_STATUS_ERR_UNSUPPORTED;
+#endif
+}
+
+/*
+ * FLASH_CRC (CMD_ID_FLASH_CRC = 0x000A)
+ *   req:  [addr:u32][len:u32], len >= 1
+ *   resp: [crc32:u32], IEEE CRC-32 (as crc32_ieee()) of the region
+ *
+ * The region is read in blocks into the response buffer, which is unused
+ * until the handler returns, so no extra RAM is needed. Read errors (e.g.
+ * past the end of flash) return INTERNAL.
+ */
+static command_status_t flash_crc_handler(const uint8_t *in, size_t in_len, uint8_t *out,
+                                          size_t *out_len)
+{
+    size_t cap = *out_len;
+    *out_len = 0;
+#if CMD_FLASH_READ_ENABLE
+    if (!in || in_len < 8) {
+        return CMD_STATUS_ERR_INVALID;
+    }
+    if (cap < 4) {
+        return CMD_STATUS_ERR_BOUNDS;
+    }
+    uint32_t addr = (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) |
+                    ((uint32_t)in[3] << 24);
+    uint32_t len = (uint32_t)in[4] | ((uint32_t)in[5] << 8) | ((uint32_t)in[6] << 16) |
+                   ((uint32_t)in[7] << 24);
+    if (len == 0 || (uint64_t)addr + len > 0x100000000ull) {
+        return CMD_STATUS_ERR_INVALID;
+    }
+    size_t block = (cap < CMD_FLASH_CRC_BLOCK) ? cap : CMD_FLASH_CRC_BLOCK;
+    uint32_t crc = 0;
+    for (uint32_t off = 0; off < len;) {
+        size_t n = (len - off < block) ? (size_t)(len - off) : block;
+        if (grlc_sys_flash_read(addr + off, out, n) != n) {
+            return CMD_STATUS_ERR_INTERNAL;
+        }
+        crc = crc32_ieee_update(crc, out, n);
+        off += (uint32_t)n;
+    }
+    for (int i = 0; i < 4; ++i) {
+        out[i] = (uint8_t)(crc >> (8 * i));
+    }
+    *out_len = 4;
+    return CMD_STATUS_OK;
+#else
+    (void)in;
+    (void)in_len;
+    (void)out;
+    (void)cap;
+    return CMD_STATUS_ERR_UNSUPPORTED;
+#endif
+}
+
 void grlc_cmd_register_flash_read(void)
 {
     (void)grlc_cmd_register(CMD_ID_FLASH_READ, flash_read_handler);
+    (void)grlc_cmd_register_ctx(CMD_ID_FLASH_READ_STREAM, flash_read_stream_handler);
+    (void)grlc_cmd_register(CMD_ID_FLASH_CRC, flash_crc_handler);
 }
@@ -0,0 +1,145 @@
+#include "commands/inc/command.h"
+#include "commands/inc/ids.h"
+#include "commands/inc/system_iface.h"
+#include "stack/flash_writer/inc/flash_writer.h"
+
+#ifndef CMD_FLASH_WRITE_ENABLE
+#define CMD_FLASH_WRITE_ENABLE 1
+#endif
+
+/*
+ * FLASH_ERASE (CMD_ID_FLASH_ERASE = 0x0008)
+ *   req: [addr:u32][len:u32], page-aligned -> resp: empty
+ *
+ * FLASH_WRITE (CMD_ID_FLASH_WRITE = 0x0009), one sequential session at a time
+ * (see stack/flash_writer):
+ *   0x01: BEGIN [addr:u32][len:u32] -> resp: [page_size:u32]; erases the first page
+ *   0x02: DATA [offset:u32][data]   -> resp: [next_offset:u32]; offset must equal
+ *         the bytes accepted so far (INVALID otherwise; STATUS tells where to resume)
+ *   0x03: FINISH                    -> resp: [len:u32][crc32:u32] of the received data
+ *   0x04: VERIFY                    -> resp: [crc32:u32] read back from flash
+ *   0x05: STATUS                    -> resp: [active:u8][addr:u32][len:u32][written:u32]
+ *                                            [crc32:u32]
+ *   0x06: ABORT                     -> resp: empty
+ *
+ * Regions overlapping the running image or the bootloader are refused (INVALID).
+ * Flash errors return INTERNAL.
+ */
+
+static command_status_t flash_erase_handler(const uint8_t *in, size_t in_len, uint8_t *out,
+                                            size_t *out_len)
+{
+    (void)out;
+    *out_len = 0;
+#if CMD_FLASH_WRITE_ENABLE
+    if (!in || in_len < 8) {
+        return CMD_STATUS_ERR_INVALID;
+    }
+    uint32_t addr = grlc_cmd_get_u32(&in[0]);
+    uint32_t len = grlc_cmd_get_u32(&in[4]);
+    size_t page = grlc_sys_flash_page_size();
+    if (page == 0 || len == 0 || addr % page || len % page || !grlc_sys_flash_writable(addr, len)) {
+        return CMD_STATUS_ERR_INVALID;
+    }
+    return (grlc_sys_flash_erase(addr, len) == 0) ? CMD_STATUS_OK : CMD_STATUS_ERR_INTERNAL;
+#else
+    (void)in;
+    (void)in_len;
+    return CMD_STATUS_ERR_UNSUPPORTED;
+#endif
+}
+
+static command_status_t flash_write_handler(const uint8_t *in, size_t in_len, uint8_t *out,
+                                            size_t *out_len)
+{
+    size_t cap = *out_len;
+    *out_len = 0;
+#if CMD_FLASH_WRITE_ENABLE
+    if (!in || in_len < 1) {
+        return CMD_STATUS_ERR_INVALID;
+    }
+    if (cap < 17) {
+        return CMD_STATUS_ERR_BOUNDS;
+    }
+    command_status_t st = CMD_STATUS_OK;
+    switch (in[0]) {
+        case 0x01: { /* BEGIN */
+            if (in_len < 9) {
+                st = CMD_STATUS_ERR_INVALID;
+                break;
+            }
+            int rc = grlc_flash_writer_begin(grlc_cmd_get_u32(&in[1]), grlc_cmd_get_u32(&in[5]));
+            st = grlc_cmd_errno_status(rc);
+            if (st == CMD_STATUS_OK) {
+                grlc_cmd_put_u32(out, (uint32_t)grlc_sys_flash_page_size());
+                *out_len = 4;
+            }
+            break;
+        }
+        case 0x02: { /* DATA */
+            if (in_len < 5) {
+                st = CMD_STATUS_ERR_INVALID;
+                break;
+            }
+            int rc = grlc_flash_writer_write(grlc_cmd_get_u32(&in[1]), &in[5], in_len - 5);
+            st = grlc_cmd_errno_status(rc);
+            if (st == CMD_STATUS_OK) {
+                struct flash_writer_status ws;
+                grlc_flash_writer_get(&ws);
+                grlc_cmd_put_u32(out, ws.written);
+                *out_len = 4;
+            }
+            break;
+        }
+        case 0x03: { /* FINISH */
+            uint32_t len = 0, crc = 0;
+            st = grlc_cmd_errno_status(grlc_flash_writer_finish(&len, &crc));
+            if (st == CMD_STATUS_OK) {
+                grlc_cmd_put_u32(&out[0], len);
+                grlc_cmd_put_u32(&out[4], crc);
+                *out_len = 8;
+            }
+            break;
+        }
+        case 0x04: { /* VERIFY */
+            uint32_t crc = 0;
+            st = grlc_cmd_errno_status(grlc_flash_writer_verify(&crc));
+            if (st == CMD_STATUS_OK) {
+                grlc_cmd_put_u32(out, crc);
+                *out_len = 4;
+            }
+            break;
+        }
+        case 0x05: { /* STATUS */
+            struct flash_writer_status ws;
+            grlc_flash_writer_get(&ws);
+            out[0] = ws.active ? 1u : 0u;
+            grlc_cmd_put_u32(&out[1], ws.addr);
+            grlc_cmd_put_u32(&out[5], ws.len);
+            grlc_cmd_put_u32(&out[9], ws.written);
+            grlc_cmd_put_u32(&out[13], ws.crc);
+            *out_len = 17;
+            break;
+        }
+        case 0x06: /* ABORT */
+            grlc_flash_writer_abort();
+            break;
+        default:
+            st = CMD_STATUS_ERR_INVALID;
+            break;
+    }
+    return st;
+#else
+    (void)in;
+    (void)in_len;
+    (void)out;
+    (void)cap;
+    return CMD_STATUS_ERR_UNSUPPORTED;
+#endif
+}
+
+void grlc_cmd_register_flash_write(void)
+{
+    (void)grlc_cmd_register(CMD_ID_FLASH_ERASE, flash_erase_handler);
+    (void)grlc_cmd_register(CMD_ID_FLASH_WRITE, flash_write_handler);
+}
@@ -1,4 +1,5 @@
 
+#include <errno.h>
 #include <string.h>
 #ifdef __ZEPHYR__
 #include <zephyr/logging/log.h>
@@ -11,6 +12,7 @@ LOG_MODULE_REGISTER(cmd_i2c, CONFIG_LOG_DEFAULT_LEVEL);
 #include "commands/inc/command.h"
 #include "commands/inc/ids.h"
 #include "drivers/i2c/inc/i2c.h"
+#include "drivers/i2c/inc/i2c_scan.h"
 
 /* Request format:
  *  uint8_t  op       (0=write, 1=read, 2=write_read)
@@ -21,8 +23,22 @@ LOG_MODULE_REGISTER(cmd_i2c, CONFIG_LOG_DEFAULT_LEVEL);
  * Response:
  *  - write: empty
  *  - read or write_read: rdata[rlen]
+ * Scan (addr7 ignored):
+ *  - op=0x10 SCAN [first:u8][last:u8][flags:u8] (all optional; defaults 0x03, 0x77, 0)
+ *      -> [count:u8][addr...]; flags bit0 forces a re-probe, bit1 stops at the first ACK
+ *  - op=0x11 SCAN_INFO -> [generation:u32][mode:u8][present bitmap:16]
+ * Bus control (addr7 ignored):
+ *  - op=0x20 SET_SPEED [hz:u32] -> empty (100000, 400000 or 1000000)
+ *  - op=0x21 GET_SPEED          -> [hz:u32]
  */
 
+/* Clear a stuck bus only after a transfer actually failed */
+static void recover_after(int rc)
+{
+    if (rc)
+        (void)grlc_i2c_bus_recover();
+}
+
 static command_status_t handle_i2c(const uint8_t *req, size_t req_len, uint8_t *resp,
                                    size_t *resp_len)
 {
@@ -49,11 +65,10 @@ static command_status_t handle_i2c(const uint8_t *req, size_t req_len, uint8_t *
         I2C_LOG_ERR("i2c init failed: %d", rc);
         return CMD_STATUS_ERR_INTERNAL;
     }
-    /* Optional bus recovery before activity */
-    (void)grlc_i2c_bus_recover();
     int timeout_ms = 100; /* short blocking window backed by async */
     if (op == 0) {
         rc = grlc_i2c_blocking_write(addr7, wdata, wlen, timeout_ms);
+        recover_after(rc);
         if (rc) {
             I2C_LOG_ERR("i2c write addr=0x%02x rc=%d", addr7, rc);
             return CMD_STATUS_ERR_INTERNAL;
@@ -65,6 +80,7 @@ static command_status_t handle_i2c(const uint8_t *req, size_t req_len, uint8_t *
             return CMD_STATUS_ERR_BOUNDS;
         }
         rc = grlc_i2c_blocking_read(addr7, resp, rlen, timeout_ms);
+        recover_after(rc);
         if (rc) {
             I2C_LOG_ERR("i2c read addr=0x%02x len=%u rc=%d", addr7, (unsigned)rlen, rc);
             return CMD_STATUS_ERR_INTERNAL;
@@ -76,6 +92,7 @@ static command_status_t handle_i2c(const uint8_t *req, size_t req_len, uint8_t *
             return CMD_STATUS_ERR_BOUNDS;
         }
         rc = grlc_i2c_blocking_write_read(addr7, wdata, wlen, resp, rlen, timeout_ms);
+        recover_after(rc);
         if (rc) {
             I2C_LOG_ERR("i2c wr rd addr=0x%02x wlen=%u rlen=%u rc=%d", addr7, (unsigned)wlen,
                         (unsigned)rlen, rc);
@@ -83,23 +100,73 @@ static command_status_t handle_i2c(const uint8_t *req, size_t req_len, uint8_t *
         }
         *resp_len = rlen;
         return CMD_STATUS_OK;
-    } else if (op == 0x10) { /* scan */
+    } else if (op == 0x10) { /* scan [first][last][flags] */
         size_t cap = *resp_len;
-        size_t n = 0;
         if (cap == 0) {
             return CMD_STATUS_ERR_BOUNDS;
         }
-        resp[0] = 0;
-        for (uint16_t a = 0x03; a <= 0x77; ++a) {
-            if (grlc_i2c_ping(a) == 0) {
-                if (1 + n < cap) {
-                    resp[1 + n] = (uint8_t)a;
-                    n++;
-                }
-            }
+        uint8_t first = (req_len >= 3) ? req[2] : GRLC_I2C_SCAN_FIRST;
+        uint8_t last = (req_len >= 4) ? req[3] : GRLC_I2C_SCAN_LAST;
+        uint8_t flags = (req_len >= 5) ? req[4] : 0;
+        rc = grlc_i2c_scan(first, last, flags, 500);
+        if (rc == -EINVAL) {
+            return CMD_STATUS_ERR_INVALID;
+        } else if (rc == -EBUSY) {
+            return CMD_STATUS_ERR_BUSY;
+        } else if (rc) {
+            I2C_LOG_ERR("i2c scan 0x%02x..0x%02x rc=%d", first, last, rc);
+            recover_after(rc);
+            return CMD_STATUS_ERR_INTERNAL;
+        }
+        size_t n = grlc_i2c_scan_list(first, last, &resp[1], cap - 1);
+        if (n > cap - 1) {
+            n = cap - 1;
         }
         resp[0] = (uint8_t)n;
-        *resp_len = (n + 1 <= cap) ? (n + 1) : cap;
+        *resp_len = n + 1;
+        return CMD_STATUS_OK;
+    } else if (op == 0x11) { /* scan cache info */
+        if (*resp_len < 21) {
+            return CMD_STATUS_ERR_BOUNDS;
+        }
+        struct i2c_scan_info info;
+        grlc_i2c_scan_info(&info);
+        for (int i = 0; i < 4; ++i) {
+            resp[i] = (uint8_t)(info.generation >> (8 * i));
+        }
+        resp[4] = info.read_probe ? 0x01 : 0x00;
+        memcpy(&resp[5], info.present, sizeof(info.present));
+        *resp_len = 21;
+        return CMD_STATUS_OK;
+    } else if (op == 0x20) { /* set speed */
+        if (req_len < 6) {
+            return CMD_STATUS_ERR_INVALID;
+        }
+        uint32_t hz = (uint32_t)req[2] | ((uint32_t)req[3] << 8) | ((uint32_t)req[4] << 16) |
+                      ((uint32_t)req[5] << 24);
+        rc = grlc_i2c_set_speed(hz);
+        if (rc == -EINVAL) {
+            return CMD_STATUS_ERR_INVALID;
+        } else if (rc == -ENOTSUP) {
+            return CMD_STATUS_ERR_UNSUPPORTED;
+        } else if (rc == -ETIMEDOUT) {
+            return CMD_STATUS_ERR_BUSY;
+        } else if (rc) {
+            I2C_LOG_ERR("i2c set speed %u rc=%d", (unsigned)hz, rc);
+            return CMD_STATUS_ERR_INTERNAL;
+        }
+        *resp_len = 0;
+        return CMD_STATUS_OK;
+    } else if (op == 0x21) { /* get speed */
+        if (*resp_len < 4) {
+            return CMD_STATUS_ERR_BOUNDS;
+        }
+        uint32_t hz = grlc_i2c_get_speed();
+        resp[0] = (uint8_t)(hz & 0xFF);
+        resp[1] = (uint8_t)((hz >> 8) & 0xFF);
+        resp[2] = (uint8_t)((hz >> 16) & 0xFF);
+        resp[3] = (uint8_t)((hz >> 24) & 0xFF);
+        *resp_len = 4;
         return CMD_STATUS_OK;
     }
     return CMD_STATUS_ERR_INVALID;
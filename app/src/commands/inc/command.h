@@ -38,6 +38,17 @@ typedef enum {
 typedef command_status_t (*command_handler_fn)(const uint8_t *req_payload, size_t req_len,
                                                uint8_t *resp_buf, size_t *resp_len);
 
+/**
+ * @brief Handler that also receives the dispatcher's context.
+ *
+ * For commands whose effect is tied to the link they arrived on (e.g.
+ * subscriptions); @p ctx is the requesting cmd_transport_binding, or NULL
+ * when dispatched without one.
+ */
+typedef command_status_t (*command_handler_ctx_fn)(void *ctx, const uint8_t *req_payload,
+                                                   size_t req_len, uint8_t *resp_buf,
+                                                   size_t *resp_len);
+
 /**
  * @brief Initialize the global command registry.
  */
@@ -49,6 +60,11 @@ void grlc_cmd_registry_init(void);
  * @return true on success, false if already registered or invalid.
  */
 bool grlc_cmd_register(uint16_t cmd_id, command_handler_fn handler);
+/**
+ * @brief Register a context-aware handler for a command ID.
+ * @return true on success, false if already registered or invalid.
+ */
+bool grlc_cmd_register_ctx(uint16_t cmd_id, command_handler_ctx_fn handler);
 /**
  * @brief Dispatch a request to a registered handler and produce a response.
  * @param cmd_id Command identifier.
@@ -61,6 +77,11 @@ bool grlc_cmd_register(uint16_t cmd_id, command_handler_fn handler);
  */
 bool grlc_cmd_dispatch(uint16_t cmd_id, const uint8_t *in, size_t in_len, uint8_t *out,
                        size_t *out_len, uint16_t *status_out);
+/**
+ * @brief As grlc_cmd_dispatch(), passing @p ctx to context-aware handlers.
+ */
+bool grlc_cmd_dispatch_ctx(void *ctx, uint16_t cmd_id, const uint8_t *in, size_t in_len,
+                           uint8_t *out, size_t *out_len, uint16_t *status_out);
 
 /**
  * @brief Pack a request message payload for transport.
@@ -112,6 +133,18 @@ bool grlc_cmd_pack_response(uint16_t cmd_id, uint16_t status, const uint8_t *pay
 bool grlc_cmd_parse_response(const uint8_t *in, size_t in_len, uint16_t *cmd_id_out,
                              uint16_t *status_out, const uint8_t **payload, uint16_t *payload_len);
 
+/** @brief Read a little-endian u32 payload field. */
+uint32_t grlc_cmd_get_u32(const uint8_t *p);
+/** @brief Write a little-endian u32 payload field. */
+void grlc_cmd_put_u32(uint8_t *p, uint32_t v);
+/**
+ * @brief Map a stack-layer result to a command status.
+ *
+ * 0 -> OK, -EIO -> INTERNAL, -ENOTSUP -> UNSUPPORTED, -EFBIG -> BOUNDS,
+ * anything else -> INVALID.
+ */
+command_status_t grlc_cmd_errno_status(int rc);
+
 #ifdef __cplusplus
 }
 #endif
@@ -3,12 +3,19 @@
 
 /** @brief Command IDs used in the command layer payloads. */
 enum {
-    CMD_ID_GET_GIT_VERSION = 0x0001, /**< Return build git hash string */
-    CMD_ID_GET_UPTIME = 0x0002,      /**< Return uptime in milliseconds */
-    CMD_ID_FLASH_READ = 0x0003,      /**< Read whitelisted flash region */
-    CMD_ID_REBOOT = 0x0004,          /**< Reboot the device */
-    CMD_ID_ECHO = 0x0005,            /**< Echo request payload */
-    CMD_ID_I2C_TRANSFER = 0x0100,    /**< I2C write/read operations */
-    CMD_ID_TMP119 = 0x0119,          /**< Texas Instruments TMP119 helpers */
-    CMD_ID_BLE_CTRL = 0x0200,        /**< BLE control (advertising, status) */
+    CMD_ID_GET_GIT_VERSION = 0x0001,   /**< Return build git hash string */
+    CMD_ID_GET_UPTIME = 0x0002,        /**< Return uptime in milliseconds */
+    CMD_ID_FLASH_READ = 0x0003,        /**< Read whitelisted flash region */
+    CMD_ID_REBOOT = 0x0004,            /**< Reboot the device */
+    CMD_ID_ECHO = 0x0005,              /**< Echo request payload */
+    CMD_ID_SET_LINK = 0x0006,          /**< UART baud/flow-control negotiation */
+    CMD_ID_FLASH_READ_STREAM = 0x0007, /**< Stream a flash region in chunk messages */
+    CMD_ID_FLASH_ERASE = 0x0008,       /**< Erase whole flash pages */
+    CMD_ID_FLASH_WRITE = 0x0009,       /**< Page-buffered sequential flash programming */
+    CMD_ID_FLASH_CRC = 0x000A,         /**< CRC-32 of a flash region, computed on-device */
+    CMD_ID_DFU = 0x0010,               /**< Firmware update into the secondary slot */
+    CMD_ID_I2C_TRANSFER = 0x0100,      /**< I2C write/read operations */
+    CMD_ID_TMP119 = 0x0119,            /**< Texas Instruments TMP119 helpers */
+    CMD_ID_BLE_CTRL = 0x0200,          /**< BLE control (advertising, status) */
+    CMD_ID_SUBSCRIBE = 0x0300,         /**< Telemetry subscriptions (push notifications) */
 };
@@ -1,4 +1,5 @@
 #pragma once
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -18,6 +19,54 @@ uint64_t grlc_sys_uptime_ms(void);
  */
 size_t grlc_sys_flash_read(uint32_t addr, uint8_t *dst, size_t len);
 
+/** @brief Flash erase page size in bytes (0 if flash is unavailable). */
+size_t grlc_sys_flash_page_size(void);
+
+/**
+ * @brief Whether a region may be erased and written.
+ *
+ * False if it leaves the flash or overlaps the running image or bootloader.
+ */
+bool grlc_sys_flash_writable(uint32_t addr, size_t len);
+
+/**
+ * @brief Erase whole pages.
+ * @param addr Page-aligned absolute address
+ * @param len  Multiple of the page size
+ * @return 0 on success, negative errno on error
+ */
+int grlc_sys_flash_erase(uint32_t addr, size_t len);
+
+/**
+ * @brief Program erased flash.
+ * @param addr Absolute address, aligned to the write block (4 bytes on nRF52)
+ * @param src  Data to program
+ * @param len  Multiple of the write block
+ * @return 0 on success, negative errno on error
+ */
+int grlc_sys_flash_write(uint32_t addr, const uint8_t *src, size_t len);
+
+/**
+ * @brief Locate the secondary image slot (MCUboot slot1_partition).
+ * @param[out] addr Absolute slot address
+ * @param[out] size Slot size in bytes
+ * @return false if the board has no secondary slot
+ */
+bool grlc_sys_dfu_slot(uint32_t *addr, uint32_t *size);
+
+/**
+ * @brief Ask the bootloader to install the secondary slot on the next reboot.
+ * @param permanent false for a test swap (reverted unless confirmed), true for permanent
+ * @return 0 on success, -ENOTSUP without MCUboot, negative errno on error
+ */
+int grlc_sys_dfu_request_upgrade(bool permanent);
+
+/**
+ * @brief Mark the running image as good so a test swap is kept.
+ * @return 0 on success, -ENOTSUP without MCUboot, negative errno on error
+ */
+int grlc_sys_dfu_confirm(void);
+
 #ifdef __cplusplus
 }
 #endif
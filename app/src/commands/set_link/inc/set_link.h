@@ -0,0 +1,29 @@
+/**
+ * @brief Register UART link negotiation command handler.
+ *
+ * Provides a command under CMD_ID_SET_LINK (0x0006) with the following ops:
+ *  - op=0x00 GET -> response payload: [baud:u32][flow:u8][state:u8]
+ *  - op=0x01 SET [baud:u32][flow:u8][confirm_ms:u16] -> response payload: empty
+ *
+ * The response to SET is sent at the current settings; the switch happens once
+ * it has left the wire. The host must then deliver a valid frame at the new
+ * settings within confirm_ms or the device reverts.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Registers the SET_LINK command.
+ */
+void grlc_cmd_register_set_link(void);
+
+#ifdef __cplusplus
+}
+#endif
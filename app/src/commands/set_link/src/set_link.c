@@ -0,0 +1,78 @@
+#include "commands/inc/command.h"
+#include "commands/inc/ids.h"
+#include "drivers/uart/inc/uart.h"
+
+/* Payload definitions (little-endian):
+ * op=0x00: GET -> resp: [baud:u32][flow:u8][state:u8]
+ * op=0x01: SET [baud:u32][flow:u8][confirm_ms:u16] -> resp: empty
+ *          confirm_ms=0 selects UART_LINK_CONFIRM_MS_DEFAULT.
+ */
+
+static command_status_t set_link_handler(const uint8_t *req_payload, size_t req_len,
+                                         uint8_t *resp_buf, size_t *resp_len)
+{
+    command_status_t st = CMD_STATUS_OK;
+    if (!req_payload || req_len < 1) {
+        if (resp_len) {
+            *resp_len = 0;
+        }
+        st = CMD_STATUS_ERR_INVALID;
+    } else {
+        uint8_t op = req_payload[0];
+        if (op == 0x00) { /* GET */
+            struct uart_link_cfg cfg;
+            enum uart_link_state state;
+            grlc_uart_link_get(&cfg, &state);
+            if (!resp_buf || !resp_len || *resp_len < 6) {
+                if (resp_len) {
+                    *resp_len = 0;
+                }
+                st = CMD_STATUS_ERR_INTERNAL;
+            } else {
+                resp_buf[0] = (uint8_t)(cfg.baudrate & 0xFFu);
+                resp_buf[1] = (uint8_t)((cfg.baudrate >> 8) & 0xFFu);
+                resp_buf[2] = (uint8_t)((cfg.baudrate >> 16) & 0xFFu);
+                resp_buf[3] = (uint8_t)((cfg.baudrate >> 24) & 0xFFu);
+                resp_buf[4] = cfg.flow_ctrl ? 1u : 0u;
+                resp_buf[5] = (uint8_t)state;
+                *resp_len = 6;
+            }
+        } else if (op == 0x01) { /* SET */
+            if (resp_len) {
+                *resp_len = 0;
+            }
+            if (req_len < 8) {
+                st = CMD_STATUS_ERR_INVALID;
+            } else {
+                struct uart_link_cfg cfg = {
+                    .baudrate = (uint32_t)req_payload[1] | ((uint32_t)req_payload[2] << 8) |
+                                ((uint32_t)req_payload[3] << 16) | ((uint32_t)req_payload[4] << 24),
+                    .flow_ctrl = (req_payload[5] != 0),
+                };
+                uint32_t confirm_ms =
+                    (uint32_t)req_payload[6] | ((uint32_t)req_payload[7] << 8);
+                if (!grlc_uart_link_baud_supported(cfg.baudrate)) {
+                    st = CMD_STATUS_ERR_INVALID;
+                } else {
+                    enum uart_dma_status rc = grlc_uart_link_request(&cfg, confirm_ms);
+                    if (rc == UART_DMA_STATUS_BUSY) {
+                        st = CMD_STATUS_ERR_BUSY;
+                    } else if (rc != UART_DMA_STATUS_OK) {
+                        st = CMD_STATUS_ERR_INTERNAL;
+                    }
+                }
+            }
+        } else {
+            if (resp_len) {
+                *resp_len = 0;
+            }
+            st = CMD_STATUS_ERR_UNSUPPORTED;
+        }
+    }
+    return st;
+}
+
+void grlc_cmd_register_set_link(void)
+{
+    (void)grlc_cmd_register(CMD_ID_SET_LINK, set_link_handler);
+}
@@ -1,3 +1,4 @@
+#include <errno.h>
 #include <string.h>
 #include "commands/inc/command.h"
 
@@ -8,6 +9,7 @@
 typedef struct {
     uint16_t cmd_id;
     command_handler_fn fn;
+    command_handler_ctx_fn ctx_fn;
 } entry_t;
 
 static entry_t reg_tbl[CMD_REGISTRY_MAX];
@@ -19,10 +21,11 @@ void grlc_cmd_registry_init(void)
     reg_count = 0;
 }
 
-bool grlc_cmd_register(uint16_t cmd_id, command_handler_fn handler)
+static bool register_entry(uint16_t cmd_id, command_handler_fn handler,
+                           command_handler_ctx_fn ctx_handler)
 {
     bool ok = true;
-    if (!handler) {
+    if (!handler && !ctx_handler) {
         ok = false;
     }
     for (size_t i = 0; ok && i < reg_count; ++i) {
@@ -36,18 +39,38 @@ bool grlc_cmd_register(uint16_t cmd_id, command_handler_fn handler)
     if (ok) {
         reg_tbl[reg_count].cmd_id = cmd_id;
         reg_tbl[reg_count].fn = handler;
+        reg_tbl[reg_count].ctx_fn = ctx_handler;
         reg_count++;
     }
     return ok;
 }
 
+bool grlc_cmd_register(uint16_t cmd_id, command_handler_fn handler)
+{
+    return handler ? register_entry(cmd_id, handler, NULL) : false;
+}
+
+bool grlc_cmd_register_ctx(uint16_t cmd_id, command_handler_ctx_fn handler)
+{
+    return handler ? register_entry(cmd_id, NULL, handler) : false;
+}
+
 bool grlc_cmd_dispatch(uint16_t cmd_id, const uint8_t *in, size_t in_len, uint8_t *out,
                        size_t *out_len, uint16_t *status_out)
+{
+    return grlc_cmd_dispatch_ctx(NULL, cmd_id, in, in_len, out, out_len, status_out);
+}
+
+bool grlc_cmd_dispatch_ctx(void *ctx, uint16_t cmd_id, const uint8_t *in, size_t in_len,
+                           uint8_t *out, size_t *out_len, uint16_t *status_out)
 {
     for (size_t i = 0; i < reg_count; ++i) {
         if (reg_tbl[i].cmd_id == cmd_id) {
             size_t cap = out_len ? *out_len : 0;
-            command_status_t st = reg_tbl[i].fn(in, in_len, out, out_len ? out_len : &cap);
+            size_t *len = out_len ? out_len : &cap;
+            command_status_t st = reg_tbl[i].ctx_fn
+                                      ? reg_tbl[i].ctx_fn(ctx, in, in_len, out, len)
+                                      : reg_tbl[i].fn(in, in_len, out, len);
             if (status_out) {
                 *status_out = (uint16_t)st;
             }
@@ -170,3 +193,32 @@ bool grlc_cmd_parse_response(const uint8_t *in, size_t in_len, uint16_t *cmd_id_
     }
     return ok;
 }
+
+uint32_t grlc_cmd_get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+void grlc_cmd_put_u32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+command_status_t grlc_cmd_errno_status(int rc)
+{
+    switch (rc) {
+        case 0:
+            return CMD_STATUS_OK;
+        case -EIO:
+            return CMD_STATUS_ERR_INTERNAL;
+        case -ENOTSUP:
+            return CMD_STATUS_ERR_UNSUPPORTED;
+        case -EFBIG:
+            return CMD_STATUS_ERR_BOUNDS;
+        default:
+            return CMD_STATUS_ERR_INVALID;
+    }
+}
@@ -0,0 +1,105 @@
+#include <errno.h>
+
+#include "commands/inc/command.h"
+#include "commands/inc/ids.h"
+#include "stack/telemetry/inc/telemetry.h"
+
+/*
+ * SUBSCRIBE command protocol (CMD_ID_SUBSCRIBE = 0x0300)
+ *
+ * Subscriptions belong to the link the request arrived on and are dropped
+ * when that link is reset. Notifications are described in telemetry.h.
+ *
+ * Ops:
+ *   0x01: ADD [topic:1][period_ms:u16][threshold:u16] -> resp: [id:1]
+ *   0x02: REMOVE [id:1] (0 = all on this link)        -> resp: empty
+ *   0x03: LIST -> resp: [n:1] n * [id:1][topic:1][period_ms:u16][threshold:u16]
+ *                             [seq:u16][delayed:u32]
+ */
+
+#define SUB_LIST_ENTRY_LEN 12u
+
+static command_status_t subscribe_handler(void *ctx, const uint8_t *req, size_t req_len,
+                                          uint8_t *resp, size_t *resp_len)
+{
+    struct cmd_transport_binding *b = (struct cmd_transport_binding *)ctx;
+    command_status_t st = CMD_STATUS_OK;
+    size_t cap = *resp_len;
+    *resp_len = 0;
+    if (!b) {
+        /* Not dispatched from a link: nowhere to send notifications */
+        return CMD_STATUS_ERR_UNSUPPORTED;
+    }
+    if (!req || req_len < 1) {
+        return CMD_STATUS_ERR_INVALID;
+    }
+    switch (req[0]) {
+        case 0x01: { /* ADD */
+            if (req_len < 6) {
+                st = CMD_STATUS_ERR_INVALID;
+                break;
+            }
+            if (cap < 1) {
+                st = CMD_STATUS_ERR_BOUNDS;
+                break;
+            }
+            uint16_t period = (uint16_t)(req[2] | (req[3] << 8));
+            uint16_t threshold = (uint16_t)(req[4] | (req[5] << 8));
+            uint8_t id = 0;
+            int rc = grlc_telemetry_subscribe(b, req[1], period, threshold, &id);
+            if (rc == -ENOMEM) {
+                st = CMD_STATUS_ERR_BUSY;
+            } else if (rc) {
+                st = CMD_STATUS_ERR_INVALID;
+            } else {
+                resp[0] = id;
+                *resp_len = 1;
+            }
+            break;
+        }
+        case 0x02: { /* REMOVE */
+            if (req_len < 2) {
+                st = CMD_STATUS_ERR_INVALID;
+                break;
+            }
+            if (grlc_telemetry_unsubscribe(b, req[1])) {
+                st = CMD_STATUS_ERR_INVALID;
+            }
+            break;
+        }
+        case 0x03: { /* LIST */
+            struct telemetry_sub_info subs[GRLC_TELEMETRY_MAX_SUBS];
+            size_t n = grlc_telemetry_list(b, subs, GRLC_TELEMETRY_MAX_SUBS);
+            if (cap < 1 + n * SUB_LIST_ENTRY_LEN) {
+                st = CMD_STATUS_ERR_BOUNDS;
+                break;
+            }
+            resp[0] = (uint8_t)n;
+            for (size_t i = 0; i < n; ++i) {
+                uint8_t *p = &resp[1 + i * SUB_LIST_ENTRY_LEN];
+                p[0] = subs[i].id;
+                p[1] = subs[i].topic;
+                p[2] = (uint8_t)(subs[i].period_ms & 0xFF);
+                p[3] = (uint8_t)(subs[i].period_ms >> 8);
+                p[4] = (uint8_t)(subs[i].threshold & 0xFF);
+                p[5] = (uint8_t)(subs[i].threshold >> 8);
+                p[6] = (uint8_t)(subs[i].seq & 0xFF);
+                p[7] = (uint8_t)(subs[i].seq >> 8);
+                for (int k = 0; k < 4; ++k) {
+                    p[8 + k] = (uint8_t)(subs[i].delayed >> (8 * k));
+                }
+            }
+            *resp_len = 1 + n * SUB_LIST_ENTRY_LEN;
+            break;
+        }
+        default:
+            st = CMD_STATUS_ERR_UNSUPPORTED;
+            break;
+    }
+    return st;
+}
+
+void grlc_cmd_register_subscribe(void)
+{
+    (void)grlc_cmd_register_ctx(CMD_ID_SUBSCRIBE, subscribe_handler);
+}
@@ -1,8 +1,11 @@
+#include <errno.h>
 #include <string.h>
 
 #include "commands/inc/command.h"
 #include "commands/inc/ids.h"
+#include "commands/inc/system_iface.h"
 #include "drivers/tmp119/inc/tmp119.h"
+#include "stack/tmp119_sampler/inc/tmp119_sampler.h"
 
 /*
  * TMP119 command protocol (CMD_ID_TMP119 = 0x0119)
@@ -27,6 +30,24 @@
  *   0x0B: WRITE_EEPROM(idx,u16)-> resp: empty
  *   0x0C: READ_OFFSET          -> resp: u16
  *   0x0D: WRITE_OFFSET(u16)    -> resp: empty
+ *   0x0E: REFRESH              -> resp: empty (re-read the register shadow)
+ *
+ * Background sampler (addr7 ignored):
+ *   0x10: SAMPLER_SET(u16 period_ms, 0=stop) -> resp: empty
+ *   0x11: HISTORY([u16 max][u32 since_seq])  -> resp: u32 next_seq, u32 first_seq,
+ *         u16 period_ms, u16 n, n * [u32 t_ms][u8 addr7][s16 raw]
+ *   0x12: DATA_READY(u8 enable) -> resp: empty; addr7's ALERT pin drives sampling
+ *   0x14: AGGREGATE_SET([u16 block][u8 ma_len][u8 ema_shift], block 0=off) -> resp: empty
+ *   0x15: WINDOWS([u16 max][u32 since_seq]) -> resp: u32 next_seq, u32 first_seq,
+ *         u16 block, u16 n, n * [u32 t_ms][u8 addr7][u16 count][s16 min][s16 max]
+ *         [s16 mean][s16 ma][s16 ema]
+ *   0x16: HISTORY_PACKED([u16 max][u32 since_seq]) -> resp: u32 next_seq, u32 first_seq,
+ *         u16 period_ms, u16 n, u16 t_len, u16 a_len, t stream, addr stream, raw stream
+ *         (raw stream runs to the end; see tmp119_sampler.h for the column coding)
+ *
+ * Multi-sensor (addr7 ignored):
+ *   0x13: ONESHOT_ALL -> resp: u32 t_ms, u8 n, n * [u8 addr7][s16 raw]; one synchronized
+ *         one-shot conversion on every verified sensor, read back in one I2C chain
  */
 
 static command_status_t handle_tmp119(const uint8_t *req, size_t req_len, uint8_t *resp,
@@ -236,6 +257,182 @@ static command_status_t handle_tmp119(const uint8_t *req, size_t req_len, uint8_
                 *resp_len = 0;
                 break;
             }
+            case 0x0E: { /* REFRESH */
+                if (grlc_tmp119_refresh(addr7)) {
+                    st = CMD_STATUS_ERR_INTERNAL;
+                    break;
+                }
+                *resp_len = 0;
+                break;
+            }
+            case 0x10: { /* SAMPLER_SET(u16 period_ms) */
+                if (req_len < 4) {
+                    st = CMD_STATUS_ERR_INVALID;
+                    break;
+                }
+                uint16_t period = (uint16_t)req[2] | ((uint16_t)req[3] << 8);
+                if (grlc_tmp119_sampler_set(period)) {
+                    st = CMD_STATUS_ERR_INVALID;
+                    break;
+                }
+                *resp_len = 0;
+                break;
+            }
+            case 0x11: { /* HISTORY([u16 max][u32 since_seq]) */
+                if (*resp_len < 12) {
+                    st = CMD_STATUS_ERR_BOUNDS;
+                    break;
+                }
+                size_t max = GRLC_TMP119_SAMPLER_DEPTH;
+                uint32_t since = 0;
+                if (req_len >= 4) {
+                    max = (size_t)req[2] | ((size_t)req[3] << 8);
+                }
+                if (req_len >= 8) {
+                    since = (uint32_t)req[4] | ((uint32_t)req[5] << 8) |
+                            ((uint32_t)req[6] << 16) | ((uint32_t)req[7] << 24);
+                }
+                uint32_t first = 0;
+                size_t n = grlc_tmp119_sampler_encode(since, max, &resp[12], *resp_len - 12,
+                                                      &first);
+                struct tmp119_sampler_status ss;
+                grlc_tmp119_sampler_get(&ss);
+                /* Report the end of the encoded run so the host can resume from it */
+                uint32_t next = first + (uint32_t)n;
+                for (int i = 0; i < 4; ++i) {
+                    resp[i] = (uint8_t)(next >> (8 * i));
+                    resp[4 + i] = (uint8_t)(first >> (8 * i));
+                }
+                resp[8] = (uint8_t)(ss.period_ms & 0xFF);
+                resp[9] = (uint8_t)(ss.period_ms >> 8);
+                resp[10] = (uint8_t)(n & 0xFF);
+                resp[11] = (uint8_t)(n >> 8);
+                *resp_len = 12 + n * GRLC_TMP119_SAMPLE_WIRE_LEN;
+                break;
+            }
+            case 0x12: { /* DATA_READY(u8 enable) */
+                if (req_len < 3) {
+                    st = CMD_STATUS_ERR_INVALID;
+                    break;
+                }
+                int rc = grlc_tmp119_sampler_set_drdy(addr7, req[2] != 0);
+                if (rc == -ENOTSUP) {
+                    st = CMD_STATUS_ERR_UNSUPPORTED;
+                    break;
+                } else if (rc == -ENODEV) {
+                    st = CMD_STATUS_ERR_INVALID;
+                    break;
+                } else if (rc) {
+                    st = CMD_STATUS_ERR_INTERNAL;
+                    break;
+                }
+                *resp_len = 0;
+                break;
+            }
+            case 0x13: { /* ONESHOT_ALL */
+                if (*resp_len < 5 + 3 * TMP119_MAX_DEVICES) {
+                    st = CMD_STATUS_ERR_BOUNDS;
+                    break;
+                }
+                struct tmp119_reading r[TMP119_MAX_DEVICES];
+                int n = grlc_tmp119_oneshot_all(r, TMP119_MAX_DEVICES, NULL);
+                if (n == -ENODEV) {
+                    st = CMD_STATUS_ERR_INVALID;
+                    break;
+                } else if (n < 0) {
+                    st = CMD_STATUS_ERR_INTERNAL;
+                    break;
+                }
+                uint32_t t_ms = (uint32_t)grlc_sys_uptime_ms();
+                for (int b = 0; b < 4; ++b) {
+                    resp[b] = (uint8_t)(t_ms >> (8 * b));
+                }
+                resp[4] = (uint8_t)n;
+                for (int i = 0; i < n; ++i) {
+                    uint8_t *p = &resp[5 + 3 * i];
+                    p[0] = r[i].addr7;
+                    p[1] = (uint8_t)((uint16_t)r[i].raw & 0xFF);
+                    p[2] = (uint8_t)((uint16_t)r[i].raw >> 8);
+                }
+                *resp_len = 5 + 3 * (size_t)n;
+                break;
+            }
+            case 0x14: { /* AGGREGATE_SET([u16 block][u8 ma_len][u8 ema_shift]) */
+                if (req_len < 6) {
+                    st = CMD_STATUS_ERR_INVALID;
+                    break;
+                }
+                uint16_t block = (uint16_t)(req[2] | (req[3] << 8));
+                if (grlc_tmp119_sampler_set_aggregate(block, req[4], req[5])) {
+                    st = CMD_STATUS_ERR_INVALID;
+                    break;
+                }
+                *resp_len = 0;
+                break;
+            }
+            case 0x15: { /* WINDOWS([u16 max][u32 since_seq]) */
+                if (*resp_len < 12) {
+                    st = CMD_STATUS_ERR_BOUNDS;
+                    break;
+                }
+                size_t max = GRLC_TMP119_WINDOW_DEPTH;
+                uint32_t since = 0;
+                if (req_len >= 4) {
+                    max = (size_t)req[2] | ((size_t)req[3] << 8);
+                }
+                if (req_len >= 8) {
+                    since = (uint32_t)req[4] | ((uint32_t)req[5] << 8) |
+                            ((uint32_t)req[6] << 16) | ((uint32_t)req[7] << 24);
+                }
+                uint32_t first = 0;
+                size_t n = grlc_tmp119_sampler_encode_windows(since, max, &resp[12],
+                                                              *resp_len - 12, &first);
+                struct tmp119_sampler_status ss;
+                grlc_tmp119_sampler_get(&ss);
+                uint32_t next = first + (uint32_t)n;
+                for (int i = 0; i < 4; ++i) {
+                    resp[i] = (uint8_t)(next >> (8 * i));
+                    resp[4 + i] = (uint8_t)(first >> (8 * i));
+                }
+                resp[8] = (uint8_t)(ss.agg_block & 0xFF);
+                resp[9] = (uint8_t)(ss.agg_block >> 8);
+                resp[10] = (uint8_t)(n & 0xFF);
+                resp[11] = (uint8_t)(n >> 8);
+                *resp_len = 12 + n * GRLC_TMP119_WINDOW_WIRE_LEN;
+                break;
+            }
+            case 0x16: { /* HISTORY_PACKED([u16 max][u32 since_seq]) */
+                if (*resp_len < 16) {
+                    st = CMD_STATUS_ERR_BOUNDS;
+                    break;
+                }
+                size_t max = GRLC_TMP119_SAMPLER_DEPTH;
+                uint32_t since = 0;
+                if (req_len >= 4) {
+                    max = (size_t)req[2] | ((size_t)req[3] << 8);
+                }
+                if (req_len >= 8) {
+                    since = (uint32_t)req[4] | ((uint32_t)req[5] << 8) |
+                            ((uint32_t)req[6] << 16) | ((uint32_t)req[7] << 24);
+                }
+                uint32_t first = 0;
+                size_t packed = 0;
+                size_t n = grlc_tmp119_sampler_encode_packed(since, max, &resp[12],
+                                                             *resp_len - 12, &first, &packed);
+                struct tmp119_sampler_status ss;
+                grlc_tmp119_sampler_get(&ss);
+                uint32_t next = first + (uint32_t)n;
+                for (int i = 0; i < 4; ++i) {
+                    resp[i] = (uint8_t)(next >> (8 * i));
+                    resp[4 + i] = (uint8_t)(first >> (8 * i));
+                }
+                resp[8] = (uint8_t)(ss.period_ms & 0xFF);
+                resp[9] = (uint8_t)(ss.period_ms >> 8);
+                resp[10] = (uint8_t)(n & 0xFF);
+                resp[11] = (uint8_t)(n >> 8);
+                *resp_len = 12 + packed;
+                break;
+            }
             default:
                 st = CMD_STATUS_ERR_INVALID;
                 break;
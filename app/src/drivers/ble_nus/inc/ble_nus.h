@@ -5,6 +5,11 @@
  * (NUS) using Zephyr's Bluetooth stack. Incoming bytes are delivered via a
  * registered callback. This driver owns the BLE stack bring-up and
  * advertising lifecycle.
+ *
+ * Up to GRLC_BLE_MAX_LINKS centrals may be connected at once. Each connection
+ * occupies a link slot (0..GRLC_BLE_MAX_LINKS-1) with its own TX queue; RX
+ * bytes and TX calls carry the slot index so upper layers can keep one
+ * transport per central.
  */
 
 #pragma once
@@ -17,8 +22,68 @@
 extern "C" {
 #endif
 
-/** Callback invoked when bytes are received over NUS */
-typedef void (*ble_nus_rx_cb_t)(const uint8_t *data, size_t len, void *user);
+/**
+ * Number of link slots (simultaneous centrals). Each slot costs about 8 KB of
+ * RAM (transport, command binding, RX ring, TX ring); must not exceed
+ * CONFIG_BT_MAX_CONN. Override from the build to trade centrals for RAM.
+ */
+#ifndef GRLC_BLE_MAX_LINKS
+#define GRLC_BLE_MAX_LINKS 2
+#endif
+
+/**
+ * Largest manufacturer-specific AD payload (company ID included) that fits
+ * next to the flags in a 31-byte legacy advertising PDU.
+ */
+#define GRLC_BLE_MFG_DATA_MAX 26u
+
+/** Link selector meaning "the first connected link" for the query APIs */
+#define GRLC_BLE_LINK_ANY 0xFFu
+
+/**
+ * @brief Negotiated link parameters of one connection.
+ *
+ * Values reflect the defaults (23-byte ATT MTU, 27-octet LL payload, 1M PHY)
+ * until the post-connect MTU exchange, data length and PHY updates complete.
+ */
+struct ble_link_info {
+    uint16_t att_mtu;     /**< ATT MTU in bytes */
+    uint16_t tx_chunk;    /**< NUS payload bytes per notification (ATT MTU - 3) */
+    uint16_t tx_data_len; /**< LL TX payload octets (DLE) */
+    uint16_t rx_data_len; /**< LL RX payload octets (DLE) */
+    uint8_t tx_phy;       /**< TX PHY (BT_GAP_LE_PHY_*: 1=1M, 2=2M, 4=Coded) */
+    uint8_t rx_phy;       /**< RX PHY (BT_GAP_LE_PHY_*) */
+};
+
+/**
+ * @brief Connection-parameter profiles requested by the peripheral.
+ *
+ * The central has the final say; ble_conn_info reports what was granted.
+ */
+enum ble_conn_profile {
+    BLE_CONN_PROFILE_INTERACTIVE = 0, /**< 7.5 ms interval, no latency: command round trips */
+    BLE_CONN_PROFILE_BULK = 1,        /**< 15-30 ms interval: long connection events */
+    BLE_CONN_PROFILE_IDLE = 2,        /**< 100-200 ms interval, latency 4: low power */
+    BLE_CONN_PROFILE_COUNT,
+    BLE_CONN_PROFILE_AUTO = 0xFF, /**< Select from transport activity (default) */
+};
+
+/**
+ * @brief Connection parameters of one link and its profile selection.
+ */
+struct ble_conn_info {
+    uint16_t interval; /**< Connection interval in 1.25 ms units (0 when not connected) */
+    uint16_t latency;  /**< Peripheral latency in connection events */
+    uint16_t timeout;  /**< Supervision timeout in 10 ms units */
+    uint8_t profile;   /**< Profile selected for this link (enum ble_conn_profile) */
+    uint8_t auto_sel;  /**< 1 when the profile follows transport activity */
+};
+
+/** Callback invoked when bytes are received over NUS on link slot @p link */
+typedef void (*ble_nus_rx_cb_t)(uint8_t link, const uint8_t *data, size_t len, void *user);
+
+/** Callback invoked when link slot @p link connects or disconnects */
+typedef void (*ble_nus_conn_cb_t)(uint8_t link, bool connected, void *user);
 
 /**
  * @brief Initialize the BLE NUS driver and start advertising.
@@ -31,16 +96,38 @@ typedef void (*ble_nus_rx_cb_t)(const uint8_t *data, size_t len, void *user);
 int grlc_ble_init(ble_nus_rx_cb_t rx_cb, void *user);
 
 /**
- * @brief Send data over BLE NUS (notifications).
+ * @brief Install a hook for connection changes (called from BT context).
+ *
+ * Lets the owner of per-link state reset it when a slot is taken by a new
+ * central. Set before grlc_ble_init().
+ *
+ * @param cb   Hook to install; NULL to remove.
+ * @param user Opaque pointer passed back to @p cb.
+ */
+void grlc_ble_set_conn_notify(ble_nus_conn_cb_t cb, void *user);
+
+/**
+ * @brief Queue data for transmission over BLE NUS (notifications).
  *
- * Splits into ATT-sized chunks internally. Returns the number of bytes
- * accepted for transmission.
+ * Bytes are copied into a TX ring and sent as notifications of the negotiated
+ * ATT MTU minus the 3-byte header, with several notifications in flight.
+ * Completion callbacks keep the pipeline full without further calls. Returns
+ * the number of bytes queued; fewer than @p len means the ring is full.
  *
+ * @param link Link slot of the destination central
  * @param data Pointer to bytes to send
  * @param len  Number of bytes to send
- * @return number of bytes consumed (<= len)
+ * @return number of bytes consumed (<= len); 0 if @p link is not connected
  */
-size_t grlc_ble_send(const uint8_t *data, size_t len);
+size_t grlc_ble_send(uint8_t link, const uint8_t *data, size_t len);
+
+/**
+ * @brief Install a hook called (from BT context) whenever a notification
+ *        completes and TX ring space may have been freed.
+ *
+ * @param cb Hook to install; NULL to remove.
+ */
+void grlc_ble_set_tx_notify(void (*cb)(void));
 
 /**
  * @brief Enable or disable advertising.
@@ -50,6 +137,20 @@ size_t grlc_ble_send(const uint8_t *data, size_t len);
  */
 int grlc_ble_set_advertising(bool enable);
 
+/**
+ * @brief Set manufacturer-specific data carried in the advertising packets.
+ *
+ * While data is set the device name moves to the scan response so the
+ * payload fits the advertising PDU. Updates take effect immediately when
+ * advertising and are kept for the next (re)start otherwise.
+ *
+ * @param data Payload starting with the little-endian company ID; NULL to
+ *             remove it and restore the name in the advertising data.
+ * @param len  Payload length (<= GRLC_BLE_MFG_DATA_MAX).
+ * @return 0 on success, -EINVAL if too long, or the advertising update error.
+ */
+int grlc_ble_set_adv_mfg_data(const uint8_t *data, size_t len);
+
 /**
  * @brief Query BLE advertising/connection status.
  *
@@ -58,6 +159,41 @@ int grlc_ble_set_advertising(bool enable);
  */
 void grlc_ble_get_status(bool *advertising, bool *connected);
 
+/**
+ * @brief Number of connected centrals.
+ * @return Count of occupied link slots.
+ */
+uint8_t grlc_ble_conn_count(void);
+
+/**
+ * @brief Report negotiated MTU, data length and PHY of a connection.
+ *
+ * @param link      Link slot, or GRLC_BLE_LINK_ANY for the first connected one
+ * @param[out] info Filled with current values; zeroed when not connected.
+ */
+void grlc_ble_get_link_info(uint8_t link, struct ble_link_info *info);
+
+/**
+ * @brief Select a connection-parameter profile.
+ *
+ * A fixed profile overrides automatic selection until BLE_CONN_PROFILE_AUTO
+ * is set again. Applies to all connected links immediately and to later ones;
+ * in auto mode each link follows its own traffic.
+ *
+ * @param profile enum ble_conn_profile value or BLE_CONN_PROFILE_AUTO
+ * @return 0 on success, -EINVAL for an unknown profile.
+ */
+int grlc_ble_set_conn_profile(uint8_t profile);
+
+/**
+ * @brief Report connection parameters and the profile in use.
+ *
+ * @param link      Link slot, or GRLC_BLE_LINK_ANY for the first connected one
+ * @param[out] info Filled with current values; timing fields are zero when
+ *                  not connected.
+ */
+void grlc_ble_get_conn_info(uint8_t link, struct ble_conn_info *info);
+
 /**
  * @brief Get last disconnect reason (HCI error code semantics).
  *
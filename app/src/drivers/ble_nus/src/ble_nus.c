@@ -1,60 +1,543 @@
 #include "drivers/ble_nus/inc/ble_nus.h"
 
 #include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
 #include <zephyr/bluetooth/hci.h>
 #include <zephyr/bluetooth/services/nus.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <string.h>
 
+#include "utils/circular_buffer/inc/circular_buffer.h"
+
 LOG_MODULE_REGISTER(ble_nus, LOG_LEVEL_INF);
 
+BUILD_ASSERT(GRLC_BLE_MAX_LINKS <= CONFIG_BT_MAX_CONN, "more link slots than BT connections");
+
+/*
+ * TX queue: grlc_ble_send() appends to a per-link ring (single producer, the
+ * BLE runtime) and the pump turns it into notifications, keeping up to
+ * GRLC_BLE_TX_INFLIGHT notifications queued in the host. The ACL TX buffers
+ * are shared, so each link gets an equal share of them. Completion callbacks
+ * refill the pipeline from BT context.
+ *
+ * A disconnect only flags the slot; the ring and in-flight count are reset by
+ * whichever context next holds tx_pumping, so they are never touched
+ * concurrently with a pump. Each notification carries the slot's connection
+ * generation, and completions from an earlier connection are ignored.
+ */
+#ifndef GRLC_BLE_TX_RING_SIZE
+#define GRLC_BLE_TX_RING_SIZE 1024
+#endif
+#ifndef GRLC_BLE_TX_INFLIGHT
+#define GRLC_BLE_TX_INFLIGHT MAX(1, CONFIG_BT_BUF_ACL_TX_COUNT / GRLC_BLE_MAX_LINKS)
+#endif
+
+/* ATT notification header: opcode + handle */
+#define NUS_NOTIFY_OVERHEAD 3u
+/* Default ATT MTU before the exchange completes */
+#define NUS_ATT_MTU_MIN 23u
+
+/*
+ * Link upgrades run shortly after connect rather than via the stack's auto
+ * procedures, so they do not collide with the central's service discovery.
+ */
+#ifndef GRLC_BLE_LINK_SETUP_DELAY_MS
+#define GRLC_BLE_LINK_SETUP_DELAY_MS 100
+#endif
+
+/*
+ * Connection-parameter manager. In auto mode a periodic evaluation picks BULK
+ * while the link moves at least GRLC_BLE_BULK_BYTES per window, INTERACTIVE
+ * while there was traffic within GRLC_BLE_IDLE_AFTER_MS, and IDLE otherwise.
+ * Traffic on an idle link re-evaluates at once. Requests are only issued when
+ * the target changes, and always from the system workqueue.
+ */
+#ifndef GRLC_BLE_CONN_SETUP_DELAY_MS
+#define GRLC_BLE_CONN_SETUP_DELAY_MS 500
+#endif
+#ifndef GRLC_BLE_CONN_EVAL_MS
+#define GRLC_BLE_CONN_EVAL_MS 250
+#endif
+#ifndef GRLC_BLE_BULK_BYTES
+#define GRLC_BLE_BULK_BYTES 4096 /* per evaluation window, ~16 KB/s */
+#endif
+#ifndef GRLC_BLE_IDLE_AFTER_MS
+#define GRLC_BLE_IDLE_AFTER_MS 5000
+#endif
+/* A refused request is retried for the same profile only after this long */
+#ifndef GRLC_BLE_CONN_RETRY_MS
+#define GRLC_BLE_CONN_RETRY_MS 10000
+#endif
+
+/* Interval in 1.25 ms units, supervision timeout in 10 ms units */
+static const struct bt_le_conn_param s_conn_profiles[BLE_CONN_PROFILE_COUNT] = {
+    [BLE_CONN_PROFILE_INTERACTIVE] = BT_LE_CONN_PARAM_INIT(6, 6, 0, 400),
+    [BLE_CONN_PROFILE_BULK] = BT_LE_CONN_PARAM_INIT(12, 24, 0, 400),
+    [BLE_CONN_PROFILE_IDLE] = BT_LE_CONN_PARAM_INIT(80, 160, 4, 600),
+};
+static const char *const s_conn_profile_names[BLE_CONN_PROFILE_COUNT] = {
+    "interactive",
+    "bulk",
+    "idle",
+};
+
+/** @brief Per-central state; a slot is free while @ref conn is NULL. */
+struct ble_slot {
+    struct bt_conn *conn;
+    struct ble_link_info link;
+    struct k_work_delayable link_setup_work;
+    struct bt_gatt_exchange_params xparams;
+
+    /* TX queue */
+    circular_buffer_t tx_ring;
+    uint8_t tx_storage[GRLC_BLE_TX_RING_SIZE];
+    uint8_t tx_chunk[BT_L2CAP_TX_MTU]; /* owned by the context holding tx_pumping */
+    atomic_t tx_inflight;
+    atomic_t tx_pumping; /* one pumping context at a time */
+    atomic_t tx_repump;  /* completion arrived while pumping */
+    atomic_t tx_reset;   /* connection ended: flush before pumping again */
+    atomic_t gen;        /* connection generation of this slot */
+
+    /* Connection parameters */
+    struct k_work_delayable conn_param_work;
+    uint8_t profile;   /* selected target */
+    uint8_t requested; /* requested on this connection */
+    uint8_t failed;    /* last refused profile, BLE_CONN_PROFILE_COUNT if none */
+    uint32_t retry_ms; /* uptime before which the refused profile is not retried */
+    uint16_t interval;
+    uint16_t latency;
+    uint16_t timeout;
+    atomic_t act_bytes;   /* bytes moved in the current window */
+    atomic_t act_last_ms; /* uptime of the last RX/TX */
+};
+
 /* State */
-static struct bt_conn *s_conn;
+static struct ble_slot s_slots[GRLC_BLE_MAX_LINKS];
 static bool s_adv_on;
 static uint8_t s_last_disc_reason;
 static ble_nus_rx_cb_t s_rx_cb;
 static void *s_rx_user;
+static ble_nus_conn_cb_t s_conn_cb;
+static void *s_conn_user;
+static void (*s_tx_notify)(void);
+static const struct bt_gatt_attr *s_nus_tx_attr;
+static uint8_t s_mfg_data[GRLC_BLE_MFG_DATA_MAX]; /* broadcast payload */
+static size_t s_mfg_len;
+static K_MUTEX_DEFINE(s_adv_lock); /* advertising data and start/stop */
+static uint8_t s_conn_profile = BLE_CONN_PROFILE_INTERACTIVE; /* fixed profile */
+static bool s_conn_auto = true;
 
-#define NUS_CHUNK 20u
+/* NUS TX characteristic (device -> central notifications) */
+static const struct bt_uuid_128 s_nus_tx_uuid = BT_UUID_INIT_128(
+    BT_UUID_128_ENCODE(0x6E400003, 0xB5A3, 0xF393, 0xE0A9, 0xE50E24DCCA9E));
 
-static void nus_rx_cb(struct bt_conn *conn, const void *data, uint16_t len, void *ctx)
+static uint8_t slot_index(const struct ble_slot *s)
+{
+    return (uint8_t)(s - s_slots);
+}
+
+/** @brief Slot owning @p conn, or NULL for a connection we do not track. */
+static struct ble_slot *slot_of(const struct bt_conn *conn)
+{
+    for (size_t i = 0; i < GRLC_BLE_MAX_LINKS; ++i) {
+        if (s_slots[i].conn && s_slots[i].conn == conn) {
+            return &s_slots[i];
+        }
+    }
+    return NULL;
+}
+
+/** @brief First unoccupied slot, or NULL when all centrals' slots are taken. */
+static struct ble_slot *slot_free(void)
+{
+    for (size_t i = 0; i < GRLC_BLE_MAX_LINKS; ++i) {
+        if (!s_slots[i].conn) {
+            return &s_slots[i];
+        }
+    }
+    return NULL;
+}
+
+/** @brief Resolve a link selector to a connected slot, or NULL. */
+static struct ble_slot *slot_lookup(uint8_t link)
+{
+    if (link == GRLC_BLE_LINK_ANY) {
+        for (size_t i = 0; i < GRLC_BLE_MAX_LINKS; ++i) {
+            if (s_slots[i].conn) {
+                return &s_slots[i];
+            }
+        }
+        return NULL;
+    }
+    if (link < GRLC_BLE_MAX_LINKS && s_slots[link].conn) {
+        return &s_slots[link];
+    }
+    return NULL;
+}
+
+/** @brief Choose a profile from the traffic seen since the last evaluation. */
+static uint8_t conn_profile_from_activity(struct ble_slot *s)
+{
+    uint32_t bytes = (uint32_t)atomic_set(&s->act_bytes, 0);
+    uint32_t quiet_ms = k_uptime_get_32() - (uint32_t)atomic_get(&s->act_last_ms);
+    if (bytes >= GRLC_BLE_BULK_BYTES) {
+        return BLE_CONN_PROFILE_BULK;
+    }
+    /* Hysteresis: leave BULK only once traffic has clearly dropped */
+    if (s->requested == BLE_CONN_PROFILE_BULK && bytes >= GRLC_BLE_BULK_BYTES / 2) {
+        return BLE_CONN_PROFILE_BULK;
+    }
+    if (quiet_ms < GRLC_BLE_IDLE_AFTER_MS) {
+        return BLE_CONN_PROFILE_INTERACTIVE;
+    }
+    return BLE_CONN_PROFILE_IDLE;
+}
+
+static void conn_param_work_fn(struct k_work *work)
+{
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct ble_slot *s = CONTAINER_OF(dwork, struct ble_slot, conn_param_work);
+    struct bt_conn *conn = s->conn;
+    if (!conn) {
+        return;
+    }
+    s->profile = s_conn_auto ? conn_profile_from_activity(s) : s_conn_profile;
+    uint8_t p = s->profile;
+    uint32_t now = k_uptime_get_32();
+    bool backoff = (p == s->failed) && (int32_t)(now - s->retry_ms) < 0;
+    if (p != s->requested && !backoff) {
+        int rc = bt_conn_le_param_update(conn, &s_conn_profiles[p]);
+        if (rc == 0) {
+            s->requested = p;
+            s->failed = BLE_CONN_PROFILE_COUNT;
+            LOG_INF("Link %u conn profile -> %s", slot_index(s), s_conn_profile_names[p]);
+        } else {
+            if (p != s->failed) {
+                LOG_WRN("Link %u conn param update (%s) failed: %d; retrying every %u ms",
+                        slot_index(s), s_conn_profile_names[p], rc,
+                        (unsigned)GRLC_BLE_CONN_RETRY_MS);
+            }
+            s->failed = p;
+            s->retry_ms = now + GRLC_BLE_CONN_RETRY_MS;
+        }
+    }
+    if (s_conn_auto) {
+        (void)k_work_schedule(&s->conn_param_work, K_MSEC(GRLC_BLE_CONN_EVAL_MS));
+    }
+}
+
+/** @brief Account link traffic for the profile selection. */
+static void conn_note_activity(struct ble_slot *s, size_t bytes)
+{
+    atomic_add(&s->act_bytes, (atomic_val_t)bytes);
+    atomic_set(&s->act_last_ms, (atomic_val_t)k_uptime_get_32());
+    if (s_conn_auto && s->requested == BLE_CONN_PROFILE_IDLE) {
+        (void)k_work_reschedule(&s->conn_param_work, K_NO_WAIT);
+    }
+}
+
+static void le_param_updated(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+                             uint16_t timeout)
+{
+    struct ble_slot *s = slot_of(conn);
+    if (!s) {
+        return;
+    }
+    s->interval = interval;
+    s->latency = latency;
+    s->timeout = timeout;
+    LOG_INF("Link %u conn params: interval=%u latency=%u timeout=%u", slot_index(s), interval,
+            latency, timeout);
+}
+
+/** @brief Reset link info to Bluetooth Core defaults for a fresh connection. */
+static void link_info_defaults(struct ble_link_info *li)
+{
+    li->att_mtu = NUS_ATT_MTU_MIN;
+    li->tx_chunk = NUS_ATT_MTU_MIN - NUS_NOTIFY_OVERHEAD;
+    li->tx_data_len = BT_GAP_DATA_LEN_DEFAULT;
+    li->rx_data_len = BT_GAP_DATA_LEN_DEFAULT;
+    li->tx_phy = BT_GAP_LE_PHY_1M;
+    li->rx_phy = BT_GAP_LE_PHY_1M;
+}
+
+static void mtu_exchange_cb(struct bt_conn *conn, uint8_t err,
+                            struct bt_gatt_exchange_params *params)
+{
+    ARG_UNUSED(params);
+    if (err) {
+        LOG_WRN("MTU exchange failed: %u", err);
+    } else {
+        LOG_INF("MTU exchanged: %u", bt_gatt_get_mtu(conn));
+    }
+}
+
+/**
+ * @brief Request larger ATT MTU, LL data length and 2M PHY on a new link.
+ */
+static void link_setup_work_fn(struct k_work *work)
+{
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct ble_slot *s = CONTAINER_OF(dwork, struct ble_slot, link_setup_work);
+    struct bt_conn *conn = s->conn;
+    if (!conn) {
+        return;
+    }
+    s->xparams.func = mtu_exchange_cb;
+    int rc = bt_gatt_exchange_mtu(conn, &s->xparams);
+    if (rc && rc != -EALREADY) {
+        LOG_WRN("MTU exchange request failed: %d", rc);
+    }
+    rc = bt_conn_le_data_len_update(conn, BT_LE_DATA_LEN_PARAM_MAX);
+    if (rc) {
+        LOG_WRN("Data length update failed: %d", rc);
+    }
+    rc = bt_conn_le_phy_update(conn, BT_CONN_LE_PHY_PARAM_2M);
+    if (rc) {
+        LOG_WRN("PHY update failed: %d", rc);
+    }
+}
+
+static void att_mtu_updated(struct bt_conn *conn, uint16_t tx, uint16_t rx)
+{
+    struct ble_slot *s = slot_of(conn);
+    if (!s) {
+        return;
+    }
+    uint16_t mtu = MIN(tx, rx);
+    s->link.att_mtu = mtu;
+    s->link.tx_chunk = (uint16_t)(mtu - NUS_NOTIFY_OVERHEAD);
+    LOG_INF("Link %u ATT MTU updated: tx=%u rx=%u", slot_index(s), tx, rx);
+}
+
+static struct bt_gatt_cb gatt_cbs = {
+    .att_mtu_updated = att_mtu_updated,
+};
+
+static void le_data_len_updated(struct bt_conn *conn, struct bt_conn_le_data_len_info *info)
+{
+    struct ble_slot *s = slot_of(conn);
+    if (!s || !info) {
+        return;
+    }
+    s->link.tx_data_len = info->tx_max_len;
+    s->link.rx_data_len = info->rx_max_len;
+    LOG_INF("Link %u data length updated: tx=%u rx=%u", slot_index(s), info->tx_max_len,
+            info->rx_max_len);
+}
+
+static void le_phy_updated(struct bt_conn *conn, struct bt_conn_le_phy_info *param)
+{
+    struct ble_slot *s = slot_of(conn);
+    if (!s || !param) {
+        return;
+    }
+    s->link.tx_phy = param->tx_phy;
+    s->link.rx_phy = param->rx_phy;
+    LOG_INF("Link %u PHY updated: tx=%u rx=%u", slot_index(s), param->tx_phy, param->rx_phy);
+}
+
+/**
+ * @brief Current NUS payload size per notification on @p conn.
+ * @return Negotiated ATT MTU minus the notification header.
+ */
+static size_t nus_chunk_size(struct bt_conn *conn)
+{
+    uint16_t mtu = conn ? bt_gatt_get_mtu(conn) : NUS_ATT_MTU_MIN;
+    if (mtu < NUS_ATT_MTU_MIN) {
+        mtu = NUS_ATT_MTU_MIN;
+    }
+    return (size_t)mtu - NUS_NOTIFY_OVERHEAD;
+}
+
+static void tx_pump(struct ble_slot *s);
+
+/* Notification user_data: slot index in the low byte, connection generation above */
+#define TX_TAG(s, gen) UINT_TO_POINTER(((uint32_t)(gen) << 8) | slot_index(s))
+#define TX_TAG_SLOT(tag) (POINTER_TO_UINT(tag) & 0xFFu)
+#define TX_TAG_GEN(tag) (POINTER_TO_UINT(tag) >> 8)
+
+/** @brief Notification handed to the controller: refill that link's pipeline. */
+static void tx_sent_cb(struct bt_conn *conn, void *user_data)
 {
     ARG_UNUSED(conn);
+    struct ble_slot *s = &s_slots[TX_TAG_SLOT(user_data)];
+    if (TX_TAG_GEN(user_data) != ((uint32_t)atomic_get(&s->gen) & (UINT32_MAX >> 8))) {
+        /* Sent on a connection this slot no longer holds; already written off */
+        return;
+    }
+    atomic_dec(&s->tx_inflight);
+    tx_pump(s);
+    if (s_tx_notify) {
+        s_tx_notify();
+    }
+}
+
+/**
+ * @brief Move queued bytes of one link into notifications until its pipeline
+ *        is full.
+ *
+ * Callable from thread and BT context; an atomic flag lets only one caller
+ * drain the ring, and a completion arriving meanwhile makes it loop again.
+ */
+static void tx_pump(struct ble_slot *s)
+{
+    do {
+        if (!atomic_cas(&s->tx_pumping, 0, 1)) {
+            atomic_set(&s->tx_repump, 1);
+            return;
+        }
+        atomic_set(&s->tx_repump, 0);
+        if (atomic_cas(&s->tx_reset, 1, 0)) {
+            /* Queued bytes belong to the old connection's transport frames */
+            grlc_cb_advance_read(&s->tx_ring, grlc_cb_available(&s->tx_ring));
+            atomic_set(&s->tx_inflight, 0);
+        }
+        void *tag = TX_TAG(s, atomic_get(&s->gen));
+        struct bt_conn *conn = s->conn;
+        const size_t max_chunk = MIN(nus_chunk_size(conn), sizeof(s->tx_chunk));
+        while (conn && atomic_get(&s->tx_inflight) < GRLC_BLE_TX_INFLIGHT) {
+            size_t n = grlc_cb_peek(&s->tx_ring, s->tx_chunk, max_chunk);
+            if (n == 0) {
+                break;
+            }
+            struct bt_gatt_notify_params params = {
+                .attr = s_nus_tx_attr,
+                .data = s->tx_chunk,
+                .len = (uint16_t)n,
+                .func = tx_sent_cb,
+                .user_data = tag,
+            };
+            atomic_inc(&s->tx_inflight);
+            int rc = bt_gatt_notify_cb(conn, &params);
+            if (rc == 0) {
+                grlc_cb_advance_read(&s->tx_ring, n);
+            } else {
+                atomic_dec(&s->tx_inflight);
+                if (rc != -ENOMEM && rc != -ENOBUFS) {
+                    /* Not subscribed or link gone: nothing will drain this */
+                    size_t drop = grlc_cb_available(&s->tx_ring);
+                    LOG_WRN("Link %u NUS notify failed: %d; dropping %u queued bytes",
+                            slot_index(s), rc, (unsigned)drop);
+                    grlc_cb_advance_read(&s->tx_ring, drop);
+                }
+                break;
+            }
+        }
+        atomic_set(&s->tx_pumping, 0);
+    } while (atomic_get(&s->tx_repump));
+}
+
+static void nus_rx_cb(struct bt_conn *conn, const void *data, uint16_t len, void *ctx)
+{
     ARG_UNUSED(ctx);
+    struct ble_slot *s = slot_of(conn);
+    if (!s) {
+        return;
+    }
+    conn_note_activity(s, len);
     if (s_rx_cb && data && len) {
-        s_rx_cb((const uint8_t *)data, len, s_rx_user);
+        s_rx_cb(slot_index(s), (const uint8_t *)data, len, s_rx_user);
     }
 }
 
 static void connected(struct bt_conn *conn, uint8_t err)
 {
-    if (err == 0) {
-        s_conn = bt_conn_ref(conn);
-        LOG_INF("BLE connected");
-    } else {
+    if (err) {
         LOG_WRN("BLE connect failed: %u", err);
+        return;
+    }
+    struct ble_slot *s = slot_free();
+    if (!s) {
+        /* Only reachable if CONFIG_BT_MAX_CONN exceeds GRLC_BLE_MAX_LINKS */
+        LOG_WRN("No free link slot; disconnecting");
+        (void)bt_conn_disconnect(conn, BT_HCI_ERR_CONN_LIMIT_EXCEEDED);
+        return;
+    }
+    link_info_defaults(&s->link);
+    struct bt_conn_info ci;
+    if (bt_conn_get_info(conn, &ci) == 0) {
+        s->interval = ci.le.interval;
+        s->latency = ci.le.latency;
+        s->timeout = ci.le.timeout;
     }
+    s->profile = s_conn_auto ? BLE_CONN_PROFILE_INTERACTIVE : s_conn_profile;
+    s->requested = BLE_CONN_PROFILE_COUNT;
+    s->failed = BLE_CONN_PROFILE_COUNT;
+    atomic_set(&s->act_bytes, 0);
+    atomic_set(&s->act_last_ms, (atomic_val_t)k_uptime_get_32());
+    s->conn = bt_conn_ref(conn);
+    if (s_conn_cb) {
+        s_conn_cb(slot_index(s), true, s_conn_user);
+    }
+    (void)k_work_schedule(&s->link_setup_work, K_MSEC(GRLC_BLE_LINK_SETUP_DELAY_MS));
+    (void)k_work_schedule(&s->conn_param_work, K_MSEC(GRLC_BLE_CONN_SETUP_DELAY_MS));
+    LOG_INF("BLE connected: link %u (%u active)", slot_index(s), grlc_ble_conn_count());
 }
 
 static void disconnected(struct bt_conn *conn, uint8_t reason)
 {
-    ARG_UNUSED(conn);
     s_last_disc_reason = reason;
-    if (s_conn) {
-        bt_conn_unref(s_conn);
-        s_conn = NULL;
+    struct ble_slot *s = slot_of(conn);
+    if (!s) {
+        return;
+    }
+    (void)k_work_cancel_delayable(&s->link_setup_work);
+    (void)k_work_cancel_delayable(&s->conn_param_work);
+    s->conn = NULL;
+    bt_conn_unref(conn);
+    atomic_inc(&s->gen);
+    atomic_set(&s->tx_reset, 1);
+    /* Flushes now, or makes a pump running elsewhere flush before it returns */
+    tx_pump(s);
+    if (s_conn_cb) {
+        s_conn_cb(slot_index(s), false, s_conn_user);
     }
-    LOG_INF("BLE disconnected: reason=0x%02x", reason);
+    /* Connectable advertising is persistent: the host resumes it once the slot frees */
+    LOG_INF("BLE disconnected: link %u reason=0x%02x", slot_index(s), reason);
 }
 
 BT_CONN_CB_DEFINE(conn_cbs) = {
     .connected = connected,
     .disconnected = disconnected,
+    .le_param_updated = le_param_updated,
+    .le_data_len_updated = le_data_len_updated,
+    .le_phy_updated = le_phy_updated,
 };
 
-static int adv_start(void)
+/* Scan response: NUS UUID, plus the name while broadcast data fills the AD */
+static const uint8_t s_nus_uuid_ad[] = {0x6E, 0x40, 0x00, 0x01, 0xB5, 0xA3, 0xF3, 0x93,
+                                        0xE0, 0xA9, 0xE5, 0x0E, 0x24, 0xDC, 0xCA, 0x9E};
+static const uint8_t s_adv_flags = BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR;
+
+/**
+ * @brief Start advertising, or update the data of running advertising, with
+ *        the payload for the current mode. Caller holds s_adv_lock.
+ * @param start true to start, false to update in place
+ * @return 0 on success or the bt_le_adv_start/update error.
+ */
+static int adv_apply(bool start)
 {
+    const struct bt_data name =
+        BT_DATA(BT_DATA_NAME_COMPLETE, CONFIG_BT_DEVICE_NAME, strlen(CONFIG_BT_DEVICE_NAME));
+    const struct bt_data flags = BT_DATA(BT_DATA_FLAGS, &s_adv_flags, 1);
+    const struct bt_data uuid = BT_DATA(BT_DATA_UUID128_ALL, s_nus_uuid_ad, sizeof(s_nus_uuid_ad));
+    struct bt_data ad[2] = {flags, name};
+    struct bt_data sd[2] = {uuid};
+    size_t sd_len = 1;
+    if (s_mfg_len) {
+        ad[1] = (struct bt_data)BT_DATA(BT_DATA_MANUFACTURER_DATA, s_mfg_data, s_mfg_len);
+        sd[sd_len++] = name;
+    }
+    if (!start) {
+        return bt_le_adv_update_data(ad, ARRAY_SIZE(ad), sd, sd_len);
+    }
+    /*
+     * No BT_LE_ADV_OPT_ONE_TIME: the host keeps advertising after a central
+     * connects while connection objects remain, and resumes when one frees.
+     */
     const struct bt_le_adv_param adv_param = {
         .id = BT_ID_DEFAULT,
         .sid = 0,
@@ -64,18 +547,17 @@ static int adv_start(void)
         .interval_max = BT_GAP_ADV_FAST_INT_MAX_2,
         .peer = NULL,
     };
-    const struct bt_data ad[] = {
-        BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
-        BT_DATA(BT_DATA_NAME_COMPLETE, CONFIG_BT_DEVICE_NAME, strlen(CONFIG_BT_DEVICE_NAME)),
-    };
-    const struct bt_data sd[] = {
-        BT_DATA_BYTES(BT_DATA_UUID128_ALL, 0x6E, 0x40, 0x00, 0x01, 0xB5, 0xA3, 0xF3, 0x93, 0xE0,
-                      0xA9, 0xE5, 0x0E, 0x24, 0xDC, 0xCA, 0x9E),
-    };
-    int rc = bt_le_adv_start(&adv_param, ad, ARRAY_SIZE(ad), sd, ARRAY_SIZE(sd));
+    return bt_le_adv_start(&adv_param, ad, ARRAY_SIZE(ad), sd, sd_len);
+}
+
+static int adv_start(void)
+{
+    k_mutex_lock(&s_adv_lock, K_FOREVER);
+    int rc = adv_apply(true);
     if (rc == 0) {
         s_adv_on = true;
     }
+    k_mutex_unlock(&s_adv_lock);
     return rc;
 }
 
@@ -84,12 +566,25 @@ int grlc_ble_init(ble_nus_rx_cb_t rx_cb, void *user)
     s_rx_cb = rx_cb;
     s_rx_user = user;
 
+    for (size_t i = 0; i < GRLC_BLE_MAX_LINKS; ++i) {
+        struct ble_slot *s = &s_slots[i];
+        grlc_cb_init(&s->tx_ring, s->tx_storage, sizeof(s->tx_storage));
+        k_work_init_delayable(&s->link_setup_work, link_setup_work_fn);
+        k_work_init_delayable(&s->conn_param_work, conn_param_work_fn);
+    }
+
     int rc = bt_enable(NULL);
     if (rc) {
         LOG_ERR("bt_enable failed: %d", rc);
         return rc;
     }
 
+    bt_gatt_cb_register(&gatt_cbs);
+    s_nus_tx_attr = bt_gatt_find_by_uuid(NULL, 0, &s_nus_tx_uuid.uuid);
+    if (!s_nus_tx_attr) {
+        LOG_ERR("NUS TX characteristic not found");
+    }
+
     static struct bt_nus_cb cbs;
     memset(&cbs, 0, sizeof(cbs));
     cbs.received = nus_rx_cb;
@@ -107,24 +602,34 @@ int grlc_ble_init(ble_nus_rx_cb_t rx_cb, void *user)
     return 0;
 }
 
-size_t grlc_ble_send(const uint8_t *data, size_t len)
+void grlc_ble_set_conn_notify(ble_nus_conn_cb_t cb, void *user)
 {
-    if (!s_conn || !data || !len) {
+    s_conn_cb = cb;
+    s_conn_user = user;
+}
+
+size_t grlc_ble_send(uint8_t link, const uint8_t *data, size_t len)
+{
+    if (link >= GRLC_BLE_MAX_LINKS || !s_nus_tx_attr || !data || !len) {
         return 0;
     }
-    size_t off = 0;
-    while (off < len) {
-        size_t take = len - off;
-        if (take > NUS_CHUNK) {
-            take = NUS_CHUNK;
-        }
-        int rc = bt_nus_send(s_conn, &data[off], (uint16_t)take);
-        if (rc) {
-            break;
-        }
-        off += take;
+    struct ble_slot *s = &s_slots[link];
+    if (!s->conn) {
+        return 0;
+    }
+    if (atomic_get(&s->tx_reset)) {
+        /* Drop the previous connection's bytes before queueing for this one */
+        tx_pump(s);
     }
-    return off;
+    size_t n = grlc_cb_write(&s->tx_ring, data, len);
+    conn_note_activity(s, n);
+    tx_pump(s);
+    return n;
+}
+
+void grlc_ble_set_tx_notify(void (*cb)(void))
+{
+    s_tx_notify = cb;
 }
 
 int grlc_ble_set_advertising(bool enable)
@@ -135,23 +640,108 @@ int grlc_ble_set_advertising(bool enable)
         }
         return adv_start();
     } else {
-        if (!s_adv_on) {
-            return 0;
-        }
-        int rc = bt_le_adv_stop();
-        if (rc == 0) {
-            s_adv_on = false;
+        k_mutex_lock(&s_adv_lock, K_FOREVER);
+        int rc = 0;
+        if (s_adv_on) {
+            rc = bt_le_adv_stop();
+            if (rc == 0) {
+                s_adv_on = false;
+            }
         }
+        k_mutex_unlock(&s_adv_lock);
         return rc;
     }
 }
 
+int grlc_ble_set_adv_mfg_data(const uint8_t *data, size_t len)
+{
+    if (data && len > GRLC_BLE_MFG_DATA_MAX) {
+        return -EINVAL;
+    }
+    k_mutex_lock(&s_adv_lock, K_FOREVER);
+    s_mfg_len = data ? len : 0;
+    if (s_mfg_len) {
+        memcpy(s_mfg_data, data, s_mfg_len);
+    }
+    int rc = 0;
+    if (s_adv_on) {
+        rc = adv_apply(false);
+        if (rc == -EAGAIN) {
+            /* Paused while every connection slot is in use; applied on resume */
+            rc = 0;
+        }
+    }
+    k_mutex_unlock(&s_adv_lock);
+    return rc;
+}
+
+uint8_t grlc_ble_conn_count(void)
+{
+    uint8_t n = 0;
+    for (size_t i = 0; i < GRLC_BLE_MAX_LINKS; ++i) {
+        if (s_slots[i].conn) {
+            ++n;
+        }
+    }
+    return n;
+}
+
 void grlc_ble_get_status(bool *advertising, bool *connected)
 {
     if (advertising)
         *advertising = s_adv_on;
     if (connected)
-        *connected = (s_conn != NULL);
+        *connected = (grlc_ble_conn_count() != 0);
+}
+
+void grlc_ble_get_link_info(uint8_t link, struct ble_link_info *info)
+{
+    if (!info) {
+        return;
+    }
+    const struct ble_slot *s = slot_lookup(link);
+    if (s) {
+        *info = s->link;
+    } else {
+        memset(info, 0, sizeof(*info));
+    }
+}
+
+int grlc_ble_set_conn_profile(uint8_t profile)
+{
+    if (profile == BLE_CONN_PROFILE_AUTO) {
+        s_conn_auto = true;
+    } else if (profile < BLE_CONN_PROFILE_COUNT) {
+        s_conn_auto = false;
+        s_conn_profile = profile;
+    } else {
+        return -EINVAL;
+    }
+    /* Apply from the workqueue so requests stay serialized with auto mode */
+    for (size_t i = 0; i < GRLC_BLE_MAX_LINKS; ++i) {
+        if (s_slots[i].conn) {
+            (void)k_work_reschedule(&s_slots[i].conn_param_work, K_NO_WAIT);
+        }
+    }
+    return 0;
+}
+
+void grlc_ble_get_conn_info(uint8_t link, struct ble_conn_info *info)
+{
+    if (!info) {
+        return;
+    }
+    memset(info, 0, sizeof(*info));
+    const struct ble_slot *s = slot_lookup(link);
+    if (s) {
+        info->interval = s->interval;
+        info->latency = s->latency;
+        info->timeout = s->timeout;
+        info->profile = s->profile;
+    } else {
+        info->profile = s_conn_auto ? BLE_CONN_PROFILE_INTERACTIVE : s_conn_profile;
+    }
+    info->auto_sel = s_conn_auto ? 1u : 0u;
 }
 
 uint8_t grlc_ble_last_disc_reason(void)
@@ -12,6 +12,11 @@
 extern "C" {
 #endif
 
+#ifndef GRLC_I2C_ASYNC_SLOTS
+/** Concurrent one-shot grlc_i2c_write/read/write_read requests. */
+#define GRLC_I2C_ASYNC_SLOTS 4
+#endif
+
 /**
  * @brief I2C transfer completion callback type.
  *
@@ -22,29 +27,101 @@ extern "C" {
  */
 typedef void (*i2c_async_cb_t)(int result, void *user);
 
+/** @brief Step kinds understood by the transaction queue. */
+enum i2c_op_type {
+    I2C_OP_WRITE = 0,      /**< Write wdata[0..wlen) with STOP */
+    I2C_OP_READ = 1,       /**< Read rdata[0..rlen) with STOP */
+    I2C_OP_WRITE_READ = 2, /**< Write then repeated-start read */
+    I2C_OP_DELAY = 3,      /**< Idle the bus for delay_us before the next step */
+    I2C_OP_PROBE = 4,      /**< Address-only (zero-length) write; ACK => 0 */
+};
+
+/**
+ * @brief One step of a transaction chain.
+ *
+ * Buffers are referenced, not copied, and must stay valid until the chain
+ * completes.
+ */
+struct i2c_op {
+    uint8_t type;         /**< enum i2c_op_type */
+    uint16_t addr;        /**< 7-bit address (ignored for I2C_OP_DELAY) */
+    const uint8_t *wdata; /**< Bytes to write (WRITE, WRITE_READ) */
+    size_t wlen;          /**< Number of bytes to write */
+    uint8_t *rdata;       /**< Destination for read bytes (READ, WRITE_READ) */
+    size_t rlen;          /**< Number of bytes to read */
+    uint32_t delay_us;    /**< Idle time for I2C_OP_DELAY */
+};
+
+#define I2C_OP_WR(a, w, wl) {.type = I2C_OP_WRITE, .addr = (a), .wdata = (w), .wlen = (wl)}
+#define I2C_OP_RD(a, r, rl) {.type = I2C_OP_READ, .addr = (a), .rdata = (r), .rlen = (rl)}
+#define I2C_OP_WR_RD(a, w, wl, r, rl)                                                              \
+    {.type = I2C_OP_WRITE_READ, .addr = (a), .wdata = (w), .wlen = (wl), .rdata = (r), .rlen = (rl)}
+#define I2C_OP_WAIT_US(us) {.type = I2C_OP_DELAY, .delay_us = (us)}
+#define I2C_OP_PING(a)     {.type = I2C_OP_PROBE, .addr = (a)}
+
+/**
+ * @brief A queued sequence of I2C steps with a single completion callback.
+ *
+ * The caller owns the storage; it must stay valid until @c cb runs. Fields
+ * after @c user are managed by the queue.
+ */
+struct i2c_chain {
+    const struct i2c_op *ops; /**< Steps, executed in order */
+    size_t count;             /**< Number of steps */
+    i2c_async_cb_t cb;        /**< Called once with the first error or 0 (may be NULL) */
+    void *user;               /**< Opaque pointer returned to @c cb */
+    struct i2c_chain *q_next; /**< Queue linkage (internal) */
+};
+
+/** Supported SCL frequencies for grlc_i2c_set_speed(). */
+#define GRLC_I2C_SPEED_STANDARD_HZ  100000u  /**< Standard mode */
+#define GRLC_I2C_SPEED_FAST_HZ      400000u  /**< Fast mode */
+#define GRLC_I2C_SPEED_FAST_PLUS_HZ 1000000u /**< Fast mode plus */
+
 /**
  * @brief Initialize the default I2C device used by Garlic.
  *
- * Selects `&i2c0` from devicetree and configures a conservative bus speed
- * if supported by the SoC driver.
+ * Selects `&i2c0` from devicetree; the bus runs at the devicetree
+ * `clock-frequency` until changed with grlc_i2c_set_speed(). Idempotent:
+ * later calls return 0 without touching the controller.
  *
  * @return 0 on success, negative errno if the device is not ready.
  */
 int grlc_i2c_init(void);
 
+/**
+ * @brief Change the bus clock at runtime.
+ *
+ * Waits for the bus lock and for queued chains to drain, then reconfigures
+ * the controller. The setting persists until the next call or reboot.
+ *
+ * @param hz One of GRLC_I2C_SPEED_*_HZ.
+ * @return 0 on success, -EINVAL for an unknown rate, -ENOTSUP if the
+ *         controller rejects it (nRF52 TWIM has no fast mode plus),
+ *         -ETIMEDOUT if the bus stayed busy.
+ */
+int grlc_i2c_set_speed(uint32_t hz);
+
+/**
+ * @brief Current bus clock in Hz (0 before grlc_i2c_init()).
+ */
+uint32_t grlc_i2c_get_speed(void);
+
 /**
  * @brief Submit an asynchronous I2C write.
  *
  * If Zephyr is built with `CONFIG_I2C_CALLBACK=y`, the request is executed
  * using the callback-enabled API; otherwise this function falls back to a
  * synchronous transfer and invokes the callback immediately with the result.
+ * The transfer is queued behind any pending chains as a one-step chain.
  *
  * @param addr  7-bit I2C address.
  * @param data  Pointer to buffer to transmit.
  * @param len   Number of bytes to transmit.
  * @param cb    Completion callback (may be NULL).
  * @param user  Opaque pointer returned to the callback.
- * @return 0 if accepted, negative errno on error.
+ * @return 0 if accepted, -EBUSY if all GRLC_I2C_ASYNC_SLOTS requests are
+ *         pending, other negative errno on error.
  */
 int grlc_i2c_write(uint16_t addr, const uint8_t *data, size_t len, i2c_async_cb_t cb, void *user);
 
@@ -75,6 +152,38 @@ int grlc_i2c_read(uint16_t addr, uint8_t *data, size_t len, i2c_async_cb_t cb, v
 int grlc_i2c_write_read(uint16_t addr, const uint8_t *wdata, size_t wlen, uint8_t *rdata,
                         size_t rlen, i2c_async_cb_t cb, void *user);
 
+/**
+ * @brief Queue a transaction chain.
+ *
+ * Chains run one at a time in submission order. With `CONFIG_I2C_CALLBACK=y`
+ * each step is started from the completion interrupt of the previous one (and
+ * delays from a kernel timer), so a whole register sequence runs without
+ * waking a thread. The first failing step aborts the chain and its error is
+ * reported to the callback. Without callback support the chain runs
+ * synchronously in the caller's context before this function returns.
+ *
+ * @param chain Chain to execute; see struct i2c_chain for ownership rules.
+ * @return 0 if queued, -EINVAL for an empty/malformed chain, -ENODEV if the
+ *         bus is not ready.
+ */
+int grlc_i2c_chain_submit(struct i2c_chain *chain);
+
+/**
+ * @brief Run a chain and wait for it to finish.
+ *
+ * Takes the bus lock for the duration, so the steps cannot interleave with
+ * another thread's blocking transfers. On timeout it returns only once no
+ * transfer references @p ops' buffers any more: a step already in flight is
+ * allowed to finish, or aborted with a bus recovery after a short grace
+ * period, so the buffers may live on the caller's stack.
+ *
+ * @param ops        Steps to execute.
+ * @param count      Number of steps.
+ * @param timeout_ms Timeout for the whole chain in milliseconds (<0 waits forever).
+ * @return 0 on success, the first step's negative errno, or -ETIMEDOUT.
+ */
+int grlc_i2c_chain_run(const struct i2c_op *ops, size_t count, int timeout_ms);
+
 /**
  * @brief Blocking write wrapper built atop the async API.
  *
@@ -128,6 +237,21 @@ int grlc_i2c_bus_recover(void);
  */
 int grlc_i2c_ping(uint16_t addr);
 
+/**
+ * @brief Take exclusive ownership of the bus for a multi-transfer sequence.
+ *
+ * Links run in separate threads; hold the lock across register sequences that
+ * must not interleave (scan, EEPROM programming). Recursive for the owner, and
+ * taken internally by the blocking wrappers, ping and bus recovery.
+ *
+ * @param timeout_ms Maximum wait in milliseconds (<0 waits forever).
+ * @return 0 on success, -ETIMEDOUT if another thread kept the bus.
+ */
+int grlc_i2c_lock(int timeout_ms);
+
+/** @brief Release a lock taken with grlc_i2c_lock(). */
+void grlc_i2c_unlock(void);
+
 #ifdef __cplusplus
 }
 #endif
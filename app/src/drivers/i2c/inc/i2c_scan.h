@@ -0,0 +1,70 @@
+/**
+ * @file i2c_scan.h
+ * @brief Cached, interrupt-driven I2C address scan
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** First/last non-reserved 7-bit addresses. */
+#define GRLC_I2C_SCAN_FIRST 0x03
+#define GRLC_I2C_SCAN_LAST  0x77
+
+/** Probe every address in the range, ignoring cached results. */
+#define GRLC_I2C_SCAN_FORCE 0x01
+/** Stop at the first address that ACKs. */
+#define GRLC_I2C_SCAN_FIRST_ONLY 0x02
+
+/** @brief Snapshot of the scan cache. */
+struct i2c_scan_info {
+    uint32_t generation; /**< Incremented by every scan that probed the bus */
+    bool read_probe;     /**< true if the controller needed 1-byte read probes */
+    uint8_t present[16]; /**< Bit a set: address a ACKed (LSB first) */
+    uint8_t known[16];   /**< Bit a set: address a has a cached result */
+};
+
+/**
+ * @brief Scan an address range and update the cache.
+ *
+ * Each address is probed with a zero-length write; the next probe is queued
+ * from the previous one's completion callback, so the sweep runs without
+ * thread wake-ups. If the controller rejects zero-length writes the engine
+ * switches to 1-byte read probes for the rest of the session. Addresses with
+ * a cached result are skipped unless GRLC_I2C_SCAN_FORCE is set, so a repeat
+ * scan of a known range touches no hardware. A stuck bus (-EBUSY/-ETIMEDOUT
+ * from the controller) aborts the sweep.
+ *
+ * @param first      First 7-bit address (clamped to GRLC_I2C_SCAN_FIRST).
+ * @param last       Last 7-bit address (clamped to GRLC_I2C_SCAN_LAST).
+ * @param flags      GRLC_I2C_SCAN_* flags.
+ * @param timeout_ms Maximum time for the sweep (<0 waits forever).
+ * @return 0 on success, -EINVAL if first > last, -EBUSY if a previous sweep
+ *         is still winding down, -ETIMEDOUT, or the controller's error.
+ */
+int grlc_i2c_scan(uint8_t first, uint8_t last, uint8_t flags, int timeout_ms);
+
+/**
+ * @brief Copy cached responders in [first, last] into @p out.
+ * @return Number of responders (may exceed @p cap; only @p cap are written).
+ */
+size_t grlc_i2c_scan_list(uint8_t first, uint8_t last, uint8_t *out, size_t cap);
+
+/** @brief true if @p addr7 ACKed in the most recent probe of that address. */
+bool grlc_i2c_scan_present(uint8_t addr7);
+
+/** @brief Snapshot the cache and generation counter. */
+void grlc_i2c_scan_info(struct i2c_scan_info *out);
+
+/** @brief Forget all cached results (e.g. after re-cabling). */
+void grlc_i2c_scan_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -5,6 +5,10 @@
 #include "drivers/i2c/inc/i2c.h"
 
 static const struct device *i2c_dev;
+static uint32_t s_speed_hz;
+
+/* Serializes blocking users across link threads */
+static K_MUTEX_DEFINE(s_bus_lock);
 
 struct i2c_req_ctx {
     struct k_sem done;
@@ -13,56 +17,369 @@ struct i2c_req_ctx {
 
 int grlc_i2c_init(void)
 {
+    if (i2c_dev)
+        return 0;
     /* Default to &i2c0 for nRF52-DK overlay */
-    i2c_dev = DEVICE_DT_GET(DT_NODELABEL(i2c0));
-    if (!device_is_ready(i2c_dev)) {
+    const struct device *dev = DEVICE_DT_GET(DT_NODELABEL(i2c0));
+    if (!device_is_ready(dev)) {
         return -ENODEV;
     }
-    /* Try to set a conservative speed; some stacks may not support runtime configure. */
-    (void)i2c_configure(i2c_dev, I2C_MODE_CONTROLLER | I2C_SPEED_SET(I2C_SPEED_STANDARD));
+    s_speed_hz = DT_PROP(DT_NODELABEL(i2c0), clock_frequency);
+    i2c_dev = dev;
     return 0;
 }
 
-int grlc_i2c_write(uint16_t addr, const uint8_t *data, size_t len, i2c_async_cb_t cb, void *user)
+/* Transaction queue: one chain executes at a time, the rest wait in FIFO order.
+ * A blocking caller that times out withdraws a queued chain at once. For the
+ * running chain it stops further steps and waits for the in-flight step to
+ * end, because EasyDMA still owns that step's buffers. If the step does not
+ * end within GRLC_I2C_ABORT_MS, the transfer is aborted by recovering the bus
+ * and written off; every step carries a sequence number, so a completion that
+ * arrives after the write-off is ignored.
+ */
+#ifndef GRLC_I2C_ABORT_MS
+#define GRLC_I2C_ABORT_MS 50
+#endif
+static struct k_spinlock s_q_lock;
+static struct i2c_chain *s_q_head;
+static struct i2c_chain *s_q_tail;
+static bool s_q_busy;
+static struct {
+    struct i2c_chain *chain; /* NULL while the queue is idle */
+    const struct i2c_op *ops;
+    size_t count;
+    size_t next;
+    i2c_async_cb_t cb;
+    void *user;
+} s_cur;
+/* Messages of the in-flight step; must outlive i2c_transfer_cb() */
+static struct i2c_msg s_msgs[2];
+static uint32_t s_step_seq; /* step in flight; guarded by s_q_lock */
+static uint8_t s_probe_byte;
+#ifdef CONFIG_I2C_CALLBACK
+static bool s_cb_unsupported;
+static void chain_delay_expired(struct k_timer *t);
+static K_TIMER_DEFINE(s_delay_timer, chain_delay_expired, NULL);
+#endif
+
+static void chain_step(void);
+
+/**
+ * @brief Load @p c as the running chain. Caller holds s_q_lock.
+ */
+static void chain_load(struct i2c_chain *c)
 {
-    if (!i2c_dev || !data || len == 0)
-        return -EINVAL;
-    struct i2c_msg msg = {
-        .buf = (uint8_t *)data,
-        .len = (uint32_t)len,
-        .flags = I2C_MSG_WRITE | I2C_MSG_STOP,
-    };
+    s_cur.chain = c;
+    s_cur.ops = c->ops;
+    s_cur.count = c->count;
+    s_cur.next = 0;
+    s_cur.cb = c->cb;
+    s_cur.user = c->user;
+}
+
+/**
+ * @brief Report the running chain's result and start the next queued one.
+ * @param result 0 or the failing step's negative errno.
+ */
+static void chain_finish(int result)
+{
+    k_spinlock_key_t key = k_spin_lock(&s_q_lock);
+    i2c_async_cb_t cb = s_cur.cb;
+    void *user = s_cur.user;
+    struct i2c_chain *next = s_q_head;
+    if (next) {
+        s_q_head = next->q_next;
+        if (!s_q_head)
+            s_q_tail = NULL;
+        chain_load(next);
+    } else {
+        s_cur.chain = NULL;
+        s_q_busy = false;
+    }
+    k_spin_unlock(&s_q_lock, key);
+    if (cb)
+        cb(result, user);
+    if (next)
+        chain_step();
+}
+
+/**
+ * @brief Translate a transfer step into s_msgs.
+ * @return Number of messages, or 0 if the step is malformed.
+ */
+static uint8_t op_to_msgs(const struct i2c_op *op)
+{
+    switch (op->type) {
+        case I2C_OP_WRITE:
+            if (!op->wdata || op->wlen == 0)
+                return 0;
+            s_msgs[0].buf = (uint8_t *)op->wdata;
+            s_msgs[0].len = (uint32_t)op->wlen;
+            s_msgs[0].flags = I2C_MSG_WRITE | I2C_MSG_STOP;
+            return 1;
+        case I2C_OP_READ:
+            if (!op->rdata || op->rlen == 0)
+                return 0;
+            s_msgs[0].buf = op->rdata;
+            s_msgs[0].len = (uint32_t)op->rlen;
+            s_msgs[0].flags = I2C_MSG_READ | I2C_MSG_STOP;
+            return 1;
+        case I2C_OP_WRITE_READ:
+            if (!op->wdata || op->wlen == 0 || !op->rdata || op->rlen == 0)
+                return 0;
+            s_msgs[0].buf = (uint8_t *)op->wdata;
+            s_msgs[0].len = (uint32_t)op->wlen;
+            s_msgs[0].flags = I2C_MSG_WRITE | I2C_MSG_RESTART;
+            s_msgs[1].buf = op->rdata;
+            s_msgs[1].len = (uint32_t)op->rlen;
+            s_msgs[1].flags = I2C_MSG_READ | I2C_MSG_STOP;
+            return 2;
+        case I2C_OP_PROBE:
+            s_msgs[0].buf = &s_probe_byte;
+            s_msgs[0].len = 0;
+            s_msgs[0].flags = I2C_MSG_WRITE | I2C_MSG_STOP;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
 #ifdef CONFIG_I2C_CALLBACK
-    int rc = i2c_transfer_cb(i2c_dev, &msg, 1, addr, (i2c_callback_t)cb, user);
-    if (rc != -ENOSYS) {
-        return rc;
+/** @return true if @p data tags the step in flight (not one written off). */
+static bool step_current(void *data)
+{
+    k_spinlock_key_t key = k_spin_lock(&s_q_lock);
+    bool cur = (POINTER_TO_UINT(data) == s_step_seq);
+    k_spin_unlock(&s_q_lock, key);
+    return cur;
+}
+
+/** Completion of an interrupt-driven step (ISR context). */
+static void chain_xfer_done(const struct device *dev, int result, void *data)
+{
+    ARG_UNUSED(dev);
+    if (!step_current(data)) {
+        return;
+    }
+    if (result) {
+        chain_finish(result);
+        return;
+    }
+    chain_step();
+}
+
+static void chain_delay_expired(struct k_timer *t)
+{
+    if (!step_current(k_timer_user_data_get(t))) {
+        return;
     }
+    chain_step();
+}
 #endif
-    int res = i2c_transfer(i2c_dev, &msg, 1, addr);
-    if (cb)
-        cb(res, user);
-    return 0;
+
+/**
+ * @brief Start steps of the running chain until one is pending in hardware.
+ *
+ * Runs from the submitter, the I2C completion ISR or the delay timer. In the
+ * synchronous fallback the whole chain completes inside this loop.
+ */
+static void chain_step(void)
+{
+    for (;;) {
+        k_spinlock_key_t key = k_spin_lock(&s_q_lock);
+        if (s_cur.next >= s_cur.count) {
+            k_spin_unlock(&s_q_lock, key);
+            chain_finish(0);
+            return;
+        }
+        const struct i2c_op op = s_cur.ops[s_cur.next++];
+        void *seq = UINT_TO_POINTER(++s_step_seq);
+        k_spin_unlock(&s_q_lock, key);
+
+        if (op.type == I2C_OP_DELAY) {
+#ifdef CONFIG_I2C_CALLBACK
+            if (!s_cb_unsupported) {
+                k_timer_user_data_set(&s_delay_timer, seq);
+                k_timer_start(&s_delay_timer, K_USEC(op.delay_us), K_NO_WAIT);
+                return;
+            }
+#endif
+            if (k_is_in_isr())
+                k_busy_wait(op.delay_us);
+            else
+                k_usleep((int32_t)op.delay_us);
+            continue;
+        }
+
+        uint8_t n = op_to_msgs(&op);
+        if (n == 0) {
+            chain_finish(-EINVAL);
+            return;
+        }
+#ifdef CONFIG_I2C_CALLBACK
+        if (!s_cb_unsupported) {
+            int rc = i2c_transfer_cb(i2c_dev, s_msgs, n, op.addr, chain_xfer_done, seq);
+            if (rc == 0)
+                return;
+            if (rc != -ENOSYS) {
+                chain_finish(rc);
+                return;
+            }
+            s_cb_unsupported = true;
+        }
+#endif
+        int rc = i2c_transfer(i2c_dev, s_msgs, n, op.addr);
+        if (rc) {
+            chain_finish(rc);
+            return;
+        }
+    }
 }
 
-int grlc_i2c_read(uint16_t addr, uint8_t *data, size_t len, i2c_async_cb_t cb, void *user)
+int grlc_i2c_chain_submit(struct i2c_chain *chain)
 {
-    if (!i2c_dev || !data || len == 0)
+    if (!chain || !chain->ops || chain->count == 0)
         return -EINVAL;
-    struct i2c_msg msg = {
-        .buf = data,
-        .len = (uint32_t)len,
-        .flags = I2C_MSG_READ | I2C_MSG_STOP,
-    };
-#ifdef CONFIG_I2C_CALLBACK
-    int rc = i2c_transfer_cb(i2c_dev, &msg, 1, addr, (i2c_callback_t)cb, user);
-    if (rc != -ENOSYS) {
-        return rc;
+    if (!i2c_dev)
+        return -ENODEV;
+    chain->q_next = NULL;
+    k_spinlock_key_t key = k_spin_lock(&s_q_lock);
+    if (s_q_busy) {
+        if (s_q_tail)
+            s_q_tail->q_next = chain;
+        else
+            s_q_head = chain;
+        s_q_tail = chain;
+        k_spin_unlock(&s_q_lock, key);
+        return 0;
+    }
+    s_q_busy = true;
+    chain_load(chain);
+    k_spin_unlock(&s_q_lock, key);
+    chain_step();
+    return 0;
+}
+
+enum chain_cancel_result {
+    CHAIN_COMPLETING, /* callback already being delivered */
+    CHAIN_UNQUEUED,   /* was still queued; removed, callback never runs */
+    CHAIN_STOPPING,   /* running; no further steps, callback follows the step in flight */
+};
+
+/**
+ * @brief Withdraw a chain whose owner stopped waiting.
+ *
+ * A queued chain is unlinked. The running chain keeps its in-flight step
+ * (EasyDMA may be using the chain's buffers) but starts no further steps; its
+ * callback runs when that step ends, or from chain_abort().
+ */
+static enum chain_cancel_result chain_cancel(struct i2c_chain *chain)
+{
+    enum chain_cancel_result res = CHAIN_COMPLETING;
+    k_spinlock_key_t key = k_spin_lock(&s_q_lock);
+    if (s_q_busy && s_cur.chain == chain) {
+        s_cur.count = s_cur.next;
+        res = CHAIN_STOPPING;
+    } else {
+        struct i2c_chain *prev = NULL;
+        for (struct i2c_chain *c = s_q_head; c; prev = c, c = c->q_next) {
+            if (c != chain)
+                continue;
+            if (prev)
+                prev->q_next = c->q_next;
+            else
+                s_q_head = c->q_next;
+            if (s_q_tail == c)
+                s_q_tail = prev;
+            res = CHAIN_UNQUEUED;
+            break;
+        }
     }
+    k_spin_unlock(&s_q_lock, key);
+    return res;
+}
+
+/**
+ * @brief Abort the running chain's hung step and fail the chain.
+ *
+ * Recovering the bus disables TWIM, which stops EasyDMA, so the chain's
+ * buffers are released once this returns. No-op if @p chain is no longer
+ * running.
+ */
+static void chain_abort(struct i2c_chain *chain)
+{
+    k_spinlock_key_t key = k_spin_lock(&s_q_lock);
+    bool running = s_q_busy && s_cur.chain == chain;
+    if (running) {
+        /* Completions and delay expiries of the hung step are now stale */
+        ++s_step_seq;
+    }
+    k_spin_unlock(&s_q_lock, key);
+    if (!running) {
+        return;
+    }
+#ifdef CONFIG_I2C_CALLBACK
+    k_timer_stop(&s_delay_timer);
 #endif
-    int res = i2c_transfer(i2c_dev, &msg, 1, addr);
+    (void)i2c_recover_bus(i2c_dev);
+    chain_finish(-ETIMEDOUT);
+}
+
+/* One-shot async calls borrow a static single-step chain */
+struct i2c_async_slot {
+    struct i2c_chain chain;
+    struct i2c_op op;
+    i2c_async_cb_t cb;
+    void *user;
+};
+static struct i2c_async_slot s_slots[GRLC_I2C_ASYNC_SLOTS];
+static atomic_t s_slots_used;
+
+static void slot_done(int result, void *user)
+{
+    struct i2c_async_slot *slot = (struct i2c_async_slot *)user;
+    i2c_async_cb_t cb = slot->cb;
+    void *cb_user = slot->user;
+    atomic_clear_bit(&s_slots_used, (int)(slot - s_slots));
     if (cb)
-        cb(res, user);
-    return 0;
+        cb(result, cb_user);
+}
+
+static int submit_one(const struct i2c_op *op, i2c_async_cb_t cb, void *user)
+{
+    for (int i = 0; i < GRLC_I2C_ASYNC_SLOTS; ++i) {
+        if (atomic_test_and_set_bit(&s_slots_used, i))
+            continue;
+        struct i2c_async_slot *slot = &s_slots[i];
+        slot->op = *op;
+        slot->cb = cb;
+        slot->user = user;
+        slot->chain.ops = &slot->op;
+        slot->chain.count = 1;
+        slot->chain.cb = slot_done;
+        slot->chain.user = slot;
+        int rc = grlc_i2c_chain_submit(&slot->chain);
+        if (rc)
+            atomic_clear_bit(&s_slots_used, i);
+        return rc;
+    }
+    return -EBUSY;
+}
+
+int grlc_i2c_write(uint16_t addr, const uint8_t *data, size_t len, i2c_async_cb_t cb, void *user)
+{
+    if (!i2c_dev || !data || len == 0)
+        return -EINVAL;
+    const struct i2c_op op = I2C_OP_WR(addr, data, len);
+    return submit_one(&op, cb, user);
+}
+
+int grlc_i2c_read(uint16_t addr, uint8_t *data, size_t len, i2c_async_cb_t cb, void *user)
+{
+    if (!i2c_dev || !data || len == 0)
+        return -EINVAL;
+    const struct i2c_op op = I2C_OP_RD(addr, data, len);
+    return submit_one(&op, cb, user);
 }
 
 int grlc_i2c_write_read(uint16_t addr, const uint8_t *wdata, size_t wlen, uint8_t *rdata,
@@ -70,41 +387,83 @@ int grlc_i2c_write_read(uint16_t addr, const uint8_t *wdata, size_t wlen, uint8_
 {
     if (!i2c_dev || !wdata || wlen == 0 || !rdata || rlen == 0)
         return -EINVAL;
-    struct i2c_msg msgs[2] = {
-        {
-            .buf = (uint8_t *)wdata,
-            .len = (uint32_t)wlen,
-            .flags = I2C_MSG_WRITE | I2C_MSG_RESTART,
-        },
-        {
-            .buf = rdata,
-            .len = (uint32_t)rlen,
-            .flags = I2C_MSG_READ | I2C_MSG_STOP,
-        },
-    };
-#ifdef CONFIG_I2C_CALLBACK
-    int rc = i2c_transfer_cb(i2c_dev, msgs, 2, addr, (i2c_callback_t)cb, user);
-    if (rc != -ENOSYS) {
+    const struct i2c_op op = I2C_OP_WR_RD(addr, wdata, wlen, rdata, rlen);
+    return submit_one(&op, cb, user);
+}
+
+/** @return true when no chain is running or queued. */
+static bool queue_idle(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&s_q_lock);
+    bool idle = !s_q_busy;
+    k_spin_unlock(&s_q_lock, key);
+    return idle;
+}
+
+int grlc_i2c_set_speed(uint32_t hz)
+{
+    uint32_t speed;
+    switch (hz) {
+        case GRLC_I2C_SPEED_STANDARD_HZ:
+            speed = I2C_SPEED_STANDARD;
+            break;
+        case GRLC_I2C_SPEED_FAST_HZ:
+            speed = I2C_SPEED_FAST;
+            break;
+        case GRLC_I2C_SPEED_FAST_PLUS_HZ:
+            speed = I2C_SPEED_FAST_PLUS;
+            break;
+        default:
+            return -EINVAL;
+    }
+    int rc = grlc_i2c_init();
+    if (rc)
         return rc;
+    if (hz == s_speed_hz)
+        return 0;
+    if (grlc_i2c_lock(100) != 0)
+        return -ETIMEDOUT;
+    /* Async submitters do not take the lock; let their chains finish */
+    for (int i = 0; i < 100 && !queue_idle(); ++i)
+        k_msleep(1);
+    if (!queue_idle()) {
+        grlc_i2c_unlock();
+        return -ETIMEDOUT;
     }
-#endif
-    int res = i2c_transfer(i2c_dev, msgs, 2, addr);
-    if (cb)
-        cb(res, user);
-    return 0;
+    rc = i2c_configure(i2c_dev, I2C_MODE_CONTROLLER | I2C_SPEED_SET(speed));
+    if (rc == 0)
+        s_speed_hz = hz;
+    grlc_i2c_unlock();
+    return (rc == 0) ? 0 : -ENOTSUP;
+}
+
+uint32_t grlc_i2c_get_speed(void)
+{
+    return s_speed_hz;
+}
+
+int grlc_i2c_lock(int timeout_ms)
+{
+    k_timeout_t to = (timeout_ms < 0) ? K_FOREVER : K_MSEC(timeout_ms);
+    return (k_mutex_lock(&s_bus_lock, to) == 0) ? 0 : -ETIMEDOUT;
+}
+
+void grlc_i2c_unlock(void)
+{
+    (void)k_mutex_unlock(&s_bus_lock);
 }
 
 /* Blocking wrappers */
 /**
  * @brief Wait for a semaphore with millisecond timeout.
  * @param sem        Semaphore to take.
- * @param timeout_ms Timeout in milliseconds (<=0 for no wait, <0 for forever).
+ * @param timeout_ms Timeout in milliseconds (0 for no wait, <0 for forever).
  * @return 0 on success, negative on timeout.
  */
 static int wait_sem(struct k_sem *sem, int timeout_ms)
 {
     if (timeout_ms < 0)
-        timeout_ms = K_FOREVER.ticks;
+        return k_sem_take(sem, K_FOREVER);
     k_timeout_t to = (timeout_ms == 0) ? K_NO_WAIT : K_MSEC(timeout_ms);
     return k_sem_take(sem, to);
 }
@@ -123,44 +482,71 @@ static void bridge_cb(int result, void *user)
     }
 }
 
-int grlc_i2c_blocking_write(uint16_t addr, const uint8_t *data, size_t len, int timeout_ms)
+int grlc_i2c_chain_run(const struct i2c_op *ops, size_t count, int timeout_ms)
 {
     struct i2c_req_ctx ctx;
     k_sem_init(&ctx.done, 0, 1);
     ctx.result = -EIO;
-    int rc = grlc_i2c_write(addr, data, len, bridge_cb, &ctx);
-    if (rc)
-        return rc;
-    if (wait_sem(&ctx.done, timeout_ms) != 0)
+    struct i2c_chain chain = {
+        .ops = ops,
+        .count = count,
+        .cb = bridge_cb,
+        .user = &ctx,
+    };
+    if (grlc_i2c_lock(timeout_ms) != 0)
         return -ETIMEDOUT;
-    return ctx.result;
+    int rc = grlc_i2c_chain_submit(&chain);
+    if (rc == 0) {
+        if (wait_sem(&ctx.done, timeout_ms) == 0) {
+            rc = ctx.result;
+        } else {
+            switch (chain_cancel(&chain)) {
+                case CHAIN_UNQUEUED:
+                    rc = -ETIMEDOUT;
+                    break;
+                case CHAIN_STOPPING:
+                    /* The step in flight still owns our buffers: let it end, or abort it */
+                    if (wait_sem(&ctx.done, GRLC_I2C_ABORT_MS) != 0) {
+                        chain_abort(&chain);
+                    }
+                    (void)k_sem_take(&ctx.done, K_FOREVER);
+                    rc = -ETIMEDOUT;
+                    break;
+                default:
+                    /* Completion raced the timeout; ctx is about to be written */
+                    (void)k_sem_take(&ctx.done, K_FOREVER);
+                    rc = ctx.result;
+                    break;
+            }
+        }
+    }
+    grlc_i2c_unlock();
+    return rc;
+}
+
+int grlc_i2c_blocking_write(uint16_t addr, const uint8_t *data, size_t len, int timeout_ms)
+{
+    if (!i2c_dev || !data || len == 0)
+        return -EINVAL;
+    const struct i2c_op op = I2C_OP_WR(addr, data, len);
+    return grlc_i2c_chain_run(&op, 1, timeout_ms);
 }
 
 int grlc_i2c_blocking_read(uint16_t addr, uint8_t *data, size_t len, int timeout_ms)
 {
-    struct i2c_req_ctx ctx;
-    k_sem_init(&ctx.done, 0, 1);
-    ctx.result = -EIO;
-    int rc = grlc_i2c_read(addr, data, len, bridge_cb, &ctx);
-    if (rc)
-        return rc;
-    if (wait_sem(&ctx.done, timeout_ms) != 0)
-        return -ETIMEDOUT;
-    return ctx.result;
+    if (!i2c_dev || !data || len == 0)
+        return -EINVAL;
+    const struct i2c_op op = I2C_OP_RD(addr, data, len);
+    return grlc_i2c_chain_run(&op, 1, timeout_ms);
 }
 
 int grlc_i2c_blocking_write_read(uint16_t addr, const uint8_t *wdata, size_t wlen, uint8_t *rdata,
                                  size_t rlen, int timeout_ms)
 {
-    struct i2c_req_ctx ctx;
-    k_sem_init(&ctx.done, 0, 1);
-    ctx.result = -EIO;
-    int rc = grlc_i2c_write_read(addr, wdata, wlen, rdata, rlen, bridge_cb, &ctx);
-    if (rc)
-        return rc;
-    if (wait_sem(&ctx.done, timeout_ms) != 0)
-        return -ETIMEDOUT;
-    return ctx.result;
+    if (!i2c_dev || !wdata || wlen == 0 || !rdata || rlen == 0)
+        return -EINVAL;
+    const struct i2c_op op = I2C_OP_WR_RD(addr, wdata, wlen, rdata, rlen);
+    return grlc_i2c_chain_run(&op, 1, timeout_ms);
 }
 
 int grlc_i2c_bus_recover(void)
@@ -170,7 +556,10 @@ int grlc_i2c_bus_recover(void)
         if (rc)
             return rc;
     }
-    return i2c_recover_bus(i2c_dev);
+    (void)grlc_i2c_lock(-1);
+    int rc = i2c_recover_bus(i2c_dev);
+    grlc_i2c_unlock();
+    return rc;
 }
 
 int grlc_i2c_ping(uint16_t addr)
@@ -181,10 +570,6 @@ int grlc_i2c_ping(uint16_t addr)
             return rc;
     }
     uint8_t dummy = 0;
-    struct i2c_msg msg = {
-        .buf = &dummy,
-        .len = 1,
-        .flags = I2C_MSG_READ | I2C_MSG_STOP,
-    };
-    return i2c_transfer(i2c_dev, &msg, 1, addr);
+    const struct i2c_op op = I2C_OP_RD(addr, &dummy, 1);
+    return grlc_i2c_chain_run(&op, 1, -1);
 }
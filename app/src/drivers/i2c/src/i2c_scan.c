@@ -0,0 +1,232 @@
+#include "drivers/i2c/inc/i2c_scan.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "drivers/i2c/inc/i2c.h"
+
+#ifdef __ZEPHYR__
+#include <zephyr/kernel.h>
+static struct k_spinlock s_pump_lock;
+static K_SEM_DEFINE(s_done, 0, 1);
+#define PUMP_LOCK() k_spinlock_key_t key = k_spin_lock(&s_pump_lock)
+#define PUMP_UNLOCK() k_spin_unlock(&s_pump_lock, key)
+#else
+/* Host build: chains complete synchronously inside grlc_i2c_chain_submit() */
+#define PUMP_LOCK()
+#define PUMP_UNLOCK()
+#endif
+
+/* Cache: one bit per 7-bit address */
+static uint8_t s_present[16];
+static uint8_t s_known[16];
+static uint32_t s_generation;
+static bool s_read_probe;
+
+/* Sweep state; owned by the probe callbacks while s_running is set */
+static struct i2c_op s_op;
+static struct i2c_chain s_chain;
+static uint8_t s_rx;
+static uint8_t s_cur;
+static uint8_t s_last;
+static uint8_t s_flags;
+static volatile bool s_running;
+static volatile bool s_abort;
+static volatile int s_result;
+static bool s_in_pump;
+static bool s_again;
+
+static inline bool bit_get(const uint8_t *map, uint8_t a)
+{
+    return (map[a >> 3] >> (a & 7)) & 1u;
+}
+
+static inline void bit_put(uint8_t *map, uint8_t a, bool v)
+{
+    if (v)
+        map[a >> 3] |= (uint8_t)(1u << (a & 7));
+    else
+        map[a >> 3] &= (uint8_t)~(1u << (a & 7));
+}
+
+static void sweep_finish(int result)
+{
+    s_result = result;
+    s_generation++;
+    s_running = false;
+#ifdef __ZEPHYR__
+    k_sem_give(&s_done);
+#endif
+}
+
+static void probe_done(int result, void *user);
+
+/**
+ * @brief Queue the probe for the next address that needs one.
+ * @return true if a probe was submitted, false if the sweep ended.
+ */
+static bool probe_start(void)
+{
+    while (s_cur <= s_last && !(s_flags & GRLC_I2C_SCAN_FORCE) && bit_get(s_known, s_cur))
+        s_cur++;
+    if (s_abort || s_cur > s_last) {
+        sweep_finish(s_abort ? -ETIMEDOUT : 0);
+        return false;
+    }
+    if (s_read_probe)
+        s_op = (struct i2c_op)I2C_OP_RD(s_cur, &s_rx, 1);
+    else
+        s_op = (struct i2c_op)I2C_OP_PING(s_cur);
+    s_chain.ops = &s_op;
+    s_chain.count = 1;
+    s_chain.cb = probe_done;
+    s_chain.user = NULL;
+    int rc = grlc_i2c_chain_submit(&s_chain);
+    if (rc) {
+        sweep_finish(rc);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Advance the sweep.
+ *
+ * Completions that arrive while a probe is still being submitted (the
+ * synchronous fallback, or a very fast controller) only flag another round,
+ * so the sweep loops here instead of recursing once per address.
+ */
+static void probe_pump(void)
+{
+    {
+        PUMP_LOCK();
+        if (s_in_pump) {
+            s_again = true;
+            PUMP_UNLOCK();
+            return;
+        }
+        s_in_pump = true;
+        PUMP_UNLOCK();
+    }
+    for (;;) {
+        bool submitted = probe_start();
+        PUMP_LOCK();
+        if (!submitted || !s_again) {
+            s_again = false;
+            s_in_pump = false;
+            PUMP_UNLOCK();
+            return;
+        }
+        s_again = false;
+        PUMP_UNLOCK();
+    }
+}
+
+/** Probe completion; ISR context when the controller supports callbacks. */
+static void probe_done(int result, void *user)
+{
+    (void)user;
+    if (!s_read_probe && (result == -EINVAL || result == -ENOTSUP || result == -ENOSYS)) {
+        /* Controller refuses zero-length writes; retry this address with a read */
+        s_read_probe = true;
+        probe_pump();
+        return;
+    }
+    if (result == -EBUSY || result == -ETIMEDOUT) {
+        /* Bus stuck: give up rather than time out on every remaining address */
+        sweep_finish(result);
+        return;
+    }
+    bit_put(s_present, s_cur, result == 0);
+    bit_put(s_known, s_cur, true);
+    if (result == 0 && (s_flags & GRLC_I2C_SCAN_FIRST_ONLY)) {
+        sweep_finish(0);
+        return;
+    }
+    s_cur++;
+    probe_pump();
+}
+
+int grlc_i2c_scan(uint8_t first, uint8_t last, uint8_t flags, int timeout_ms)
+{
+    if (first < GRLC_I2C_SCAN_FIRST)
+        first = GRLC_I2C_SCAN_FIRST;
+    if (last > GRLC_I2C_SCAN_LAST)
+        last = GRLC_I2C_SCAN_LAST;
+    if (first > last)
+        return -EINVAL;
+    if (!(flags & GRLC_I2C_SCAN_FORCE)) {
+        uint8_t a = first;
+        while (a <= last && bit_get(s_known, a))
+            a++;
+        if (a > last)
+            return 0; /* whole range cached */
+    }
+    int rc = grlc_i2c_init();
+    if (rc)
+        return rc;
+    if (grlc_i2c_lock(timeout_ms) != 0)
+        return -ETIMEDOUT;
+    if (s_running) {
+        /* A timed-out sweep has not drained yet */
+        grlc_i2c_unlock();
+        return -EBUSY;
+    }
+#ifdef __ZEPHYR__
+    k_sem_reset(&s_done);
+#endif
+    s_cur = first;
+    s_last = last;
+    s_flags = flags;
+    s_abort = false;
+    s_result = 0;
+    s_running = true;
+    probe_pump();
+#ifdef __ZEPHYR__
+    k_timeout_t to = (timeout_ms < 0) ? K_FOREVER : K_MSEC(timeout_ms);
+    if (k_sem_take(&s_done, to) != 0) {
+        s_abort = true; /* stops at the next completion */
+        grlc_i2c_unlock();
+        return -ETIMEDOUT;
+    }
+#endif
+    rc = s_result;
+    grlc_i2c_unlock();
+    return rc;
+}
+
+size_t grlc_i2c_scan_list(uint8_t first, uint8_t last, uint8_t *out, size_t cap)
+{
+    size_t n = 0;
+    if (last > GRLC_I2C_SCAN_LAST)
+        last = GRLC_I2C_SCAN_LAST;
+    for (uint16_t a = first; a <= last; ++a) {
+        if (!bit_get(s_present, (uint8_t)a))
+            continue;
+        if (out && n < cap)
+            out[n] = (uint8_t)a;
+        n++;
+    }
+    return n;
+}
+
+bool grlc_i2c_scan_present(uint8_t addr7)
+{
+    return bit_get(s_present, addr7 & 0x7F);
+}
+
+void grlc_i2c_scan_info(struct i2c_scan_info *out)
+{
+    if (!out)
+        return;
+    out->generation = s_generation;
+    out->read_probe = s_read_probe;
+    memcpy(out->present, s_present, sizeof(out->present));
+    memcpy(out->known, s_known, sizeof(out->known));
+}
+
+void grlc_i2c_scan_invalidate(void)
+{
+    memset(s_known, 0, sizeof(s_known));
+    memset(s_present, 0, sizeof(s_present));
+}
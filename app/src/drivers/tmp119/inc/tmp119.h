@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -30,9 +31,17 @@ extern "C" {
 #define TMP119_REG_EE3         0x08
 #define TMP119_REG_DEVICE_ID   0x0F
 
-/* Default 7-bit I2C addresses depending on ADD0 (Table 7-2, p.23):
- * 0x48 (ADD0=GND), 0x49 (ADD0=V+), 0x4A (ADD0=SDA), 0x4B (ADD0=SCL)
+#ifdef __ZEPHYR__
+struct k_work_q;
+
+/**
+ * @brief Work queue for periodic sensor work (sampler, BLE broadcast).
+ *
+ * Sensor reads block on the I2C bus; running them here keeps them off the
+ * system workqueue, which also carries Bluetooth TX processing.
  */
+struct k_work_q *grlc_tmp119_workq(void);
+#endif
 
 /**
  * @brief Initialize TMP119 driver dependencies (I2C ready).
@@ -92,7 +101,9 @@ int grlc_tmp119_read_temperature_mC(uint8_t addr7, int32_t *mC_out);
 /**
  * @brief Read configuration register.
  *
- * Configuration bits documented in Section 8.5.3 (p.32–33).
+ * Configuration bits documented in Section 8.5.3 (p.32–33). Always read from
+ * the device so the status flags (bits 15–12) are live; note that the read
+ * clears HIGH_Alert/LOW_Alert (alert mode) and Data_Ready.
  *
  * @param addr7 7-bit I2C address.
  * @param cfg_out Pointer to store configuration register.
@@ -105,7 +116,8 @@ int grlc_tmp119_read_config(uint8_t addr7, uint16_t *cfg_out);
  *
  * @param addr7 7-bit I2C address.
  * @param cfg Configuration value to write.
- * @return 0 on success, negative errno on failure.
+ * @return 0 on success, -EBUSY while grlc_tmp119_oneshot_all() has a
+ *         conversion in flight on this sensor, negative errno on failure.
  */
 int grlc_tmp119_write_config(uint8_t addr7, uint16_t cfg);
 
@@ -172,10 +184,12 @@ int grlc_tmp119_read_eeprom(uint8_t addr7, uint8_t index, uint16_t *val_out);
 /**
  * @brief Write EEPROM register by index (1..3) after unlock.
  *
+ * The write, the ~7 ms programming wait and a read-back run as one I2C chain.
+ *
  * @param addr7 7-bit I2C address.
  * @param index EEPROM index (1..3).
  * @param val 16-bit value to write.
- * @return 0 on success, negative errno on failure.
+ * @return 0 on success, -EIO if the read-back differs, negative errno on failure.
  */
 int grlc_tmp119_write_eeprom(uint8_t addr7, uint8_t index, uint16_t val);
 
@@ -209,6 +223,116 @@ int grlc_tmp119_write_offset(uint8_t addr7, uint16_t val);
  */
 void grlc_tmp119_require_initialized(uint8_t addr7);
 
+/**
+ * @brief Check whether a TMP119 was verified at the given address.
+ *
+ * Does not touch the bus; reflects grlc_tmp119_boot_init() and earlier
+ * accesses. Lets background users skip absent sensors without tripping the
+ * fatal path of the register accessors.
+ *
+ * @param addr7 7-bit I2C address.
+ * @return true if the Device ID matched and defaults were applied.
+ */
+bool grlc_tmp119_is_present(uint8_t addr7);
+
+/**
+ * @brief Data-ready callback; runs in interrupt context on hardware.
+ *
+ * @param addr7 Sensor address.
+ * @param raw   Temperature register (LSB = 1/128 °C).
+ * @param user  Pointer passed to grlc_tmp119_drdy_enable().
+ */
+typedef void (*tmp119_drdy_cb_t)(uint8_t addr7, int16_t raw, void *user);
+
+/** @brief Data-ready statistics. */
+struct tmp119_drdy_status {
+    bool enabled;
+    uint8_t addr7;     /**< Sensor wired to the ALERT pin */
+    uint32_t reads;    /**< Conversions delivered */
+    uint32_t overruns; /**< Edges ignored because the previous read was in flight */
+    uint32_t errors;   /**< Failed reads */
+};
+
+/**
+ * @brief Read every conversion as it completes, driven by the ALERT pin.
+ *
+ * Sets DR/Alert in CONFIG so ALERT asserts when Data_Ready is set (Section
+ * 7.4.4) and arms an edge interrupt on the `tmp119-alert-gpios` pin of the
+ * devicetree `zephyr,user` node. Each edge queues one asynchronous
+ * temperature read; reading the result clears Data_Ready and releases the
+ * pin. Only one sensor can own the pin; enabling another replaces it.
+ *
+ * @param addr7 Sensor whose ALERT output is wired to the pin.
+ * @param cb    Called with each new reading (may be NULL).
+ * @param user  Opaque pointer returned to @p cb.
+ * @return 0 on success, -ENOTSUP if the board has no ALERT pin, negative
+ *         errno on I2C/GPIO failure.
+ */
+int grlc_tmp119_drdy_enable(uint8_t addr7, tmp119_drdy_cb_t cb, void *user);
+
+/** @brief Disarm the ALERT interrupt and restore ALERT to alert mode. */
+void grlc_tmp119_drdy_disable(void);
+
+/** @brief Report data-ready state and counters. */
+void grlc_tmp119_drdy_get(struct tmp119_drdy_status *st);
+
+/**
+ * @brief ALERT edge handler.
+ *
+ * Called from the GPIO interrupt; exposed so host tests can simulate edges.
+ */
+void grlc_tmp119_drdy_isr(void);
+
+/**
+ * @brief Re-read the shadowed registers from the device.
+ *
+ * Device ID, configuration, limits, offset and EEPROM1–3 are cached in RAM
+ * for addresses 0x48–0x4B when the sensor is initialized and updated on every
+ * successful write, so their read accessors do not touch the bus. Call this
+ * if the device may have changed behind the driver's back (external reset,
+ * another bus master).
+ *
+ * @param addr7 7-bit I2C address.
+ * @return 0 on success (or if @p addr7 is not shadowed), negative errno on failure.
+ */
+int grlc_tmp119_refresh(uint8_t addr7);
+
+/* 7-bit I2C addresses selectable by ADD0 (Table 7-2, p.23):
+ * 0x48 (ADD0=GND), 0x49 (ADD0=V+), 0x4A (ADD0=SDA), 0x4B (ADD0=SCL)
+ */
+#define TMP119_ADDR_FIRST 0x48u
+#define TMP119_ADDR_LAST 0x4Bu
+
+/** Sensors selectable by ADD0 (TMP119_ADDR_FIRST..TMP119_ADDR_LAST). */
+#define TMP119_MAX_DEVICES (TMP119_ADDR_LAST - TMP119_ADDR_FIRST + 1u)
+
+/** @brief One reading of a multi-sensor conversion. */
+struct tmp119_reading {
+    uint8_t addr7;
+    int16_t raw; /**< Temperature register, LSB = 1/128 °C */
+};
+
+/**
+ * @brief Convert on every verified sensor at once and read all results.
+ *
+ * Writes a one-shot (MOD=11, Section 7.4.3) configuration to each sensor
+ * back to back in one I2C chain, sleeps for the longest conversion time of
+ * their AVG settings (Table 7-6) with the bus free for other users, then
+ * reads the temperature registers of all sensors and writes the previous
+ * configuration back in a second chain. The TMP119 general call only
+ * implements reset, so the one-shot triggers are addressed; they start
+ * within a few hundred microseconds of each other. Blocks the caller for
+ * the conversion time (up to 1.1 s); other register accesses proceed
+ * meanwhile, except CONFIG writes to the converting sensors (-EBUSY).
+ *
+ * @param out      Readings in address order.
+ * @param cap      Capacity of @p out (TMP119_MAX_DEVICES covers every sensor).
+ * @param[out] conv_us Conversion wait used (may be NULL).
+ * @return Number of readings, -ENODEV if no sensor is verified, -EBUSY if
+ *         another one-shot is in flight, negative errno on I2C failure.
+ */
+int grlc_tmp119_oneshot_all(struct tmp119_reading *out, size_t cap, uint32_t *conv_us);
+
 #ifdef __cplusplus
 }
 #endif
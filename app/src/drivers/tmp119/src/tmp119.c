@@ -2,18 +2,45 @@
 #include <stdbool.h>
 #include <string.h>
 #ifdef __ZEPHYR__
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(tmp119, CONFIG_LOG_DEFAULT_LEVEL);
+/* Shadow users: UART and BLE command threads, sampler work. Recursive, and
+ * held across the bus access so a write and its shadow update stay together.
+ */
+static K_MUTEX_DEFINE(s_shadow_lock);
+#define SHADOW_LOCK() k_mutex_lock(&s_shadow_lock, K_FOREVER)
+#define SHADOW_UNLOCK() k_mutex_unlock(&s_shadow_lock)
 #else
 #define LOG_DBG(...)
 #define LOG_INF(...)
 #define LOG_WRN(...)
 #define LOG_ERR(...)
+#define SHADOW_LOCK()
+#define SHADOW_UNLOCK()
+/* Host builds are single-threaded: plain ints stand in for the kernel atomics */
+typedef int atomic_t;
+#define atomic_get(p) (*(p))
+static inline int atomic_set(atomic_t *p, int v)
+{
+    int old = *p;
+    *p = v;
+    return old;
+}
+static inline bool atomic_cas(atomic_t *p, int old, int v)
+{
+    if (*p != old)
+        return false;
+    *p = v;
+    return true;
+}
 #endif
 
 #include <stdio.h>
 #include "drivers/i2c/inc/i2c.h"
+#include "drivers/i2c/inc/i2c_scan.h"
 #include "drivers/tmp119/inc/tmp119.h"
 #include "utils/assert/inc/project_assert.h"
 
@@ -31,8 +58,33 @@ static inline int addr7_to_zephyr(uint8_t addr7)
  */
 #define TMP119_CONFIG_DEFAULT 0x0000u
 
+/* EEPROM programming time (Section 8.5.2, ~7 ms) */
+#define TMP119_EE_PROGRAM_US 7000u
+
 static bool s_verified[128];
 
+/* Configuration status flags (HIGH_Alert, LOW_Alert, Data_Ready, EEPROM_Busy; 8.5.3) */
+#define TMP119_CFG_STATUS_MASK 0xF000u
+/* Soft reset reloads every register from EEPROM */
+#define TMP119_CFG_SOFT_RESET 0x0002u
+
+/* RAM copy of the registers that only change when we write them. One slot per
+ * ADD0-selectable address; other addresses always go to the bus.
+ */
+
+struct tmp119_shadow {
+    bool valid;
+    bool oneshot; /* one-shot in flight: CONFIG is owned by grlc_tmp119_oneshot_all() */
+    uint16_t device_id;
+    uint16_t config; /* writable fields only; status flags live on the bus */
+    uint16_t high_limit;
+    uint16_t low_limit;
+    uint16_t offset;
+    uint16_t ee[3];
+};
+
+static struct tmp119_shadow s_shadow[TMP119_MAX_DEVICES];
+
 static int reg_read16(uint8_t addr7, uint8_t reg, uint16_t *out)
 {
     uint8_t rx[2] = {0};
@@ -53,6 +105,136 @@ static int reg_write16(uint8_t addr7, uint8_t reg, uint16_t val)
     return grlc_i2c_blocking_write(addr7_to_zephyr(addr7), tx, sizeof(tx), 100);
 }
 
+static struct tmp119_shadow *shadow_of(uint8_t addr7)
+{
+    uint8_t a = addr7 & 0x7F;
+    if (a < TMP119_ADDR_FIRST || a > TMP119_ADDR_LAST)
+        return NULL;
+    return &s_shadow[a - TMP119_ADDR_FIRST];
+}
+
+static uint16_t *shadow_field(struct tmp119_shadow *sh, uint8_t reg)
+{
+    switch (reg) {
+        case TMP119_REG_DEVICE_ID:
+            return &sh->device_id;
+        case TMP119_REG_CONFIG:
+            return &sh->config;
+        case TMP119_REG_HIGH_LIMIT:
+            return &sh->high_limit;
+        case TMP119_REG_LOW_LIMIT:
+            return &sh->low_limit;
+        case TMP119_REG_TEMP_OFFSET:
+            return &sh->offset;
+        case TMP119_REG_EE1:
+            return &sh->ee[0];
+        case TMP119_REG_EE2:
+            return &sh->ee[1];
+        case TMP119_REG_EE3:
+            return &sh->ee[2];
+        default:
+            return NULL;
+    }
+}
+
+/** @brief Read every shadowed register in one I2C chain. Caller holds SHADOW_LOCK. */
+static int shadow_load(uint8_t addr7, struct tmp119_shadow *sh)
+{
+    static const uint8_t regs[] = {
+        TMP119_REG_DEVICE_ID, TMP119_REG_CONFIG, TMP119_REG_HIGH_LIMIT, TMP119_REG_LOW_LIMIT,
+        TMP119_REG_TEMP_OFFSET, TMP119_REG_EE1, TMP119_REG_EE2, TMP119_REG_EE3,
+    };
+    uint8_t rx[sizeof(regs)][2];
+    struct i2c_op ops[sizeof(regs)];
+    int a = addr7_to_zephyr(addr7);
+    for (size_t i = 0; i < sizeof(regs); ++i) {
+        ops[i] = (struct i2c_op)I2C_OP_WR_RD(a, &regs[i], 1, rx[i], 2);
+    }
+    sh->valid = false;
+    int rc = grlc_i2c_chain_run(ops, sizeof(regs), 100);
+    if (rc)
+        return rc;
+    for (size_t i = 0; i < sizeof(regs); ++i) {
+        *shadow_field(sh, regs[i]) = ((uint16_t)rx[i][0] << 8) | rx[i][1];
+    }
+    sh->config &= (uint16_t)~TMP119_CFG_STATUS_MASK;
+    sh->valid = true;
+    return 0;
+}
+
+/** @brief Serve a non-volatile register from RAM, loading the shadow if needed. */
+static int shadow_read(uint8_t addr7, uint8_t reg, uint16_t *out)
+{
+    struct tmp119_shadow *sh = shadow_of(addr7);
+    SHADOW_LOCK();
+    if (sh && (sh->valid || shadow_load(addr7, sh) == 0)) {
+        *out = *shadow_field(sh, reg);
+        SHADOW_UNLOCK();
+        return 0;
+    }
+    int rc = reg_read16(addr7, reg, out);
+    SHADOW_UNLOCK();
+    if (rc == 0 && reg == TMP119_REG_CONFIG)
+        *out &= (uint16_t)~TMP119_CFG_STATUS_MASK;
+    return rc;
+}
+
+/** @brief Update the shadow after a successful write. Caller holds SHADOW_LOCK. */
+static void shadow_store(uint8_t addr7, uint8_t reg, uint16_t val)
+{
+    struct tmp119_shadow *sh = shadow_of(addr7);
+    if (!sh || !sh->valid)
+        return;
+    if (reg == TMP119_REG_CONFIG) {
+        if (val & TMP119_CFG_SOFT_RESET) {
+            sh->valid = false; /* registers reload from EEPROM */
+            return;
+        }
+        val &= (uint16_t)~TMP119_CFG_STATUS_MASK;
+    }
+    *shadow_field(sh, reg) = val;
+}
+
+static int shadow_write(uint8_t addr7, uint8_t reg, uint16_t val)
+{
+    struct tmp119_shadow *sh = shadow_of(addr7);
+    SHADOW_LOCK();
+    int rc = -EBUSY;
+    if (reg != TMP119_REG_CONFIG || !sh || !sh->oneshot) {
+        rc = reg_write16(addr7, reg, val);
+        if (rc == 0)
+            shadow_store(addr7, reg, val);
+    }
+    SHADOW_UNLOCK();
+    return rc;
+}
+
+#ifdef __ZEPHYR__
+#ifndef GRLC_TMP119_WORKQ_PRIO
+#define GRLC_TMP119_WORKQ_PRIO K_PRIO_PREEMPT(9)
+#endif
+#ifndef GRLC_TMP119_WORKQ_STACK_SIZE
+#define GRLC_TMP119_WORKQ_STACK_SIZE 1536
+#endif
+
+static K_THREAD_STACK_DEFINE(s_workq_stack, GRLC_TMP119_WORKQ_STACK_SIZE);
+static struct k_work_q s_workq;
+
+static int tmp119_workq_start(void)
+{
+    const struct k_work_queue_config cfg = {.name = "tmp119_wq"};
+    k_work_queue_start(&s_workq, s_workq_stack, K_THREAD_STACK_SIZEOF(s_workq_stack),
+                       GRLC_TMP119_WORKQ_PRIO, &cfg);
+    return 0;
+}
+SYS_INIT(tmp119_workq_start, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+struct k_work_q *grlc_tmp119_workq(void)
+{
+    return &s_workq;
+}
+#endif
+
 int grlc_tmp119_init(void)
 {
     return grlc_i2c_init();
@@ -72,6 +254,12 @@ static int tmp119_try_init_addr(uint8_t addr7)
     if (rc)
         return rc;
     s_verified[addr7 & 0x7F] = true;
+    struct tmp119_shadow *sh = shadow_of(addr7);
+    if (sh) {
+        SHADOW_LOCK();
+        (void)shadow_load(addr7, sh);
+        SHADOW_UNLOCK();
+    }
     LOG_INF("TMP119 @0x%02x initialized (ID=0x%04x)", addr7, id);
     return 0;
 }
@@ -82,14 +270,15 @@ int grlc_tmp119_boot_init(void)
     if (rc)
         return rc;
     int count = 0;
-    for (uint8_t a = 0x48; a <= 0x4B; ++a) {
+    /* One interrupt-driven sweep of the ADD0 range instead of a ping per address */
+    (void)grlc_i2c_scan(TMP119_ADDR_FIRST, TMP119_ADDR_LAST, GRLC_I2C_SCAN_FORCE, 100);
+    for (uint8_t a = TMP119_ADDR_FIRST; a <= TMP119_ADDR_LAST; ++a) {
         /* If address already verified, skip */
         if (s_verified[a]) {
             count++;
             continue;
         }
-        /* Ping first to avoid delays */
-        if (grlc_i2c_ping(a) != 0) {
+        if (!grlc_i2c_scan_present(a)) {
             continue;
         }
         if (tmp119_try_init_addr(a) == 0) {
@@ -119,7 +308,7 @@ int grlc_tmp119_read_device_id(uint8_t addr7, uint16_t *id_out)
     if (!id_out)
         return -EINVAL;
     ensure_initialized(addr7);
-    return reg_read16(addr7, TMP119_REG_DEVICE_ID, id_out);
+    return shadow_read(addr7, TMP119_REG_DEVICE_ID, id_out);
 }
 
 int grlc_tmp119_read_temperature_raw(uint8_t addr7, uint16_t *raw_out)
@@ -151,13 +340,20 @@ int grlc_tmp119_read_config(uint8_t addr7, uint16_t *cfg_out)
     if (!cfg_out)
         return -EINVAL;
     ensure_initialized(addr7);
-    return reg_read16(addr7, TMP119_REG_CONFIG, cfg_out);
+    /* The status flags are volatile (and clear on read): always go to the bus */
+    SHADOW_LOCK();
+    int rc = reg_read16(addr7, TMP119_REG_CONFIG, cfg_out);
+    struct tmp119_shadow *sh = shadow_of(addr7);
+    if (rc == 0 && sh && sh->valid && !sh->oneshot)
+        sh->config = *cfg_out & (uint16_t)~TMP119_CFG_STATUS_MASK;
+    SHADOW_UNLOCK();
+    return rc;
 }
 
 int grlc_tmp119_write_config(uint8_t addr7, uint16_t cfg)
 {
     ensure_initialized(addr7);
-    return reg_write16(addr7, TMP119_REG_CONFIG, cfg);
+    return shadow_write(addr7, TMP119_REG_CONFIG, cfg);
 }
 
 int grlc_tmp119_read_high_limit(uint8_t addr7, uint16_t *val_out)
@@ -165,13 +361,13 @@ int grlc_tmp119_read_high_limit(uint8_t addr7, uint16_t *val_out)
     if (!val_out)
         return -EINVAL;
     ensure_initialized(addr7);
-    return reg_read16(addr7, TMP119_REG_HIGH_LIMIT, val_out);
+    return shadow_read(addr7, TMP119_REG_HIGH_LIMIT, val_out);
 }
 
 int grlc_tmp119_write_high_limit(uint8_t addr7, uint16_t val)
 {
     ensure_initialized(addr7);
-    return reg_write16(addr7, TMP119_REG_HIGH_LIMIT, val);
+    return shadow_write(addr7, TMP119_REG_HIGH_LIMIT, val);
 }
 
 int grlc_tmp119_read_low_limit(uint8_t addr7, uint16_t *val_out)
@@ -179,13 +375,13 @@ int grlc_tmp119_read_low_limit(uint8_t addr7, uint16_t *val_out)
     if (!val_out)
         return -EINVAL;
     ensure_initialized(addr7);
-    return reg_read16(addr7, TMP119_REG_LOW_LIMIT, val_out);
+    return shadow_read(addr7, TMP119_REG_LOW_LIMIT, val_out);
 }
 
 int grlc_tmp119_write_low_limit(uint8_t addr7, uint16_t val)
 {
     ensure_initialized(addr7);
-    return reg_write16(addr7, TMP119_REG_LOW_LIMIT, val);
+    return shadow_write(addr7, TMP119_REG_LOW_LIMIT, val);
 }
 
 int grlc_tmp119_unlock_eeprom(uint8_t addr7)
@@ -216,7 +412,7 @@ int grlc_tmp119_read_eeprom(uint8_t addr7, uint8_t index, uint16_t *val_out)
     if (reg == 0xFF)
         return -EINVAL;
     ensure_initialized(addr7);
-    return reg_read16(addr7, reg, val_out);
+    return shadow_read(addr7, reg, val_out);
 }
 
 int grlc_tmp119_write_eeprom(uint8_t addr7, uint8_t index, uint16_t val)
@@ -225,7 +421,25 @@ int grlc_tmp119_write_eeprom(uint8_t addr7, uint8_t index, uint16_t val)
     if (reg == 0xFF)
         return -EINVAL;
     ensure_initialized(addr7);
-    return reg_write16(addr7, reg, val);
+    /* Program, wait out EEPROM_Busy and read back in one queued chain */
+    uint8_t tx[3] = {reg, (uint8_t)(val >> 8), (uint8_t)(val & 0xFF)};
+    uint8_t rx[2] = {0};
+    int a = addr7_to_zephyr(addr7);
+    const struct i2c_op ops[] = {
+        I2C_OP_WR(a, tx, sizeof(tx)),
+        I2C_OP_WAIT_US(TMP119_EE_PROGRAM_US),
+        I2C_OP_WR_RD(a, &tx[0], 1, rx, sizeof(rx)),
+    };
+    SHADOW_LOCK();
+    int rc = grlc_i2c_chain_run(ops, sizeof(ops) / sizeof(ops[0]), 100);
+    if (rc == 0) {
+        uint16_t got = ((uint16_t)rx[0] << 8) | rx[1];
+        rc = (got == val) ? 0 : -EIO;
+    }
+    if (rc == 0)
+        shadow_store(addr7, reg, val);
+    SHADOW_UNLOCK();
+    return rc;
 }
 
 int grlc_tmp119_read_offset(uint8_t addr7, uint16_t *val_out)
@@ -233,16 +447,323 @@ int grlc_tmp119_read_offset(uint8_t addr7, uint16_t *val_out)
     if (!val_out)
         return -EINVAL;
     ensure_initialized(addr7);
-    return reg_read16(addr7, TMP119_REG_TEMP_OFFSET, val_out);
+    return shadow_read(addr7, TMP119_REG_TEMP_OFFSET, val_out);
 }
 
 int grlc_tmp119_write_offset(uint8_t addr7, uint16_t val)
 {
     ensure_initialized(addr7);
-    return reg_write16(addr7, TMP119_REG_TEMP_OFFSET, val);
+    return shadow_write(addr7, TMP119_REG_TEMP_OFFSET, val);
 }
 
 void grlc_tmp119_require_initialized(uint8_t addr7)
 {
     ensure_initialized(addr7);
 }
+
+bool grlc_tmp119_is_present(uint8_t addr7)
+{
+    return s_verified[addr7 & 0x7F];
+}
+
+int grlc_tmp119_refresh(uint8_t addr7)
+{
+    ensure_initialized(addr7);
+    struct tmp119_shadow *sh = shadow_of(addr7);
+    if (!sh)
+        return 0;
+    SHADOW_LOCK();
+    int rc = shadow_load(addr7, sh);
+    SHADOW_UNLOCK();
+    return rc;
+}
+
+/* ---- ALERT pin in data-ready mode (Section 7.4.4) ---- */
+
+/* DR/Alert select: 1 = ALERT pin reflects Data_Ready */
+#define TMP119_CFG_DR_ALERT 0x0004u
+
+/* Longest a queued data-ready read can take to complete (one 100 ms I2C timeout) */
+#define TMP119_DRDY_IDLE_MS 100
+
+static struct {
+    atomic_t enabled;
+    atomic_t busy; /* temperature read queued or running; chain/op are in use */
+    uint8_t addr7;
+    tmp119_drdy_cb_t cb;
+    void *user;
+    uint8_t reg;
+    uint8_t rx[2];
+    struct i2c_op op;
+    struct i2c_chain chain;
+    uint32_t reads;
+    uint32_t overruns;
+    uint32_t errors;
+} s_drdy;
+
+#ifdef __ZEPHYR__
+#if DT_NODE_HAS_PROP(DT_PATH(zephyr_user), tmp119_alert_gpios)
+#define TMP119_HAS_ALERT_GPIO 1
+#endif
+#endif
+
+#ifdef TMP119_HAS_ALERT_GPIO
+static const struct gpio_dt_spec s_alert =
+    GPIO_DT_SPEC_GET(DT_PATH(zephyr_user), tmp119_alert_gpios);
+static struct gpio_callback s_alert_cb;
+static bool s_alert_cb_added;
+
+static void alert_isr(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins)
+{
+    ARG_UNUSED(port);
+    ARG_UNUSED(cb);
+    ARG_UNUSED(pins);
+    grlc_tmp119_drdy_isr();
+}
+#endif
+
+/** Completion of the data-ready read; ISR context on hardware. */
+static void drdy_read_done(int result, void *user)
+{
+    (void)user;
+    if (result) {
+        s_drdy.errors++;
+    } else {
+        s_drdy.reads++;
+        uint16_t raw = ((uint16_t)s_drdy.rx[0] << 8) | s_drdy.rx[1];
+        if (atomic_get(&s_drdy.enabled) && s_drdy.cb) {
+            s_drdy.cb(s_drdy.addr7, (int16_t)raw, s_drdy.user);
+        }
+    }
+    /* Last: once clear, disable/enable may reuse the chain and the callback */
+    atomic_set(&s_drdy.busy, 0);
+}
+
+void grlc_tmp119_drdy_isr(void)
+{
+    if (!atomic_get(&s_drdy.enabled)) {
+        return;
+    }
+    if (!atomic_cas(&s_drdy.busy, 0, 1)) {
+        /* Previous conversion still being read: the bus cannot keep up */
+        s_drdy.overruns++;
+        return;
+    }
+    s_drdy.chain.ops = &s_drdy.op;
+    s_drdy.chain.count = 1;
+    s_drdy.chain.cb = drdy_read_done;
+    s_drdy.chain.user = NULL;
+    if (grlc_i2c_chain_submit(&s_drdy.chain) != 0) {
+        s_drdy.errors++;
+        atomic_set(&s_drdy.busy, 0);
+    }
+}
+
+/** @brief Wait for a queued or running data-ready read to complete. */
+static bool drdy_wait_idle(void)
+{
+#ifdef __ZEPHYR__
+    for (int ms = 0; atomic_get(&s_drdy.busy) && ms < TMP119_DRDY_IDLE_MS; ++ms) {
+        k_msleep(1);
+    }
+#endif
+    return !atomic_get(&s_drdy.busy);
+}
+
+/** @brief Set or clear DR/Alert in CONFIG, preserving the other fields. */
+static int drdy_config(uint8_t addr7, bool on)
+{
+    uint16_t cfg = 0;
+    SHADOW_LOCK();
+    int rc = shadow_read(addr7, TMP119_REG_CONFIG, &cfg);
+    if (rc == 0) {
+        cfg = on ? (cfg | TMP119_CFG_DR_ALERT) : (cfg & (uint16_t)~TMP119_CFG_DR_ALERT);
+        rc = shadow_write(addr7, TMP119_REG_CONFIG, cfg);
+    }
+    SHADOW_UNLOCK();
+    return rc;
+}
+
+int grlc_tmp119_drdy_enable(uint8_t addr7, tmp119_drdy_cb_t cb, void *user)
+{
+#if defined(__ZEPHYR__) && !defined(TMP119_HAS_ALERT_GPIO)
+    ARG_UNUSED(addr7);
+    ARG_UNUSED(cb);
+    ARG_UNUSED(user);
+    return -ENOTSUP;
+#else
+    ensure_initialized(addr7);
+    grlc_tmp119_drdy_disable();
+    if (!drdy_wait_idle()) {
+        /* The previous read still owns the chain; it must not be rewritten */
+        return -EBUSY;
+    }
+    int rc = drdy_config(addr7, true);
+    if (rc)
+        return rc;
+    s_drdy.addr7 = addr7 & 0x7F;
+    s_drdy.cb = cb;
+    s_drdy.user = user;
+    s_drdy.reg = TMP119_REG_TEMPERATURE;
+    s_drdy.op = (struct i2c_op)I2C_OP_WR_RD(addr7_to_zephyr(addr7), &s_drdy.reg, 1, s_drdy.rx, 2);
+    atomic_set(&s_drdy.enabled, 1);
+#ifdef TMP119_HAS_ALERT_GPIO
+    if (!gpio_is_ready_dt(&s_alert)) {
+        atomic_set(&s_drdy.enabled, 0);
+        return -ENODEV;
+    }
+    rc = gpio_pin_configure_dt(&s_alert, GPIO_INPUT);
+    if (rc == 0 && !s_alert_cb_added) {
+        gpio_init_callback(&s_alert_cb, alert_isr, BIT(s_alert.pin));
+        rc = gpio_add_callback(s_alert.port, &s_alert_cb);
+        s_alert_cb_added = (rc == 0);
+    }
+    if (rc == 0) {
+        rc = gpio_pin_interrupt_configure_dt(&s_alert, GPIO_INT_EDGE_TO_ACTIVE);
+    }
+    if (rc) {
+        atomic_set(&s_drdy.enabled, 0);
+        (void)drdy_config(addr7, false);
+        return rc;
+    }
+    /* A conversion may have completed before the edge was armed */
+    if (gpio_pin_get_dt(&s_alert) > 0) {
+        grlc_tmp119_drdy_isr();
+    }
+#endif
+    LOG_INF("TMP119 @0x%02x data-ready interrupt enabled", addr7);
+    return 0;
+#endif
+}
+
+void grlc_tmp119_drdy_disable(void)
+{
+    if (!atomic_get(&s_drdy.enabled)) {
+        return;
+    }
+#ifdef TMP119_HAS_ALERT_GPIO
+    (void)gpio_pin_interrupt_configure_dt(&s_alert, GPIO_INT_DISABLE);
+#endif
+    atomic_set(&s_drdy.enabled, 0);
+    /* Let an in-flight read finish so its callback cannot fire after we return */
+    if (!drdy_wait_idle()) {
+        LOG_WRN("TMP119 data-ready read still pending");
+    }
+    (void)drdy_config(s_drdy.addr7, false);
+}
+
+void grlc_tmp119_drdy_get(struct tmp119_drdy_status *st)
+{
+    if (!st) {
+        return;
+    }
+    st->enabled = atomic_get(&s_drdy.enabled) != 0;
+    st->addr7 = s_drdy.addr7;
+    st->reads = s_drdy.reads;
+    st->overruns = s_drdy.overruns;
+    st->errors = s_drdy.errors;
+}
+
+/* ---- Synchronized one-shot conversion (Section 7.4.3) ---- */
+
+#define TMP119_CFG_MOD_MASK 0x0C00u
+#define TMP119_CFG_MOD_ONESHOT 0x0C00u
+#define TMP119_CFG_AVG_SHIFT 5u
+
+/* One-shot conversion time per AVG[1:0] (Table 7-6) plus 10% for oscillator tolerance */
+static const uint32_t s_conv_us[4] = {17050u, 137500u, 550000u, 1100000u};
+
+/** @brief Conversion wait between the trigger and read chains, off the I2C queue. */
+static void oneshot_wait(uint32_t wait_us)
+{
+#ifdef __ZEPHYR__
+    k_usleep((int32_t)wait_us);
+#else
+    (void)wait_us;
+#endif
+}
+
+int grlc_tmp119_oneshot_all(struct tmp119_reading *out, size_t cap, uint32_t *conv_us)
+{
+    uint8_t addrs[TMP119_MAX_DEVICES];
+    uint8_t cfg_tx[TMP119_MAX_DEVICES][3];
+    uint8_t restore_tx[TMP119_MAX_DEVICES][3];
+    uint8_t rx[TMP119_MAX_DEVICES][2];
+    static const uint8_t temp_reg = TMP119_REG_TEMPERATURE;
+    struct i2c_op ops[2 * TMP119_MAX_DEVICES];
+    size_t n = 0;
+    uint32_t wait_us = 0;
+
+    SHADOW_LOCK();
+    for (uint8_t a = TMP119_ADDR_FIRST; a <= TMP119_ADDR_LAST; ++a) {
+        if (!s_verified[a] || n >= cap) {
+            continue;
+        }
+        if (shadow_of(a)->oneshot) {
+            SHADOW_UNLOCK();
+            return -EBUSY;
+        }
+        uint16_t cfg = 0;
+        int rc = shadow_read(a, TMP119_REG_CONFIG, &cfg);
+        if (rc) {
+            SHADOW_UNLOCK();
+            return rc;
+        }
+        uint16_t os = (uint16_t)((cfg & ~TMP119_CFG_MOD_MASK) | TMP119_CFG_MOD_ONESHOT);
+        cfg_tx[n][0] = TMP119_REG_CONFIG;
+        cfg_tx[n][1] = (uint8_t)(os >> 8);
+        cfg_tx[n][2] = (uint8_t)(os & 0xFF);
+        restore_tx[n][0] = TMP119_REG_CONFIG;
+        restore_tx[n][1] = (uint8_t)(cfg >> 8);
+        restore_tx[n][2] = (uint8_t)(cfg & 0xFF);
+        uint32_t t = s_conv_us[(cfg >> TMP119_CFG_AVG_SHIFT) & 0x3u];
+        if (t > wait_us)
+            wait_us = t;
+        addrs[n++] = a;
+    }
+    if (n == 0) {
+        SHADOW_UNLOCK();
+        return -ENODEV;
+    }
+
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i)
+        ops[k++] = (struct i2c_op)I2C_OP_WR(addr7_to_zephyr(addrs[i]), cfg_tx[i], 3);
+    int rc = grlc_i2c_chain_run(ops, k, 100);
+    if (rc == 0) {
+        /* CONFIG writes to these sensors get -EBUSY until the restore below */
+        for (size_t i = 0; i < n; ++i)
+            shadow_of(addrs[i])->oneshot = true;
+        SHADOW_UNLOCK();
+        /* Up to 1.1 s at AVG=11: sleep with neither the bus queue nor the shadow held */
+        oneshot_wait(wait_us);
+        SHADOW_LOCK();
+        k = 0;
+        for (size_t i = 0; i < n; ++i)
+            ops[k++] = (struct i2c_op)I2C_OP_WR_RD(addr7_to_zephyr(addrs[i]), &temp_reg, 1, rx[i], 2);
+        for (size_t i = 0; i < n; ++i)
+            ops[k++] = (struct i2c_op)I2C_OP_WR(addr7_to_zephyr(addrs[i]), restore_tx[i], 3);
+        rc = grlc_i2c_chain_run(ops, k, 100);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        struct tmp119_shadow *sh = shadow_of(addrs[i]);
+        sh->oneshot = false;
+        if (rc) {
+            /* A chain may have stopped with sensors left in one-shot/shutdown */
+            sh->valid = false;
+        } else if (sh->valid) {
+            /* A refresh meanwhile may have captured MOD=11 */
+            sh->config = (uint16_t)((restore_tx[i][1] << 8) | restore_tx[i][2]);
+        }
+    }
+    SHADOW_UNLOCK();
+    if (rc)
+        return rc;
+    for (size_t i = 0; i < n; ++i) {
+        out[i].addr7 = addrs[i];
+        out[i].raw = (int16_t)(((uint16_t)rx[i][0] << 8) | rx[i][1]);
+    }
+    if (conv_us)
+        *conv_us = wait_us;
+    return (int)n;
+}
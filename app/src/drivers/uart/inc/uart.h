@@ -14,7 +14,12 @@
  */
 #define UART_DMA_TX_BUFFER_SIZE 2048
 #define UART_DMA_RX_BUFFER_SIZE 1024
-#define UART_DMA_RX_CHUNK_SIZE  64 /* DMA transfer chunk size */
+#ifndef UART_DMA_RX_CHUNK_SIZE
+#define UART_DMA_RX_CHUNK_SIZE 256 /* DMA transfer chunk size */
+#endif
+#ifndef UART_DMA_RX_CHUNK_COUNT
+#define UART_DMA_RX_CHUNK_COUNT 4 /* chunks in the RX pool, handed out round-robin */
+#endif
 
 /**
  * @brief Runtime UART statistics for monitoring.
@@ -26,8 +31,42 @@ struct uart_statistics {
     uint32_t rx_overruns;
     uint32_t framing_errors;
     uint32_t parity_errors;
+    uint32_t link_rollbacks; /* link switches reverted for lack of a valid frame */
+    /* ISR event counts */
+    uint32_t isr_rx_rdy;       /* RX_RDY events (chunk full or inactivity timeout) */
+    uint32_t isr_rx_buf_req;   /* RX_BUF_REQUEST events (one per chunk handed to DMA) */
+    uint32_t isr_rx_restarts;  /* RX re-enabled after DISABLED/STOPPED */
+    uint32_t isr_tx_done;      /* TX_DONE/TX_ABORTED events */
+    uint32_t rx_timeout_us;    /* current RX inactivity timeout (not reset) */
 };
 
+/**
+ * @brief Serial link parameters that can be negotiated at runtime.
+ */
+struct uart_link_cfg {
+    uint32_t baudrate; /* bits per second (see grlc_uart_link_baud_supported) */
+    bool flow_ctrl;    /* true enables RTS/CTS hardware flow control */
+};
+
+/**
+ * @brief Runtime link negotiation state.
+ *
+ * A switch is requested (PENDING), applied once all queued TX has left the
+ * wire (PROBATION), and committed when a valid frame arrives at the new
+ * settings. If none arrives before the confirm deadline the previous
+ * settings are restored.
+ */
+enum uart_link_state {
+    UART_LINK_STATE_IDLE = 0,
+    UART_LINK_STATE_PENDING = 1,
+    UART_LINK_STATE_PROBATION = 2,
+};
+
+/** Default confirm window when a request passes 0. */
+#define UART_LINK_CONFIRM_MS_DEFAULT 1000u
+/** Upper bound for the confirm window. */
+#define UART_LINK_CONFIRM_MS_MAX 10000u
+
 /**
  * @brief UART driver status/result codes.
  */
@@ -73,6 +112,28 @@ size_t grlc_uart_rx_available(void);
  */
 size_t grlc_uart_read(uint8_t *data, size_t max_len);
 
+/**
+ * @brief Consumer for grlc_uart_rx_consume().
+ * @param data Contiguous span inside the RX ring (valid only during the call).
+ * @param len  Span length in bytes.
+ * @param user Opaque pointer passed to grlc_uart_rx_consume().
+ * @return Bytes consumed (<= len); returning less than len ends the pass.
+ */
+typedef size_t (*uart_rx_consume_fn)(const uint8_t *data, size_t len, void *user);
+
+/**
+ * @brief Hand the bytes currently in the RX ring to @p fn without copying.
+ *
+ * Takes the RX lock once and passes at most two contiguous spans (before and
+ * after the ring wrap). Bytes arriving during the pass are left for the next
+ * call, so the work per call is bounded.
+ *
+ * @param fn   Consumer invoked per span.
+ * @param user Opaque pointer forwarded to @p fn.
+ * @return Total bytes consumed.
+ */
+size_t grlc_uart_rx_consume(uart_rx_consume_fn fn, void *user);
+
 /**
  * @brief Read one byte from the RX ring.
  * @param byte Out parameter for the received byte.
@@ -92,6 +153,27 @@ size_t grlc_uart_tx_free_space(void);
  */
 bool grlc_uart_tx_complete(void);
 
+/** @brief Notify bit: bytes were added to the RX ring. */
+#define UART_NOTIFY_RX 0x01u
+/** @brief Notify bit: a DMA TX finished (ring space freed, next chunk can start). */
+#define UART_NOTIFY_TX 0x02u
+
+/**
+ * @brief Event hook invoked from the UART ISR.
+ * @param events Bitmask of UART_NOTIFY_* flags.
+ */
+typedef void (*uart_notify_cb_t)(uint32_t events);
+
+/**
+ * @brief Install a hook that is called from ISR context on RX data and TX completion.
+ *
+ * Lets the runtime sleep on a kernel object instead of polling. The hook must be
+ * ISR-safe (e.g. k_event_post / k_sem_give). Pass NULL to remove.
+ *
+ * @param cb Hook to install.
+ */
+void grlc_uart_set_notify(uart_notify_cb_t cb);
+
 /**
  * @brief Copy current statistics.
  * @param stats Pointer to structure to receive counters.
@@ -113,4 +195,45 @@ void grlc_uart_clear_tx_buffer(void);
  */
 void grlc_uart_process(void);
 
+/**
+ * @brief Check whether a baud rate is supported by the UARTE peripheral.
+ * @param baudrate Requested rate in bits per second.
+ * @return true if the rate can be programmed.
+ */
+bool grlc_uart_link_baud_supported(uint32_t baudrate);
+
+/**
+ * @brief Request a link switch to new baud rate / flow control settings.
+ *
+ * The switch is deferred until the TX ring and DMA are idle so that the
+ * acknowledgement of the request still goes out at the current settings.
+ * Drive the switch with grlc_uart_link_service().
+ *
+ * @param cfg        New link settings.
+ * @param confirm_ms Window for a valid frame at the new settings before
+ *                   rolling back (0 selects UART_LINK_CONFIRM_MS_DEFAULT).
+ * @return OK if accepted, BUSY if a switch is already in progress, ERROR on
+ *         invalid settings.
+ */
+enum uart_dma_status grlc_uart_link_request(const struct uart_link_cfg *cfg, uint32_t confirm_ms);
+
+/**
+ * @brief Advance the link negotiation state machine.
+ *
+ * Call from the UART runtime after feeding RX into the transport.
+ *
+ * @param now_ms   Current uptime in milliseconds.
+ * @param frame_ok true if at least one valid frame was received since the
+ *                 previous call.
+ * @return State after servicing.
+ */
+enum uart_link_state grlc_uart_link_service(uint32_t now_ms, bool frame_ok);
+
+/**
+ * @brief Report the active link settings and negotiation state.
+ * @param cfg   Out: settings currently programmed (may be NULL).
+ * @param state Out: negotiation state (may be NULL).
+ */
+void grlc_uart_link_get(struct uart_link_cfg *cfg, enum uart_link_state *state);
+
 #endif /* UART_H */
@@ -43,6 +43,15 @@ struct uart_event {
     } data;
 };
 
+/* Mirrors the driver-side shim of Zephyr's struct uart_config */
+struct uart_config {
+    unsigned int baudrate;
+    unsigned char parity;
+    unsigned char stop_bits;
+    unsigned char data_bits;
+    unsigned char flow_ctrl;
+};
+
 /* Test helpers from driver (available when compiled with UART_DMA_TESTING) */
 void uart_dma_test_reset(void);
 void uart_dma_test_invoke_event(struct uart_event *evt);
@@ -50,11 +59,13 @@ void uart_dma_test_set_hal_rx_buf_rsp(int (*fn)(const struct device *, unsigned
                                                 unsigned long));
 void uart_dma_test_set_hal_rx_enable(int (*fn)(const struct device *, unsigned char *,
                                                unsigned long, unsigned int));
+void uart_dma_test_set_hal_rx_disable(int (*fn)(const struct device *));
 /* Optional HAL shims for TX path and callback registration (host tests) */
 void uart_dma_test_set_hal_tx(int (*fn)(const struct device *, const unsigned char *, unsigned long,
                                         unsigned int));
 void uart_dma_test_set_hal_callback_set(int (*fn)(
     const struct device *, void (*)(const struct device *, struct uart_event *, void *), void *));
+void uart_dma_test_set_hal_configure(int (*fn)(const struct device *, const struct uart_config *));
 
 #ifdef __cplusplus
 }
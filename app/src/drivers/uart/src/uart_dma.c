@@ -78,6 +78,21 @@ struct uart_event {
         } rx_stop;
     } data;
 };
+
+enum {
+    UART_CFG_PARITY_NONE = 0,
+    UART_CFG_STOP_BITS_1 = 1,
+    UART_CFG_DATA_BITS_8 = 3,
+    UART_CFG_FLOW_CTRL_NONE = 0,
+    UART_CFG_FLOW_CTRL_RTS_CTS = 1,
+};
+struct uart_config {
+    uint32_t baudrate;
+    uint8_t parity;
+    uint8_t stop_bits;
+    uint8_t data_bits;
+    uint8_t flow_ctrl;
+};
 #endif
 
 LOG_MODULE_REGISTER(uart_dma, LOG_LEVEL_INF);
@@ -90,14 +105,18 @@ static uint8_t rx_buffer_storage[UART_DMA_RX_BUFFER_SIZE];
 static circular_buffer_t tx_buffer;
 static circular_buffer_t rx_buffer;
 
-/* DMA buffers for async operations - double buffering for RX */
-static uint8_t dma_rx_buf[2][UART_DMA_RX_CHUNK_SIZE];
+#if UART_DMA_RX_CHUNK_COUNT < 2
+#error "UART_DMA_RX_CHUNK_COUNT must be at least 2 for continuous reception"
+#endif
+
+/* DMA buffers for async operations - RX chunk pool, handed out round-robin */
+static uint8_t dma_rx_buf[UART_DMA_RX_CHUNK_COUNT][UART_DMA_RX_CHUNK_SIZE];
 static uint8_t dma_tx_buf[UART_DMA_TX_BUFFER_SIZE];
 
 /* UART device handle */
 static const struct device *uart_dev = NULL;
 
-/* RX state for double buffering */
+/* RX state: index of the next pool chunk to hand out */
 static uint8_t rx_buf_idx = 0;
 static bool rx_enabled = false;
 
@@ -108,6 +127,21 @@ static size_t tx_len = 0;
 /* Statistics */
 static struct uart_statistics stats = {0};
 
+/* Link negotiation: active settings, fallback while on probation */
+#ifndef UART_DMA_DEFAULT_BAUDRATE
+#define UART_DMA_DEFAULT_BAUDRATE 115200U
+#endif
+static struct uart_link_cfg link_active = {.baudrate = UART_DMA_DEFAULT_BAUDRATE,
+                                           .flow_ctrl = false};
+static struct uart_link_cfg link_fallback;
+static struct uart_link_cfg link_requested;
+static enum uart_link_state link_state = UART_LINK_STATE_IDLE;
+static uint32_t link_confirm_ms;
+static uint32_t link_deadline_ms;
+
+/* Runtime wake-up hook (ISR context) */
+static uart_notify_cb_t notify_cb;
+
 /* Initialization flag */
 static bool initialized = false;
 
@@ -115,10 +149,21 @@ static bool initialized = false;
 static struct k_sem tx_sem;
 static struct k_sem rx_sem;
 
-/* RX inactivity timeout to deliver partial frames (in microseconds) */
-#ifndef UART_DMA_RX_TIMEOUT_US
-#define UART_DMA_RX_TIMEOUT_US 20000U /* 20 ms */
+/*
+ * RX inactivity timeout to deliver partial frames (in microseconds). It only
+ * fires on an idle gap, so it is sized to a few character times at the active
+ * baud rate; sustained streams fill whole chunks and are unaffected.
+ */
+#ifndef UART_DMA_RX_TIMEOUT_CHARS
+#define UART_DMA_RX_TIMEOUT_CHARS 4U
+#endif
+#ifndef UART_DMA_RX_TIMEOUT_MIN_US
+#define UART_DMA_RX_TIMEOUT_MIN_US 100U
+#endif
+#ifndef UART_DMA_RX_TIMEOUT_MAX_US
+#define UART_DMA_RX_TIMEOUT_MAX_US 20000U /* 20 ms */
 #endif
+static uint32_t rx_timeout_us = UART_DMA_RX_TIMEOUT_MAX_US;
 
 /*
  * HAL indirection (used for unit tests). In firmware builds, these resolve to
@@ -128,17 +173,21 @@ static struct k_sem rx_sem;
 #ifndef UART_DMA_TESTING
 #define hal_uart_rx_buf_rsp   uart_rx_buf_rsp
 #define hal_uart_rx_enable    uart_rx_enable
+#define hal_uart_rx_disable   uart_rx_disable
 #define hal_uart_tx           uart_tx
 #define hal_uart_callback_set uart_callback_set
+#define hal_uart_configure    uart_configure
 #define hal_device_is_ready   device_is_ready
 #define hal_DEVICE_DT_GET(x)  DEVICE_DT_GET(x)
 #else
 static int (*hal_uart_rx_buf_rsp)(const struct device *, uint8_t *, size_t) = NULL;
 static int (*hal_uart_rx_enable)(const struct device *, uint8_t *, size_t, uint32_t) = NULL;
+static int (*hal_uart_rx_disable)(const struct device *) = NULL;
 static int (*hal_uart_tx)(const struct device *, const uint8_t *, size_t, uint32_t) = NULL;
 static int (*hal_uart_callback_set)(const struct device *,
                                     void (*)(const struct device *, struct uart_event *, void *),
                                     void *) = NULL;
+static int (*hal_uart_configure)(const struct device *, const struct uart_config *) = NULL;
 static int hal_device_is_ready(const struct device *d)
 {
     ARG_UNUSED(d);
@@ -156,6 +205,10 @@ void uart_dma_test_set_hal_rx_enable(int (*fn)(const struct device *, uint8_t *,
 {
     hal_uart_rx_enable = fn;
 }
+void uart_dma_test_set_hal_rx_disable(int (*fn)(const struct device *))
+{
+    hal_uart_rx_disable = fn;
+}
 void uart_dma_test_set_hal_tx(int (*fn)(const struct device *, const uint8_t *, size_t, uint32_t))
 {
     hal_uart_tx = fn;
@@ -165,8 +218,91 @@ void uart_dma_test_set_hal_callback_set(int (*fn)(
 {
     hal_uart_callback_set = fn;
 }
+void uart_dma_test_set_hal_configure(int (*fn)(const struct device *, const struct uart_config *))
+{
+    hal_uart_configure = fn;
+}
 #endif
 
+/**
+ * @brief Program baud rate and flow control (8N1 framing is fixed).
+ * @param cfg Link settings to apply.
+ * @return 0 on success, negative errno from the driver otherwise.
+ */
+static int link_apply(const struct uart_link_cfg *cfg)
+{
+    const struct uart_config ucfg = {.baudrate = cfg->baudrate,
+                                     .parity = UART_CFG_PARITY_NONE,
+                                     .stop_bits = UART_CFG_STOP_BITS_1,
+                                     .data_bits = UART_CFG_DATA_BITS_8,
+                                     .flow_ctrl = cfg->flow_ctrl ? UART_CFG_FLOW_CTRL_RTS_CTS :
+                                                                   UART_CFG_FLOW_CTRL_NONE};
+#ifdef UART_DMA_TESTING
+    if (hal_uart_configure == NULL) {
+        return -1;
+    }
+#endif
+    return hal_uart_configure(uart_dev, &ucfg);
+}
+
+/**
+ * @brief Derive the RX inactivity timeout from the baud rate.
+ * @param baudrate Active baud rate.
+ * @return UART_DMA_RX_TIMEOUT_CHARS character times (10 bits each), clamped.
+ */
+static uint32_t rx_timeout_for_baud(uint32_t baudrate)
+{
+    uint32_t us = UART_DMA_RX_TIMEOUT_MAX_US;
+    if (baudrate > 0U) {
+        us = (uint32_t)((UART_DMA_RX_TIMEOUT_CHARS * 10ULL * 1000000ULL + baudrate - 1U) /
+                        baudrate);
+    }
+    if (us < UART_DMA_RX_TIMEOUT_MIN_US) {
+        us = UART_DMA_RX_TIMEOUT_MIN_US;
+    } else if (us > UART_DMA_RX_TIMEOUT_MAX_US) {
+        us = UART_DMA_RX_TIMEOUT_MAX_US;
+    }
+    return us;
+}
+
+/**
+ * @brief (Re)start reception with the first pool chunk and current timeout.
+ * @param dev UART device.
+ * @return 0 on success, negative errno from the driver otherwise.
+ */
+static int rx_start(const struct device *dev)
+{
+    rx_buf_idx = 1; /* enable with chunk 0, next provided will be chunk 1 */
+    int ret = hal_uart_rx_enable(dev, dma_rx_buf[0], UART_DMA_RX_CHUNK_SIZE, rx_timeout_us);
+    if (ret == 0) {
+        rx_enabled = true;
+    }
+    return ret;
+}
+
+/**
+ * @brief Apply link settings and restart RX so the new timeout takes effect.
+ * @param cfg Link settings to apply.
+ * @return 0 on success, negative errno from the driver otherwise.
+ */
+static int link_switch(const struct uart_link_cfg *cfg)
+{
+    int ret = link_apply(cfg);
+    if (ret == 0) {
+        rx_timeout_us = rx_timeout_for_baud(cfg->baudrate);
+#ifdef UART_DMA_TESTING
+        if (hal_uart_rx_disable == NULL) {
+            return 0;
+        }
+#endif
+        /* RX_DISABLED re-enables reception with the new timeout */
+        if (rx_enabled) {
+            (void)hal_uart_rx_disable(uart_dev);
+        }
+    }
+    return ret;
+}
+
 /* UART async callback - handles all DMA events */
 /**
  * @brief UART async event handler (ISR context).
@@ -183,18 +319,27 @@ static void uart_callback(const struct device *dev, struct uart_event *evt, void
         case UART_TX_DONE:
             LOG_DBG("TX done: %d bytes", evt->data.tx.len);
             stats.tx_bytes += evt->data.tx.len;
+            stats.isr_tx_done++;
             tx_in_progress = false;
             k_sem_give(&tx_sem);
+            if (notify_cb) {
+                notify_cb(UART_NOTIFY_TX);
+            }
             break;
 
         case UART_TX_ABORTED:
             LOG_ERR("TX aborted");
+            stats.isr_tx_done++;
             tx_in_progress = false;
             k_sem_give(&tx_sem);
+            if (notify_cb) {
+                notify_cb(UART_NOTIFY_TX);
+            }
             break;
 
         case UART_RX_RDY:
             LOG_DBG("RX ready: %d bytes at offset %d", evt->data.rx.len, evt->data.rx.offset);
+            stats.isr_rx_rdy++;
 
             /* Copy received data to circular buffer (non-blocking; ISR context) */
             size_t written =
@@ -205,18 +350,21 @@ static void uart_callback(const struct device *dev, struct uart_event *evt, void
                 LOG_WRN("RX buffer overflow, lost %d bytes", evt->data.rx.len - written);
             }
             stats.rx_bytes += written;
+            if (written > 0 && notify_cb) {
+                notify_cb(UART_NOTIFY_RX);
+            }
             break;
 
         case UART_RX_BUF_REQUEST: {
             LOG_DBG("RX buffer request");
-            /* Provide the alternate buffer for continuous reception */
+            stats.isr_rx_buf_req++;
+            /* Provide the next pool chunk for continuous reception */
             uint8_t *buf = dma_rx_buf[rx_buf_idx];
             int ret = hal_uart_rx_buf_rsp(dev, buf, UART_DMA_RX_CHUNK_SIZE);
             if (ret < 0) {
                 LOG_ERR("Failed to provide RX buffer: %d", ret);
             } else {
-                /* Alternate between buffer 0 and 1 */
-                rx_buf_idx = (rx_buf_idx + 1) % 2;
+                rx_buf_idx = (uint8_t)((rx_buf_idx + 1U) % UART_DMA_RX_CHUNK_COUNT);
             }
             break;
         }
@@ -231,12 +379,9 @@ static void uart_callback(const struct device *dev, struct uart_event *evt, void
             rx_enabled = false;
             /* Restart RX if it was intentionally disabled */
             if (initialized) {
-                /* Restart RX with buffer 0 and set next to 1 */
-                rx_buf_idx = 1;
-                int ret = hal_uart_rx_enable(dev, dma_rx_buf[0], UART_DMA_RX_CHUNK_SIZE,
-                                             UART_DMA_RX_TIMEOUT_US);
+                stats.isr_rx_restarts++;
+                int ret = rx_start(dev);
                 if (ret == 0) {
-                    rx_enabled = true;
                     LOG_DBG("RX re-enabled");
                 } else {
                     LOG_ERR("Failed to re-enable RX: %d", ret);
@@ -265,11 +410,9 @@ static void uart_callback(const struct device *dev, struct uart_event *evt, void
 
             /* Attempt to restart RX */
             if (initialized) {
-                rx_buf_idx = 1;
-                int ret = hal_uart_rx_enable(dev, dma_rx_buf[0], UART_DMA_RX_CHUNK_SIZE,
-                                             UART_DMA_RX_TIMEOUT_US);
+                stats.isr_rx_restarts++;
+                int ret = rx_start(dev);
                 if (ret == 0) {
-                    rx_enabled = true;
                     LOG_DBG("RX restarted after error");
                 } else {
                     LOG_ERR("Failed to restart RX after error: %d", ret);
@@ -302,15 +445,12 @@ enum uart_dma_status grlc_uart_init(void)
         return UART_DMA_STATUS_ERROR;
     }
 
-    /* Configure UART (firmware build only) */
+    /* Configure UART (firmware build only); link starts at the default rate */
 #ifndef UART_DMA_TESTING
-    const struct uart_config cfg = {.baudrate = 115200,
-                                    .parity = UART_CFG_PARITY_NONE,
-                                    .stop_bits = UART_CFG_STOP_BITS_1,
-                                    .data_bits = UART_CFG_DATA_BITS_8,
-                                    .flow_ctrl = UART_CFG_FLOW_CTRL_NONE};
-
-    ret = uart_configure(uart_dev, &cfg);
+    link_active.baudrate = UART_DMA_DEFAULT_BAUDRATE;
+    link_active.flow_ctrl = false;
+    link_state = UART_LINK_STATE_IDLE;
+    ret = link_apply(&link_active);
     if (ret != 0) {
         /* Some drivers may not support runtime configure; proceed with DT config */
         LOG_WRN("UART runtime configuration failed: %d, using DT defaults", ret);
@@ -328,14 +468,10 @@ enum uart_dma_status grlc_uart_init(void)
         return UART_DMA_STATUS_ERROR;
     }
 
-    /* Prepare for double buffering */
-    rx_buf_idx = 1; /* enable with buf[0], next provided will be buf[1] */
-
-    /* Start RX with first buffer; use finite timeout for partial frames */
-    ret =
-        hal_uart_rx_enable(uart_dev, dma_rx_buf[0], UART_DMA_RX_CHUNK_SIZE, UART_DMA_RX_TIMEOUT_US);
+    /* Start RX with the first pool chunk; timeout tracks the link baud rate */
+    rx_timeout_us = rx_timeout_for_baud(link_active.baudrate);
+    ret = rx_start(uart_dev);
     if (ret == 0) {
-        rx_enabled = true;
         initialized = true;
         LOG_INF("UART RX enabled");
         return UART_DMA_STATUS_OK;
@@ -399,6 +535,34 @@ size_t grlc_uart_read(uint8_t *data, size_t max_len)
     return nread;
 }
 
+size_t grlc_uart_rx_consume(uart_rx_consume_fn fn, void *user)
+{
+    size_t total = 0;
+    if (initialized && fn != NULL) {
+        k_sem_take(&rx_sem, K_FOREVER);
+        /* Snapshot bounds the pass; the ISR may keep appending meanwhile */
+        size_t budget = grlc_cb_available(&rx_buffer);
+        while (budget > 0) {
+            uint8_t *span = NULL;
+            size_t len = 0;
+            if (grlc_cb_get_read_block(&rx_buffer, &span, &len) != 0 || len == 0) {
+                break;
+            }
+            len = MIN(len, budget);
+            size_t used = fn(span, len, user);
+            used = MIN(used, len);
+            grlc_cb_advance_read(&rx_buffer, used);
+            total += used;
+            budget -= used;
+            if (used < len) {
+                break;
+            }
+        }
+        k_sem_give(&rx_sem);
+    }
+    return total;
+}
+
 enum uart_dma_status grlc_uart_read_byte(uint8_t *byte)
 {
     enum uart_dma_status st = UART_DMA_STATUS_BUFFER_EMPTY;
@@ -444,6 +608,7 @@ void grlc_uart_get_statistics(struct uart_statistics *stats_out)
 {
     if (stats_out != NULL) {
         memcpy(stats_out, &stats, sizeof(struct uart_statistics));
+        stats_out->rx_timeout_us = rx_timeout_us;
     }
 }
 
@@ -495,6 +660,97 @@ void grlc_uart_process(void)
     }
 }
 
+void grlc_uart_set_notify(uart_notify_cb_t cb)
+{
+    notify_cb = cb;
+}
+
+bool grlc_uart_link_baud_supported(uint32_t baudrate)
+{
+    /* Rates with a BAUDRATE register encoding on the nRF52 UARTE */
+    static const uint32_t rates[] = {1200,   2400,   4800,   9600,   14400,  19200,
+                                     28800,  38400,  57600,  76800,  115200, 230400,
+                                     250000, 460800, 921600, 1000000};
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); ++i) {
+        if (rates[i] == baudrate) {
+            return true;
+        }
+    }
+    return false;
+}
+
+enum uart_dma_status grlc_uart_link_request(const struct uart_link_cfg *cfg, uint32_t confirm_ms)
+{
+    enum uart_dma_status rc = UART_DMA_STATUS_OK;
+    if (!initialized) {
+        rc = UART_DMA_STATUS_NOT_INITIALIZED;
+    } else if (cfg == NULL || !grlc_uart_link_baud_supported(cfg->baudrate)) {
+        rc = UART_DMA_STATUS_ERROR;
+    } else if (link_state != UART_LINK_STATE_IDLE) {
+        rc = UART_DMA_STATUS_BUSY;
+    } else {
+        if (confirm_ms == 0) {
+            confirm_ms = UART_LINK_CONFIRM_MS_DEFAULT;
+        } else if (confirm_ms > UART_LINK_CONFIRM_MS_MAX) {
+            confirm_ms = UART_LINK_CONFIRM_MS_MAX;
+        }
+        link_requested = *cfg;
+        link_confirm_ms = confirm_ms;
+        link_state = UART_LINK_STATE_PENDING;
+        LOG_INF("Link switch requested: %u baud, flow=%d", (unsigned)cfg->baudrate,
+                (int)cfg->flow_ctrl);
+    }
+    return rc;
+}
+
+enum uart_link_state grlc_uart_link_service(uint32_t now_ms, bool frame_ok)
+{
+    if (!initialized) {
+        return link_state;
+    }
+    if (link_state == UART_LINK_STATE_PENDING) {
+        /* Wait until the acknowledgement has fully left the wire */
+        if (grlc_uart_tx_complete()) {
+            int ret = link_switch(&link_requested);
+            if (ret == 0) {
+                link_fallback = link_active;
+                link_active = link_requested;
+                link_deadline_ms = now_ms + link_confirm_ms;
+                link_state = UART_LINK_STATE_PROBATION;
+            } else {
+                LOG_ERR("Link switch failed: %d", ret);
+                link_state = UART_LINK_STATE_IDLE;
+            }
+            /* Bytes straddling the switch are garbage at either rate */
+            grlc_uart_clear_rx_buffer();
+        }
+    } else if (link_state == UART_LINK_STATE_PROBATION) {
+        if (frame_ok) {
+            LOG_INF("Link confirmed at %u baud", (unsigned)link_active.baudrate);
+            link_state = UART_LINK_STATE_IDLE;
+        } else if ((int32_t)(now_ms - link_deadline_ms) >= 0) {
+            LOG_WRN("Link not confirmed; reverting to %u baud", (unsigned)link_fallback.baudrate);
+            if (link_switch(&link_fallback) == 0) {
+                link_active = link_fallback;
+            }
+            stats.link_rollbacks++;
+            grlc_uart_clear_rx_buffer();
+            link_state = UART_LINK_STATE_IDLE;
+        }
+    }
+    return link_state;
+}
+
+void grlc_uart_link_get(struct uart_link_cfg *cfg, enum uart_link_state *state)
+{
+    if (cfg != NULL) {
+        *cfg = link_active;
+    }
+    if (state != NULL) {
+        *state = link_state;
+    }
+}
+
 #ifdef UART_DMA_TESTING
 /* Test-only helpers */
 void uart_dma_test_reset(void)
@@ -504,6 +760,13 @@ void uart_dma_test_reset(void)
     tx_in_progress = false;
     tx_len = 0;
     memset(&stats, 0, sizeof(stats));
+    rx_timeout_us = rx_timeout_for_baud(UART_DMA_DEFAULT_BAUDRATE);
+    link_active.baudrate = UART_DMA_DEFAULT_BAUDRATE;
+    link_active.flow_ctrl = false;
+    link_state = UART_LINK_STATE_IDLE;
+    notify_cb = NULL;
+    grlc_cb_init(&tx_buffer, tx_buffer_storage, UART_DMA_TX_BUFFER_SIZE);
+    grlc_cb_init(&rx_buffer, rx_buffer_storage, UART_DMA_RX_BUFFER_SIZE);
     initialized = true; /* allow restart paths */
 }
 
@@ -19,6 +19,19 @@ extern "C" {
  */
 uint32_t crc32_ieee(const uint8_t *data, size_t len);
 
+/**
+ * @brief Continue a CRC-32 over more bytes.
+ *
+ * crc32_ieee_update(crc32_ieee(a, n), b, m) equals the CRC of a followed by b;
+ * start from 0. Processes four bytes per step (slice-by-4, 4 KB of tables).
+ *
+ * @param crc  CRC of the data so far (0 for none).
+ * @param data Pointer to input bytes (may be NULL if len == 0).
+ * @param len  Number of bytes to process.
+ * @return uint32_t CRC-32 of the data so far followed by @p data.
+ */
+uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
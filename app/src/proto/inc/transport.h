@@ -49,6 +49,18 @@ struct transport_lower_if {
      * @return number of bytes consumed (<= len)
      */
     size_t (*write)(const uint8_t *data, size_t len);
+    /**
+     * @brief Optional context-aware write; preferred over @ref write when set.
+     *
+     * Lets one write routine serve several links (e.g. one BLE connection
+     * per transport) by passing @ref ctx back.
+     * @param ctx  The @ref ctx pointer of this interface
+     * @param data Pointer to bytes to write
+     * @param len  Number of bytes
+     * @return number of bytes consumed (<= len)
+     */
+    size_t (*write_ctx)(void *ctx, const uint8_t *data, size_t len);
+    void *ctx; /**< Opaque pointer passed to @ref write_ctx */
 };
 
 /** @brief Callback invoked when a full message is reassembled. */
@@ -30,6 +30,19 @@ static void wr32(uint8_t *p, uint32_t v)
     p[3] = (uint8_t)((v >> 24) & 0xFF);
 }
 
+static bool lower_ready(const struct transport_ctx *t)
+{
+    return t->lower && (t->lower->write_ctx || t->lower->write);
+}
+
+static size_t lower_write(const struct transport_ctx *t, const uint8_t *data, size_t len)
+{
+    if (t->lower->write_ctx) {
+        return t->lower->write_ctx(t->lower->ctx, data, len);
+    }
+    return t->lower->write(data, len);
+}
+
 static void reset_parse(struct transport_ctx *t)
 {
     t->rx_state = RX_SYNC0;
@@ -230,7 +243,7 @@ bool grlc_transport_send_message(struct transport_ctx *t, uint16_t session, cons
                                  size_t len, bool is_response)
 {
     bool accepted = false;
-    if (t && t->lower && t->lower->write && (msg || len == 0) && !t->tx_in_progress &&
+    if (t && lower_ready(t) && (msg || len == 0) && !t->tx_in_progress &&
         len <= TRANSPORT_REASSEMBLY_MAX) {
         size_t maxp = TRANSPORT_FRAME_MAX_PAYLOAD;
         uint16_t frag_count = (uint16_t)((len + maxp - 1) / maxp);
@@ -308,7 +321,7 @@ static void assemble_next_frame(struct transport_ctx *t)
 
 void grlc_transport_tx_pump(struct transport_ctx *t)
 {
-    if (!t || !t->tx_in_progress || !t->lower || !t->lower->write) {
+    if (!t || !t->tx_in_progress || !lower_ready(t)) {
         return;
     }
     /* Keep assembling and writing frames until lower layer stalls or message completes. */
@@ -320,8 +333,8 @@ void grlc_transport_tx_pump(struct transport_ctx *t)
 
         /* Write as much as the lower layer accepts, non-blocking */
         while (t->tx_frame_pos < t->tx_frame_len) {
-            size_t w = t->lower->write(&t->tx_frame_buf[t->tx_frame_pos],
-                                       t->tx_frame_len - t->tx_frame_pos);
+            size_t w = lower_write(t, &t->tx_frame_buf[t->tx_frame_pos],
+                                   t->tx_frame_len - t->tx_frame_pos);
             if (w == 0) {
                 /* No space right now; try again on next tick */
 #ifdef __ZEPHYR__
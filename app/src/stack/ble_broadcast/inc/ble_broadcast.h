@@ -0,0 +1,79 @@
+/**
+ * @brief Connectionless sensor broadcast over BLE advertising.
+ *
+ * When enabled, the TMP119 sensors found at boot are sampled every interval
+ * and published, with uptime and a sequence counter, as manufacturer-specific
+ * advertising data. A scanner can then read many devices without connecting.
+ *
+ * Manufacturer data layout (little-endian):
+ *   [company_id:2][ver:1][seq:2][uptime_s:4][n:1][temp_centi_c:2 * n]
+ * A temperature of GRLC_BLE_BCAST_TEMP_INVALID marks a failed read.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Bluetooth SIG reserved "no company" ID, used for test/prototype payloads */
+#define GRLC_BLE_BCAST_COMPANY_ID 0xFFFFu
+#define GRLC_BLE_BCAST_VERSION 1u
+#define GRLC_BLE_BCAST_MAX_SENSORS 4u
+#define GRLC_BLE_BCAST_TEMP_INVALID INT16_MIN
+#define GRLC_BLE_BCAST_HDR_LEN 10u
+#define GRLC_BLE_BCAST_PAYLOAD_MAX (GRLC_BLE_BCAST_HDR_LEN + 2u * GRLC_BLE_BCAST_MAX_SENSORS)
+
+#define GRLC_BLE_BCAST_INTERVAL_MIN_MS 100u
+#define GRLC_BLE_BCAST_INTERVAL_MAX_MS 60000u
+#ifndef GRLC_BLE_BCAST_INTERVAL_DEFAULT_MS
+#define GRLC_BLE_BCAST_INTERVAL_DEFAULT_MS 1000u
+#endif
+
+/** @brief Broadcast state as reported by BLE_CTRL GET_BROADCAST. */
+struct ble_bcast_status {
+    bool enabled;
+    uint16_t interval_ms; /**< Refresh interval */
+    uint16_t seq;         /**< Sequence number of the next payload */
+    uint8_t sensors;      /**< Temperatures in the last payload */
+};
+
+/**
+ * @brief Encode a broadcast payload.
+ *
+ * @param out      Destination buffer
+ * @param cap      Capacity of @p out
+ * @param seq      Sequence counter
+ * @param uptime_s Uptime in seconds
+ * @param temps    Temperatures in 0.01 °C (may be NULL when @p n is 0)
+ * @param n        Number of temperatures (<= GRLC_BLE_BCAST_MAX_SENSORS)
+ * @return Encoded length, or 0 if @p cap is too small or @p n too large.
+ */
+size_t grlc_ble_bcast_encode(uint8_t *out, size_t cap, uint16_t seq, uint32_t uptime_s,
+                             const int16_t *temps, uint8_t n);
+
+/**
+ * @brief Enable or disable the broadcast.
+ *
+ * Enabling publishes a first payload right away. Disabling removes the
+ * manufacturer data from the advertising packets.
+ *
+ * @param enable      true to broadcast
+ * @param interval_ms Refresh interval; 0 keeps the current one
+ * @return 0 on success, -EINVAL if @p interval_ms is out of range.
+ */
+int grlc_ble_bcast_set(bool enable, uint16_t interval_ms);
+
+/**
+ * @brief Report the broadcast state.
+ * @param[out] st Filled with the current state.
+ */
+void grlc_ble_bcast_get(struct ble_bcast_status *st);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,146 @@
+#include "stack/ble_broadcast/inc/ble_broadcast.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "commands/inc/system_iface.h"
+#include "drivers/ble_nus/inc/ble_nus.h"
+#include "drivers/tmp119/inc/tmp119.h"
+
+#ifdef __ZEPHYR__
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ble_bcast, LOG_LEVEL_INF);
+#else
+#define LOG_DBG(...)
+#define LOG_WRN(...)
+#endif
+
+static bool s_enabled;
+static uint16_t s_interval_ms = GRLC_BLE_BCAST_INTERVAL_DEFAULT_MS;
+static uint16_t s_seq;
+static uint8_t s_sensors;
+
+size_t grlc_ble_bcast_encode(uint8_t *out, size_t cap, uint16_t seq, uint32_t uptime_s,
+                             const int16_t *temps, uint8_t n)
+{
+    size_t len = GRLC_BLE_BCAST_HDR_LEN + 2u * (size_t)n;
+    if (!out || n > GRLC_BLE_BCAST_MAX_SENSORS || (n && !temps) || cap < len) {
+        return 0;
+    }
+    out[0] = (uint8_t)(GRLC_BLE_BCAST_COMPANY_ID & 0xFFu);
+    out[1] = (uint8_t)(GRLC_BLE_BCAST_COMPANY_ID >> 8);
+    out[2] = GRLC_BLE_BCAST_VERSION;
+    out[3] = (uint8_t)(seq & 0xFFu);
+    out[4] = (uint8_t)(seq >> 8);
+    for (size_t i = 0; i < 4; ++i) {
+        out[5 + i] = (uint8_t)(uptime_s >> (8 * i));
+    }
+    out[9] = n;
+    for (size_t i = 0; i < n; ++i) {
+        uint16_t v = (uint16_t)temps[i];
+        out[GRLC_BLE_BCAST_HDR_LEN + 2 * i] = (uint8_t)(v & 0xFFu);
+        out[GRLC_BLE_BCAST_HDR_LEN + 2 * i + 1] = (uint8_t)(v >> 8);
+    }
+    return len;
+}
+
+/** @brief Read every verified TMP119 in 0.01 °C; failed reads are marked invalid. */
+static uint8_t bcast_sample(int16_t *temps)
+{
+    uint8_t n = 0;
+    for (uint8_t a = TMP119_ADDR_FIRST;
+         a <= TMP119_ADDR_LAST && n < GRLC_BLE_BCAST_MAX_SENSORS; ++a) {
+        if (!grlc_tmp119_is_present(a)) {
+            continue;
+        }
+        int32_t mC = 0;
+        if (grlc_tmp119_read_temperature_mC(a, &mC) == 0) {
+            /* TMP119 range is -55..150 °C, well inside int16 centi-degrees */
+            temps[n] = (int16_t)(mC / 10);
+        } else {
+            temps[n] = GRLC_BLE_BCAST_TEMP_INVALID;
+        }
+        ++n;
+    }
+    return n;
+}
+
+/** @brief Sample, encode and hand the next payload to the advertiser. */
+static void bcast_refresh(void)
+{
+    int16_t temps[GRLC_BLE_BCAST_MAX_SENSORS];
+    uint8_t payload[GRLC_BLE_BCAST_PAYLOAD_MAX];
+    uint8_t n = bcast_sample(temps);
+    uint32_t uptime_s = (uint32_t)(grlc_sys_uptime_ms() / 1000u);
+    size_t len = grlc_ble_bcast_encode(payload, sizeof(payload), s_seq, uptime_s, temps, n);
+    int rc = grlc_ble_set_adv_mfg_data(payload, len);
+    if (rc) {
+        LOG_WRN("Broadcast update failed: %d", rc);
+        return;
+    }
+    s_sensors = n;
+    ++s_seq;
+}
+
+#ifdef __ZEPHYR__
+/*
+ * Runs on the TMP119 work queue: the sensor reads block on I2C and must not
+ * hold up Bluetooth processing on the system workqueue.
+ */
+static void bcast_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(s_bcast_work, bcast_work_fn);
+
+static void bcast_work_fn(struct k_work *work)
+{
+    ARG_UNUSED(work);
+    if (!s_enabled) {
+        return;
+    }
+    bcast_refresh();
+    if (s_enabled) {
+        (void)k_work_schedule_for_queue(grlc_tmp119_workq(), &s_bcast_work,
+                                        K_MSEC(s_interval_ms));
+    } else {
+        /* Disabled while sampling: undo this refresh */
+        (void)grlc_ble_set_adv_mfg_data(NULL, 0);
+    }
+}
+#endif
+
+int grlc_ble_bcast_set(bool enable, uint16_t interval_ms)
+{
+    if (interval_ms != 0 && (interval_ms < GRLC_BLE_BCAST_INTERVAL_MIN_MS ||
+                             interval_ms > GRLC_BLE_BCAST_INTERVAL_MAX_MS)) {
+        return -EINVAL;
+    }
+    if (interval_ms != 0) {
+        s_interval_ms = interval_ms;
+    }
+    s_enabled = enable;
+    if (enable) {
+#ifdef __ZEPHYR__
+        (void)k_work_reschedule_for_queue(grlc_tmp119_workq(), &s_bcast_work, K_NO_WAIT);
+#else
+        bcast_refresh();
+#endif
+    } else {
+#ifdef __ZEPHYR__
+        (void)k_work_cancel_delayable(&s_bcast_work);
+#endif
+        s_sensors = 0;
+        (void)grlc_ble_set_adv_mfg_data(NULL, 0);
+    }
+    return 0;
+}
+
+void grlc_ble_bcast_get(struct ble_bcast_status *st)
+{
+    if (!st) {
+        return;
+    }
+    st->enabled = s_enabled;
+    st->interval_ms = s_interval_ms;
+    st->seq = s_seq;
+    st->sensors = s_sensors;
+}
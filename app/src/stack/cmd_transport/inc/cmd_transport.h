@@ -12,6 +12,12 @@ struct transport_ctx;
 #ifdef __ZEPHYR__
 #include <zephyr/kernel.h>
 #endif
+/**
+ * Sessions 0xFF00..0xFFFF are reserved for unsolicited device messages
+ * (sent without the RESP flag); hosts number their requests below it.
+ */
+#define GRLC_CMD_NOTIFY_SESSION_BASE 0xFF00u
+
 typedef void (*transport_msg_cb)(void *user, uint16_t session, const uint8_t *msg, size_t len,
                                  bool is_response);
 
@@ -28,11 +34,12 @@ struct cmd_transport_binding {
 #ifdef __ZEPHYR__
     struct k_mutex lock; /**< Serialize response build/send per binding */
 #endif
-    /* Pending response if transport TX is busy (keeps its own copy) */
+    /* Response still in resp_buf because transport TX was busy; the next
+     * request flushes it first, or replaces it if the link is still busy.
+     */
     bool pending;
     uint16_t pending_session;
     size_t pending_len;
-    uint8_t pending_buf[2048];
 };
 
 /** @brief Initialize command registry and built-in handlers (idempotent). */
@@ -54,6 +61,21 @@ transport_msg_cb grlc_cmd_get_transport_cb(void);
  */
 void grlc_cmd_transport_tick(struct cmd_transport_binding *b);
 
+/**
+ * @brief Send an unsolicited message on a bound transport.
+ *
+ * Never waits: fails while a response is pending or a message is still in
+ * flight, so notifications cannot delay or displace command responses.
+ *
+ * @param b       Binding to send on.
+ * @param session Session in the GRLC_CMD_NOTIFY_SESSION_BASE range.
+ * @param msg     Packed message (copied by the transport).
+ * @param len     Message length.
+ * @return true if the transport accepted the message.
+ */
+bool grlc_cmd_transport_notify(struct cmd_transport_binding *b, uint16_t session,
+                               const uint8_t *msg, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,20 @@
 LOG_MODULE_REGISTER(cmd_transport, LOG_LEVEL_INF);
 #endif
 
+/** @brief Try to send the response parked in resp_buf. Caller holds b->lock. */
+static void flush_pending(struct cmd_transport_binding *b)
+{
+    if (b->pending && !b->t->tx_in_progress) {
+        if (grlc_transport_send_message(b->t, b->pending_session, b->resp_buf, b->pending_len,
+                                        true)) {
+            b->pending = false;
+            grlc_transport_tx_pump(b->t);
+            grlc_transport_tx_pump(b->t);
+            grlc_transport_tx_pump(b->t);
+        }
+    }
+}
+
 static void transport_cb(void *user, uint16_t session, const uint8_t *msg, size_t len,
                          bool is_response)
 {
@@ -42,10 +56,14 @@ static void transport_cb(void *user, uint16_t session, const uint8_t *msg, size_
 #ifdef __ZEPHYR__
         k_mutex_lock(&b->lock, K_FOREVER);
 #endif
+        /* resp_buf is about to be reused: get an earlier response out first */
+        flush_pending(b);
+        b->pending = false;
         uint16_t status = (uint16_t)CMD_STATUS_ERR_UNSUPPORTED;
         size_t out_cap = sizeof(b->resp_buf) - 6;
         size_t actual_len = out_cap; /* in: capacity, out: actual length */
-        (void)grlc_cmd_dispatch(cmd_id, req, req_len, &b->resp_buf[6], &actual_len, &status);
+        (void)grlc_cmd_dispatch_ctx(b, cmd_id, req, req_len, &b->resp_buf[6], &actual_len,
+                                    &status);
         if (status != (uint16_t)CMD_STATUS_OK) {
             actual_len = 0;
         } else if (actual_len > out_cap) {
@@ -55,13 +73,10 @@ static void transport_cb(void *user, uint16_t session, const uint8_t *msg, size_
         grlc_cmd_pack_response(cmd_id, status, &b->resp_buf[6], (uint16_t)actual_len, b->resp_buf,
                                sizeof(b->resp_buf), &packed_len);
         if (!grlc_transport_send_message(b->t, session, b->resp_buf, packed_len, true)) {
-            /* Transport busy: make a copy of the packed response */
-            if (packed_len <= sizeof(b->pending_buf)) {
-                memcpy(b->pending_buf, b->resp_buf, packed_len);
-                b->pending = true;
-                b->pending_session = session;
-                b->pending_len = packed_len;
-            }
+            /* Transport busy: keep the packed response in resp_buf */
+            b->pending = true;
+            b->pending_session = session;
+            b->pending_len = packed_len;
         } else {
             /* Non-blocking: nudge TX pump immediately to reduce latency */
             grlc_transport_tx_pump(b->t);
@@ -109,13 +124,34 @@ void grlc_cmd_transport_tick(struct cmd_transport_binding *b)
 {
     if (!b || !b->t)
         return;
-    if (b->pending && !b->t->tx_in_progress) {
-        if (grlc_transport_send_message(b->t, b->pending_session, b->pending_buf, b->pending_len,
-                                        true)) {
-            b->pending = false;
+#ifdef __ZEPHYR__
+    k_mutex_lock(&b->lock, K_FOREVER);
+#endif
+    flush_pending(b);
+#ifdef __ZEPHYR__
+    k_mutex_unlock(&b->lock);
+#endif
+}
+
+bool grlc_cmd_transport_notify(struct cmd_transport_binding *b, uint16_t session,
+                               const uint8_t *msg, size_t len)
+{
+    bool sent = false;
+    if (!b || !b->t)
+        return false;
+#ifdef __ZEPHYR__
+    k_mutex_lock(&b->lock, K_FOREVER);
+#endif
+    if (!b->pending && !b->t->tx_in_progress) {
+        sent = grlc_transport_send_message(b->t, session, msg, len, false);
+        if (sent) {
             grlc_transport_tx_pump(b->t);
             grlc_transport_tx_pump(b->t);
             grlc_transport_tx_pump(b->t);
         }
     }
+#ifdef __ZEPHYR__
+    k_mutex_unlock(&b->lock);
+#endif
+    return sent;
 }
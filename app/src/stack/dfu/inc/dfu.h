@@ -0,0 +1,85 @@
+/**
+ * @brief Firmware update into the secondary image slot.
+ *
+ * An image is streamed over any command link into the MCUboot secondary
+ * slot (slot1_partition) through stack/flash_writer, so page erases overlap
+ * the transfer. CRC-32 (kept by the writer) and SHA-256 are updated per
+ * accepted chunk; finishing compares both against the digests the host sent
+ * without reading the slot back. A verified image with a valid MCUboot header
+ * is then marked for swap, and the next REBOOT lets MCUboot install it.
+ *
+ * The update shares the single flash writer session: a FLASH_WRITE BEGIN
+ * during an update cancels it.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "utils/sha256/inc/sha256.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** MCUboot image header magic (first word of a signed image) */
+#define GRLC_DFU_IMAGE_MAGIC 0x96f3b83du
+
+/** @brief Update state. */
+struct dfu_status {
+    bool active;      /**< Image transfer in progress */
+    bool verified;    /**< Last transfer completed and matched the host digests */
+    bool pending;     /**< Swap requested for the next reboot */
+    uint32_t slot;    /**< Secondary slot address */
+    uint32_t size;    /**< Image size */
+    uint32_t written; /**< Bytes accepted so far (next expected offset) */
+};
+
+/**
+ * @brief Start an update, replacing any previous one.
+ * @param size           Image size in bytes.
+ * @param[out] slot_addr Secondary slot address.
+ * @param[out] slot_size Secondary slot size.
+ * @return 0 on success, -ENOTSUP without a secondary slot, -EFBIG if the image does
+ *         not fit, -EINVAL if the slot is not writable, -EIO on a flash error.
+ */
+int grlc_dfu_begin(uint32_t size, uint32_t *slot_addr, uint32_t *slot_size);
+
+/**
+ * @brief Append image data at @p offset (see grlc_flash_writer_write()).
+ * @return 0 on success, -ENOENT without an update, -EINVAL on an offset mismatch
+ *         or overflow, -EIO on a flash error.
+ */
+int grlc_dfu_write(uint32_t offset, const uint8_t *data, size_t len);
+
+/**
+ * @brief Complete the transfer and check it against the host digests.
+ * @param crc_expect CRC-32 of the whole image.
+ * @param sha_expect SHA-256 of the whole image.
+ * @param[out] crc   CRC-32 computed on the device.
+ * @param[out] sha   SHA-256 computed on the device.
+ * @return 0 if both match, -EBADMSG on a mismatch, -ENOENT without an update,
+ *         -EINVAL if bytes are missing, -EIO on a flash error.
+ */
+int grlc_dfu_finish(uint32_t crc_expect, const uint8_t sha_expect[GRLC_SHA256_DIGEST_LEN],
+                    uint32_t *crc, uint8_t sha[GRLC_SHA256_DIGEST_LEN]);
+
+/**
+ * @brief Mark the verified image for installation on the next reboot.
+ * @param permanent false: test swap, reverted unless the new image is confirmed;
+ *                  true: permanent swap.
+ * @return 0 on success, -ENOENT without a verified image, -EBADMSG if the image has
+ *         no MCUboot header, -ENOTSUP without MCUboot, other negative errno on error.
+ */
+int grlc_dfu_apply(bool permanent);
+
+/** @brief Drop the update (a requested swap stays requested). */
+void grlc_dfu_abort(void);
+
+/** @brief Snapshot the update state. */
+void grlc_dfu_get(struct dfu_status *st);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,170 @@
+#include "stack/dfu/inc/dfu.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "commands/inc/system_iface.h"
+#include "stack/flash_writer/inc/flash_writer.h"
+
+#ifdef __ZEPHYR__
+#include <zephyr/kernel.h>
+static K_MUTEX_DEFINE(s_lock);
+#define DFU_LOCK() k_mutex_lock(&s_lock, K_FOREVER)
+#define DFU_UNLOCK() k_mutex_unlock(&s_lock)
+#else
+#define DFU_LOCK()
+#define DFU_UNLOCK()
+#endif
+
+static struct {
+    bool active;
+    bool verified;
+    bool pending;
+    uint32_t slot;
+    uint32_t size;
+    uint32_t written;
+    uint32_t magic;
+    sha256_ctx_t sha;
+} s_dfu;
+
+/** @brief Whether the writer session is still the one this update opened. */
+static bool writer_owned(void)
+{
+    struct flash_writer_status ws;
+    grlc_flash_writer_get(&ws);
+    return ws.addr == s_dfu.slot && ws.len == s_dfu.size;
+}
+
+int grlc_dfu_begin(uint32_t size, uint32_t *slot_addr, uint32_t *slot_size)
+{
+    uint32_t addr = 0, cap = 0;
+    if (!grlc_sys_dfu_slot(&addr, &cap)) {
+        return -ENOTSUP;
+    }
+    if (slot_addr) {
+        *slot_addr = addr;
+    }
+    if (slot_size) {
+        *slot_size = cap;
+    }
+    if (size == 0 || size > cap) {
+        return -EFBIG;
+    }
+    DFU_LOCK();
+    s_dfu.active = false;
+    s_dfu.verified = false;
+    int rc = grlc_flash_writer_begin(addr, size);
+    if (rc == 0) {
+        s_dfu.active = true;
+        s_dfu.slot = addr;
+        s_dfu.size = size;
+        s_dfu.written = 0;
+        s_dfu.magic = 0;
+        grlc_sha256_init(&s_dfu.sha);
+    }
+    DFU_UNLOCK();
+    return rc;
+}
+
+int grlc_dfu_write(uint32_t offset, const uint8_t *data, size_t len)
+{
+    int rc;
+    DFU_LOCK();
+    if (!s_dfu.active || !writer_owned()) {
+        s_dfu.active = false;
+        rc = -ENOENT;
+    } else {
+        rc = grlc_flash_writer_write(offset, data, len);
+    }
+    if (rc == 0) {
+        /* Hash only what the writer accepted, so a retried chunk is hashed once */
+        for (size_t i = 0; offset + i < 4u && i < len; ++i) {
+            s_dfu.magic |= (uint32_t)data[i] << (8u * (offset + i));
+        }
+        grlc_sha256_update(&s_dfu.sha, data, len);
+        s_dfu.written = offset + (uint32_t)len;
+    } else if (rc == -EIO) {
+        s_dfu.active = false;
+    }
+    DFU_UNLOCK();
+    return rc;
+}
+
+int grlc_dfu_finish(uint32_t crc_expect, const uint8_t sha_expect[GRLC_SHA256_DIGEST_LEN],
+                    uint32_t *crc, uint8_t sha[GRLC_SHA256_DIGEST_LEN])
+{
+    int rc;
+    DFU_LOCK();
+    if (!s_dfu.active || !writer_owned()) {
+        s_dfu.active = false;
+        rc = -ENOENT;
+    } else {
+        uint32_t c = 0;
+        rc = grlc_flash_writer_finish(NULL, &c);
+        if (rc != -EINVAL) {
+            /* Complete (or failed): the session is over either way */
+            s_dfu.active = false;
+        }
+        if (rc == 0) {
+            uint8_t digest[GRLC_SHA256_DIGEST_LEN];
+            grlc_sha256_final(&s_dfu.sha, digest);
+            if (crc) {
+                *crc = c;
+            }
+            if (sha) {
+                memcpy(sha, digest, sizeof(digest));
+            }
+            bool match = (c == crc_expect) && sha_expect &&
+                         memcmp(digest, sha_expect, sizeof(digest)) == 0;
+            s_dfu.verified = match;
+            rc = match ? 0 : -EBADMSG;
+        }
+    }
+    DFU_UNLOCK();
+    return rc;
+}
+
+int grlc_dfu_apply(bool permanent)
+{
+    int rc;
+    DFU_LOCK();
+    if (!s_dfu.verified) {
+        rc = -ENOENT;
+    } else if (s_dfu.magic != GRLC_DFU_IMAGE_MAGIC) {
+        rc = -EBADMSG;
+    } else {
+        rc = grlc_sys_dfu_request_upgrade(permanent);
+        s_dfu.pending = (rc == 0) || s_dfu.pending;
+    }
+    DFU_UNLOCK();
+    return rc;
+}
+
+void grlc_dfu_abort(void)
+{
+    DFU_LOCK();
+    if (s_dfu.active && writer_owned()) {
+        grlc_flash_writer_abort();
+    }
+    s_dfu.active = false;
+    s_dfu.verified = false;
+    DFU_UNLOCK();
+}
+
+void grlc_dfu_get(struct dfu_status *st)
+{
+    if (!st) {
+        return;
+    }
+    DFU_LOCK();
+    if (s_dfu.active && !writer_owned()) {
+        s_dfu.active = false;
+    }
+    st->active = s_dfu.active;
+    st->verified = s_dfu.verified;
+    st->pending = s_dfu.pending;
+    st->slot = s_dfu.slot;
+    st->size = s_dfu.size;
+    st->written = s_dfu.written;
+    DFU_UNLOCK();
+}
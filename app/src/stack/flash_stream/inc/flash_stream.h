@@ -0,0 +1,80 @@
+/**
+ * @brief Streamed flash reads: one request, many chunk messages.
+ *
+ * FLASH_READ_STREAM starts a read of any length on the link it arrived on.
+ * The link's service loop then sends the region as unsolicited messages on
+ * session GRLC_FLASH_STREAM_SESSION (RESP flag clear), packed like a
+ * FLASH_READ_STREAM response:
+ *   status OK:    [offset:4][data]    offset from the start address
+ *   status error: [offset:4]          read failed at offset; stream ended
+ *
+ * The next chunk is read from flash as soon as the previous one has been
+ * handed to the transport (which keeps its own copy), so the flash read
+ * overlaps the previous chunk's transmission. Chunks yield to pending
+ * command responses, so other commands keep working during a stream.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct cmd_transport_binding;
+
+#ifndef GRLC_FLASH_STREAM_MAX
+/** Concurrent streams across all links */
+#define GRLC_FLASH_STREAM_MAX 2u
+#endif
+
+#ifndef GRLC_FLASH_STREAM_CHUNK_MAX
+/** Data bytes per chunk message (message adds 10 bytes of header) */
+#define GRLC_FLASH_STREAM_CHUNK_MAX 1024u
+#endif
+#define GRLC_FLASH_STREAM_CHUNK_MIN 16u
+
+/** Session carrying chunks; above the telemetry subscription sessions */
+#define GRLC_FLASH_STREAM_SESSION 0xFFFFu
+/** Wait while the link is busy; TX completion wakes the link thread, so only a safety net */
+#define GRLC_FLASH_STREAM_RETRY_MS 50u
+/** grlc_flash_stream_service() result when the link has no stream */
+#define GRLC_FLASH_STREAM_IDLE UINT32_MAX
+
+/**
+ * @brief Start (or restart) the stream of a link.
+ *
+ * Reads the first chunk before returning, so it is ready by the time the
+ * command response has gone out.
+ *
+ * @param b     Link the chunks go to.
+ * @param addr  Absolute flash address.
+ * @param len   Bytes to stream (>= 1).
+ * @param chunk Bytes per chunk, 0 for GRLC_FLASH_STREAM_CHUNK_MAX.
+ * @param[out] chunk_out Chunk size in effect.
+ * @return 0 on success, -EINVAL on bad arguments, -ENOMEM if every stream is in use.
+ */
+int grlc_flash_stream_start(struct cmd_transport_binding *b, uint32_t addr, uint32_t len,
+                            uint16_t chunk, uint16_t *chunk_out);
+
+/**
+ * @brief Abort the stream of a link.
+ * @return Bytes that were still to be sent (0 if there was no stream).
+ */
+uint32_t grlc_flash_stream_cancel(struct cmd_transport_binding *b);
+
+/**
+ * @brief Send as many chunks as the link accepts.
+ *
+ * Called from the link's service loop, on the thread that owns the
+ * transport, after its pending-response tick.
+ *
+ * @param b Link to service.
+ * @return GRLC_FLASH_STREAM_RETRY_MS while chunks remain, else GRLC_FLASH_STREAM_IDLE.
+ */
+uint32_t grlc_flash_stream_service(struct cmd_transport_binding *b);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,145 @@
+#include "stack/flash_stream/inc/flash_stream.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "commands/inc/command.h"
+#include "commands/inc/ids.h"
+#include "commands/inc/system_iface.h"
+#include "stack/cmd_transport/inc/cmd_transport.h"
+
+#ifdef __ZEPHYR__
+#include <zephyr/kernel.h>
+static struct k_spinlock s_lock;
+#define TBL_LOCK() k_spinlock_key_t key = k_spin_lock(&s_lock)
+#define TBL_UNLOCK() k_spin_unlock(&s_lock, key)
+#else
+#define TBL_LOCK()
+#define TBL_UNLOCK()
+#endif
+
+/* [cmd:2][status:2][len:2][offset:4] */
+#define STREAM_HDR_LEN 10u
+
+struct flash_stream {
+    struct cmd_transport_binding *b; /* NULL when the slot is free */
+    uint32_t addr;
+    uint32_t len;
+    uint32_t off; /* offset of the chunk in msg */
+    uint16_t chunk;
+    bool ready;          /* msg holds the chunk at off */
+    bool failed;         /* msg is the error marker */
+    uint16_t ready_len;  /* data bytes in msg */
+    size_t msg_len;
+    uint8_t msg[STREAM_HDR_LEN + GRLC_FLASH_STREAM_CHUNK_MAX];
+};
+
+static struct flash_stream s_streams[GRLC_FLASH_STREAM_MAX];
+
+static struct flash_stream *find(const struct cmd_transport_binding *b)
+{
+    struct flash_stream *s = NULL;
+    TBL_LOCK();
+    for (size_t i = 0; i < GRLC_FLASH_STREAM_MAX; ++i) {
+        if (s_streams[i].b == b) {
+            s = &s_streams[i];
+            break;
+        }
+    }
+    TBL_UNLOCK();
+    return s;
+}
+
+static void release(struct flash_stream *s)
+{
+    TBL_LOCK();
+    s->b = NULL;
+    TBL_UNLOCK();
+}
+
+/** @brief Read the chunk at s->off into the message buffer. */
+static void read_ahead(struct flash_stream *s)
+{
+    s->ready = false;
+    if (s->off >= s->len) {
+        return;
+    }
+    uint32_t left = s->len - s->off;
+    uint16_t n = (left < s->chunk) ? (uint16_t)left : s->chunk;
+    bool ok = grlc_sys_flash_read(s->addr + s->off, &s->msg[STREAM_HDR_LEN], n) == n;
+    for (int i = 0; i < 4; ++i) {
+        s->msg[6 + i] = (uint8_t)(s->off >> (8 * i));
+    }
+    uint16_t body = (uint16_t)(4u + (ok ? n : 0u));
+    (void)grlc_cmd_pack_response(CMD_ID_FLASH_READ_STREAM,
+                                 (uint16_t)(ok ? CMD_STATUS_OK : CMD_STATUS_ERR_INTERNAL), NULL,
+                                 body, s->msg, sizeof(s->msg), &s->msg_len);
+    s->ready_len = n;
+    s->failed = !ok;
+    s->ready = true;
+}
+
+int grlc_flash_stream_start(struct cmd_transport_binding *b, uint32_t addr, uint32_t len,
+                            uint16_t chunk, uint16_t *chunk_out)
+{
+    if (!b || len == 0 || (uint64_t)addr + len > 0x100000000ull ||
+        (chunk && (chunk < GRLC_FLASH_STREAM_CHUNK_MIN || chunk > GRLC_FLASH_STREAM_CHUNK_MAX))) {
+        return -EINVAL;
+    }
+    (void)grlc_flash_stream_cancel(b);
+    struct flash_stream *s = NULL;
+    TBL_LOCK();
+    for (size_t i = 0; i < GRLC_FLASH_STREAM_MAX; ++i) {
+        if (!s_streams[i].b) {
+            s = &s_streams[i];
+            s->b = b;
+            break;
+        }
+    }
+    TBL_UNLOCK();
+    if (!s) {
+        return -ENOMEM;
+    }
+    s->addr = addr;
+    s->len = len;
+    s->off = 0;
+    s->chunk = chunk ? chunk : GRLC_FLASH_STREAM_CHUNK_MAX;
+    if (chunk_out) {
+        *chunk_out = s->chunk;
+    }
+    read_ahead(s);
+    return 0;
+}
+
+uint32_t grlc_flash_stream_cancel(struct cmd_transport_binding *b)
+{
+    struct flash_stream *s = b ? find(b) : NULL;
+    if (!s) {
+        return 0;
+    }
+    uint32_t left = s->len - s->off;
+    release(s);
+    return left;
+}
+
+uint32_t grlc_flash_stream_service(struct cmd_transport_binding *b)
+{
+    struct flash_stream *s = b ? find(b) : NULL;
+    if (!s) {
+        return GRLC_FLASH_STREAM_IDLE;
+    }
+    while (s->ready) {
+        if (!grlc_cmd_transport_notify(b, GRLC_FLASH_STREAM_SESSION, s->msg, s->msg_len)) {
+            return GRLC_FLASH_STREAM_RETRY_MS;
+        }
+        if (s->failed) {
+            break;
+        }
+        /* The transport copied the chunk: read the next one while this one goes out */
+        s->off += s->ready_len;
+        read_ahead(s);
+    }
+    release(s);
+    return GRLC_FLASH_STREAM_IDLE;
+}
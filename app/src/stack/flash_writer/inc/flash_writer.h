@@ -0,0 +1,96 @@
+/**
+ * @brief Sequential page-buffered flash programming with erase-ahead.
+ *
+ * One write session at a time covers a page-aligned region. Data arrives in
+ * order in chunks of any size and is gathered into a page buffer; every full
+ * page is programmed in one flash write. Erasing is done one page ahead of
+ * the page being filled, from grlc_flash_writer_service() on a link's
+ * service loop, i.e. after the command response has been queued. The erase
+ * then overlaps the host sending the next chunk instead of delaying the
+ * chunk that completes a page. If the service has not run yet the erase
+ * happens before programming, so correctness does not depend on it.
+ *
+ * A CRC-32 (proto/crc32) of the data is kept as it arrives; after finishing,
+ * the region can be read back and checked against it.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef GRLC_FLASH_WRITER_PAGE_MAX
+/** Largest supported erase page (nRF52: 4 KB) */
+#define GRLC_FLASH_WRITER_PAGE_MAX 4096u
+#endif
+/** Program granularity; the last partial block is padded with 0xFF */
+#define GRLC_FLASH_WRITER_ALIGN 4u
+
+/** @brief Session state. */
+struct flash_writer_status {
+    bool active;        /**< Session open (begun, not finished or aborted) */
+    bool finished;      /**< Last session completed; addr/len/crc describe it */
+    uint32_t addr;      /**< Region start */
+    uint32_t len;       /**< Region length */
+    uint32_t written;   /**< Bytes accepted so far (next expected offset) */
+    uint32_t crc;       /**< CRC-32 of the accepted bytes */
+    uint32_t erased_to; /**< End of the erased part of the region */
+};
+
+/**
+ * @brief Open a session, replacing any previous one.
+ *
+ * Erases the first page before returning.
+ *
+ * @param addr Page-aligned start address.
+ * @param len  Bytes that will be written (>= 1).
+ * @return 0 on success, -EINVAL if the region is misaligned, not writable or the
+ *         page size is unsupported, -EIO if the erase failed.
+ */
+int grlc_flash_writer_begin(uint32_t addr, uint32_t len);
+
+/**
+ * @brief Append data at @p offset.
+ * @param offset Must equal the bytes accepted so far.
+ * @return 0 on success, -ENOENT without a session, -EINVAL on an offset mismatch or
+ *         overflow, -EIO on a flash error (the session is aborted).
+ */
+int grlc_flash_writer_write(uint32_t offset, const uint8_t *data, size_t len);
+
+/**
+ * @brief Program the last partial page and close the session.
+ * @param[out] len Bytes written.
+ * @param[out] crc CRC-32 of the written data.
+ * @return 0 on success, -ENOENT without a session, -EINVAL if fewer than the
+ *         announced bytes arrived, -EIO on a flash error.
+ */
+int grlc_flash_writer_finish(uint32_t *len, uint32_t *crc);
+
+/**
+ * @brief CRC-32 of the last finished region, read back from flash.
+ * @return 0 on success, -ENOENT if no session has finished, -EIO on a read error.
+ */
+int grlc_flash_writer_verify(uint32_t *crc);
+
+/** @brief Drop the open session (already written pages stay as they are). */
+void grlc_flash_writer_abort(void);
+
+/** @brief Snapshot the session state. */
+void grlc_flash_writer_get(struct flash_writer_status *st);
+
+/**
+ * @brief Erase the next page ahead of the write position, if due.
+ *
+ * Called from the link service loops after pending responses are handled.
+ *
+ * @return true if a page was erased.
+ */
+bool grlc_flash_writer_service(void);
+
+#ifdef __cplusplus
+}
+#endif
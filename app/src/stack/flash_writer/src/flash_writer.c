@@ -0,0 +1,209 @@
+#include "stack/flash_writer/inc/flash_writer.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "commands/inc/system_iface.h"
+#include "proto/inc/crc32.h"
+
+#ifdef __ZEPHYR__
+#include <zephyr/kernel.h>
+/* Flash erase/program can take tens of milliseconds: sleep, don't spin */
+static K_MUTEX_DEFINE(s_lock);
+#define WRITER_LOCK() k_mutex_lock(&s_lock, K_FOREVER)
+#define WRITER_UNLOCK() k_mutex_unlock(&s_lock)
+#else
+#define WRITER_LOCK()
+#define WRITER_UNLOCK()
+#endif
+
+struct flash_writer_state {
+    bool active;
+    bool finished;
+    uint32_t addr;
+    uint32_t len;
+    uint32_t end; /* addr + len rounded up to whole pages */
+    uint32_t page;
+    uint32_t written;
+    uint32_t crc;
+    uint32_t erased_to;
+    uint32_t prog; /* start of the page being gathered in buf */
+    uint32_t fill;
+    uint8_t buf[GRLC_FLASH_WRITER_PAGE_MAX];
+};
+
+static struct flash_writer_state s_w;
+
+/** @brief Erase pages until [.., upto) is erased. */
+static int erase_until(uint32_t upto)
+{
+    while (s_w.erased_to < upto) {
+        if (grlc_sys_flash_erase(s_w.erased_to, s_w.page) != 0) {
+            return -EIO;
+        }
+        s_w.erased_to += s_w.page;
+    }
+    return 0;
+}
+
+/** @brief Program the gathered bytes at s_w.prog, padding to the write block. */
+static int program_buf(void)
+{
+    uint32_t n = s_w.fill;
+    while (n % GRLC_FLASH_WRITER_ALIGN) {
+        s_w.buf[n++] = 0xFF;
+    }
+    if (erase_until(s_w.prog + s_w.page) != 0 ||
+        grlc_sys_flash_write(s_w.prog, s_w.buf, n) != 0) {
+        return -EIO;
+    }
+    s_w.prog += s_w.page;
+    s_w.fill = 0;
+    return 0;
+}
+
+int grlc_flash_writer_begin(uint32_t addr, uint32_t len)
+{
+    size_t page = grlc_sys_flash_page_size();
+    if (page == 0 || page > GRLC_FLASH_WRITER_PAGE_MAX || addr % page || len == 0) {
+        return -EINVAL;
+    }
+    uint64_t end = (uint64_t)addr + ((uint64_t)len + page - 1) / page * page;
+    if (end > UINT32_MAX || !grlc_sys_flash_writable(addr, (size_t)(end - addr))) {
+        return -EINVAL;
+    }
+    WRITER_LOCK();
+    memset(&s_w, 0, offsetof(struct flash_writer_state, buf));
+    s_w.addr = addr;
+    s_w.len = len;
+    s_w.end = (uint32_t)end;
+    s_w.page = (uint32_t)page;
+    s_w.erased_to = addr;
+    s_w.prog = addr;
+    int rc = erase_until(addr + s_w.page);
+    s_w.active = (rc == 0);
+    WRITER_UNLOCK();
+    return rc;
+}
+
+int grlc_flash_writer_write(uint32_t offset, const uint8_t *data, size_t len)
+{
+    int rc = 0;
+    WRITER_LOCK();
+    if (!s_w.active) {
+        rc = -ENOENT;
+    } else if (offset != s_w.written || len > s_w.len - s_w.written || (len && !data)) {
+        rc = -EINVAL;
+    }
+    while (rc == 0 && len) {
+        uint32_t take = s_w.page - s_w.fill;
+        if (take > len) {
+            take = (uint32_t)len;
+        }
+        memcpy(&s_w.buf[s_w.fill], data, take);
+        s_w.crc = crc32_ieee_update(s_w.crc, data, take);
+        s_w.fill += take;
+        s_w.written += take;
+        data += take;
+        len -= take;
+        if (s_w.fill == s_w.page) {
+            rc = program_buf();
+        }
+    }
+    if (rc == -EIO) {
+        s_w.active = false;
+    }
+    WRITER_UNLOCK();
+    return rc;
+}
+
+int grlc_flash_writer_finish(uint32_t *len, uint32_t *crc)
+{
+    int rc = 0;
+    WRITER_LOCK();
+    if (!s_w.active) {
+        rc = -ENOENT;
+    } else if (s_w.written != s_w.len) {
+        rc = -EINVAL;
+    } else {
+        if (s_w.fill) {
+            rc = program_buf();
+        }
+        s_w.active = false;
+        s_w.finished = (rc == 0);
+        if (len) {
+            *len = s_w.len;
+        }
+        if (crc) {
+            *crc = s_w.crc;
+        }
+    }
+    WRITER_UNLOCK();
+    return rc;
+}
+
+int grlc_flash_writer_verify(uint32_t *crc)
+{
+    int rc = 0;
+    WRITER_LOCK();
+    if (!s_w.finished) {
+        rc = -ENOENT;
+    } else {
+        /* The page buffer is idle once the session is finished */
+        uint32_t c = 0;
+        for (uint32_t off = 0; off < s_w.len && rc == 0; off += s_w.page) {
+            uint32_t n = s_w.len - off;
+            if (n > s_w.page) {
+                n = s_w.page;
+            }
+            if (grlc_sys_flash_read(s_w.addr + off, s_w.buf, n) != n) {
+                rc = -EIO;
+            } else {
+                c = crc32_ieee_update(c, s_w.buf, n);
+            }
+        }
+        if (rc == 0 && crc) {
+            *crc = c;
+        }
+    }
+    WRITER_UNLOCK();
+    return rc;
+}
+
+void grlc_flash_writer_abort(void)
+{
+    WRITER_LOCK();
+    s_w.active = false;
+    s_w.finished = false;
+    WRITER_UNLOCK();
+}
+
+void grlc_flash_writer_get(struct flash_writer_status *st)
+{
+    if (!st) {
+        return;
+    }
+    WRITER_LOCK();
+    st->active = s_w.active;
+    st->finished = s_w.finished;
+    st->addr = s_w.addr;
+    st->len = s_w.len;
+    st->written = s_w.written;
+    st->crc = s_w.crc;
+    st->erased_to = s_w.erased_to;
+    WRITER_UNLOCK();
+}
+
+bool grlc_flash_writer_service(void)
+{
+    bool erased = false;
+    WRITER_LOCK();
+    /* Keep exactly one erased page ahead of the one being gathered */
+    if (s_w.active && s_w.erased_to < s_w.end && s_w.erased_to <= s_w.prog + s_w.page) {
+        /* On failure the write path retries the erase and reports the error */
+        erased = (erase_until(s_w.erased_to + s_w.page) == 0);
+    }
+    WRITER_UNLOCK();
+    return erased;
+}
@@ -0,0 +1,104 @@
+/**
+ * @brief Push-style telemetry: periodic or on-change notifications per link.
+ *
+ * A host subscribes a topic on the link it is talking over; the link's
+ * service loop then sends unsolicited messages on session
+ * GRLC_CMD_NOTIFY_SESSION_BASE | id (RESP flag clear), packed like a
+ * SUBSCRIBE response with status OK:
+ *   [id:1][topic:1][seq:2][t_ms:4][topic data]      (little-endian)
+ *
+ * Topic data:
+ *   TMP119      [n:1][n x (addr7:1, raw:2)]   raw LSB 1/128 °C
+ *   UPTIME      [uptime_ms:8]
+ *   LINK_STATS  [frames_ok, frames_crc_err, frames_sync_drop, messages_ok,
+ *                messages_dropped, uart tx_bytes, rx_bytes, tx_overruns,
+ *                rx_overruns, framing_errors]  (10 x u32)
+ *
+ * With a non-zero threshold a TMP119 subscription is checked every period
+ * but only sent when a sensor moved by at least threshold raw counts (or a
+ * sensor appeared/disappeared). Other topics ignore the threshold.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct cmd_transport_binding;
+
+#ifndef GRLC_TELEMETRY_MAX_SUBS
+/** Subscriptions across all links */
+#define GRLC_TELEMETRY_MAX_SUBS 8u
+#endif
+
+#define GRLC_TELEMETRY_PERIOD_MIN_MS 20u
+#define GRLC_TELEMETRY_PERIOD_MAX_MS 60000u
+/** Retry delay when the link was busy at the due time */
+#define GRLC_TELEMETRY_RETRY_MS 5u
+/** grlc_telemetry_service() result when nothing is subscribed on the link */
+#define GRLC_TELEMETRY_IDLE UINT32_MAX
+
+enum telemetry_topic {
+    TELEMETRY_TOPIC_TMP119 = 1,
+    TELEMETRY_TOPIC_UPTIME = 2,
+    TELEMETRY_TOPIC_LINK_STATS = 3,
+};
+
+/** @brief One subscription as reported by grlc_telemetry_list(). */
+struct telemetry_sub_info {
+    uint8_t id;
+    uint8_t topic;
+    uint16_t period_ms;
+    uint16_t threshold;
+    uint16_t seq;     /**< Sequence number of the next notification */
+    uint32_t delayed; /**< Due notifications that had to wait for the link */
+};
+
+/**
+ * @brief Subscribe a topic on a link.
+ *
+ * The first notification is sent on the link's next service pass.
+ *
+ * @param b         Link the notifications go to.
+ * @param topic     enum telemetry_topic.
+ * @param period_ms Send (or, with a threshold, check) period.
+ * @param threshold On-change threshold in raw units, 0 for purely periodic.
+ * @param[out] id   Subscription id (1..GRLC_TELEMETRY_MAX_SUBS).
+ * @return 0 on success, -EINVAL on bad arguments, -ENOMEM if the table is full.
+ */
+int grlc_telemetry_subscribe(struct cmd_transport_binding *b, uint8_t topic, uint16_t period_ms,
+                             uint16_t threshold, uint8_t *id);
+
+/**
+ * @brief Drop one subscription of a link, or all of them.
+ * @param b  Link that owns the subscription.
+ * @param id Subscription id, 0 for every subscription on @p b.
+ * @return 0 on success, -ENOENT if @p id is not subscribed on @p b.
+ */
+int grlc_telemetry_unsubscribe(struct cmd_transport_binding *b, uint8_t id);
+
+/**
+ * @brief List a link's subscriptions.
+ * @return Number of entries written (at most @p cap).
+ */
+size_t grlc_telemetry_list(const struct cmd_transport_binding *b, struct telemetry_sub_info *out,
+                           size_t cap);
+
+/**
+ * @brief Send whatever is due on a link.
+ *
+ * Called from the link's service loop, on the thread that owns the
+ * transport, after its TX pump and pending-response tick.
+ *
+ * @param b      Link to service.
+ * @param now_ms Current uptime in milliseconds.
+ * @return Milliseconds until the next notification is due, or GRLC_TELEMETRY_IDLE.
+ */
+uint32_t grlc_telemetry_service(struct cmd_transport_binding *b, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,262 @@
+#include "stack/telemetry/inc/telemetry.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "commands/inc/command.h"
+#include "commands/inc/ids.h"
+#include "commands/inc/system_iface.h"
+#include "drivers/tmp119/inc/tmp119.h"
+#include "drivers/uart/inc/uart.h"
+#include "proto/inc/transport.h"
+#include "stack/cmd_transport/inc/cmd_transport.h"
+#include "utils/schedule/inc/schedule.h"
+
+#ifdef __ZEPHYR__
+#include <zephyr/kernel.h>
+static struct k_spinlock s_lock;
+#define TBL_LOCK() k_spinlock_key_t key = k_spin_lock(&s_lock)
+#define TBL_UNLOCK() k_spin_unlock(&s_lock, key)
+#else
+#define TBL_LOCK()
+#define TBL_UNLOCK()
+#endif
+
+#define TELEMETRY_HDR_LEN 8u
+#define TELEMETRY_DATA_MAX 40u /* LINK_STATS: 10 x u32 */
+
+struct telemetry_sub {
+    struct cmd_transport_binding *b; /* NULL when the slot is free */
+    uint8_t topic;
+    uint16_t period_ms;
+    uint16_t threshold;
+    uint16_t seq;
+    uint32_t next_due;
+    uint32_t delayed;
+    bool due_now;
+    bool waiting; /* current notification already counted in delayed */
+    uint8_t last_mask;
+    int16_t last_raw[TMP119_MAX_DEVICES];
+};
+
+static struct telemetry_sub s_subs[GRLC_TELEMETRY_MAX_SUBS];
+
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static bool topic_valid(uint8_t topic)
+{
+    return topic == TELEMETRY_TOPIC_TMP119 || topic == TELEMETRY_TOPIC_UPTIME ||
+           topic == TELEMETRY_TOPIC_LINK_STATS;
+}
+
+int grlc_telemetry_subscribe(struct cmd_transport_binding *b, uint8_t topic, uint16_t period_ms,
+                             uint16_t threshold, uint8_t *id)
+{
+    if (!b || !topic_valid(topic) || period_ms < GRLC_TELEMETRY_PERIOD_MIN_MS ||
+        period_ms > GRLC_TELEMETRY_PERIOD_MAX_MS) {
+        return -EINVAL;
+    }
+    int rc = -ENOMEM;
+    TBL_LOCK();
+    for (size_t i = 0; i < GRLC_TELEMETRY_MAX_SUBS; ++i) {
+        struct telemetry_sub *s = &s_subs[i];
+        if (s->b) {
+            continue;
+        }
+        memset(s, 0, sizeof(*s));
+        s->topic = topic;
+        s->period_ms = period_ms;
+        s->threshold = (topic == TELEMETRY_TOPIC_TMP119) ? threshold : 0;
+        s->due_now = true;
+        s->b = b;
+        if (id) {
+            *id = (uint8_t)(i + 1);
+        }
+        rc = 0;
+        break;
+    }
+    TBL_UNLOCK();
+    return rc;
+}
+
+int grlc_telemetry_unsubscribe(struct cmd_transport_binding *b, uint8_t id)
+{
+    int rc = (id == 0) ? 0 : -ENOENT;
+    TBL_LOCK();
+    for (size_t i = 0; i < GRLC_TELEMETRY_MAX_SUBS; ++i) {
+        if (s_subs[i].b == b && (id == 0 || id == i + 1)) {
+            s_subs[i].b = NULL;
+            rc = 0;
+        }
+    }
+    TBL_UNLOCK();
+    return rc;
+}
+
+size_t grlc_telemetry_list(const struct cmd_transport_binding *b, struct telemetry_sub_info *out,
+                           size_t cap)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < GRLC_TELEMETRY_MAX_SUBS && n < cap; ++i) {
+        const struct telemetry_sub *s = &s_subs[i];
+        if (!s->b || s->b != b) {
+            continue;
+        }
+        out[n].id = (uint8_t)(i + 1);
+        out[n].topic = s->topic;
+        out[n].period_ms = s->period_ms;
+        out[n].threshold = s->threshold;
+        out[n].seq = s->seq;
+        out[n].delayed = s->delayed;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Read every verified TMP119 into @p data.
+ * @return Bytes written; 0 if an on-change subscription saw no change.
+ */
+static size_t encode_tmp119(struct telemetry_sub *s, uint8_t *data, uint8_t *mask_out,
+                            int16_t *raw_out)
+{
+    uint8_t n = 0;
+    uint8_t mask = 0;
+    bool changed = (s->threshold == 0);
+    for (uint8_t a = TMP119_ADDR_FIRST; a <= TMP119_ADDR_LAST; ++a) {
+        uint8_t idx = (uint8_t)(a - TMP119_ADDR_FIRST);
+        uint16_t raw = 0;
+        if (!grlc_tmp119_is_present(a) || grlc_tmp119_read_temperature_raw(a, &raw) != 0) {
+            continue;
+        }
+        mask |= (uint8_t)(1u << idx);
+        raw_out[idx] = (int16_t)raw;
+        int32_t delta = (int32_t)(int16_t)raw - (int32_t)s->last_raw[idx];
+        if (delta < 0) {
+            delta = -delta;
+        }
+        if (delta >= (int32_t)s->threshold) {
+            changed = true;
+        }
+        uint8_t *p = &data[1 + 3 * n];
+        p[0] = a;
+        p[1] = (uint8_t)(raw & 0xFFu);
+        p[2] = (uint8_t)(raw >> 8);
+        n++;
+    }
+    if (mask != s->last_mask) {
+        changed = true;
+    }
+    *mask_out = mask;
+    if (!changed) {
+        return 0;
+    }
+    data[0] = n;
+    return 1u + 3u * n;
+}
+
+static size_t encode_link_stats(const struct cmd_transport_binding *b, uint8_t *data)
+{
+    struct transport_stats ts;
+    struct uart_statistics us;
+    grlc_transport_get_stats(b->t, &ts);
+    grlc_uart_get_statistics(&us);
+    const uint32_t v[10] = {ts.frames_ok,  ts.frames_crc_err, ts.frames_sync_drop,
+                            ts.messages_ok, ts.messages_dropped, us.tx_bytes,
+                            us.rx_bytes,   us.tx_overruns,    us.rx_overruns,
+                            us.framing_errors};
+    for (size_t i = 0; i < 10; ++i) {
+        put_u32(&data[4 * i], v[i]);
+    }
+    return sizeof(v);
+}
+
+/**
+ * @brief Build and send one notification.
+ * @return 1 if sent, 0 if the link was busy, -1 if nothing changed.
+ */
+static int notify(struct telemetry_sub *s, uint8_t id, uint32_t now_ms)
+{
+    uint8_t body[TELEMETRY_HDR_LEN + TELEMETRY_DATA_MAX];
+    uint8_t *data = &body[TELEMETRY_HDR_LEN];
+    uint8_t mask = 0;
+    int16_t raw[TMP119_MAX_DEVICES] = {0};
+    size_t n = 0;
+
+    switch (s->topic) {
+    case TELEMETRY_TOPIC_TMP119:
+        n = encode_tmp119(s, data, &mask, raw);
+        if (n == 0) {
+            return -1;
+        }
+        break;
+    case TELEMETRY_TOPIC_UPTIME: {
+        uint64_t ms = grlc_sys_uptime_ms();
+        put_u32(&data[0], (uint32_t)ms);
+        put_u32(&data[4], (uint32_t)(ms >> 32));
+        n = 8;
+        break;
+    }
+    default:
+        n = encode_link_stats(s->b, data);
+        break;
+    }
+    body[0] = id;
+    body[1] = s->topic;
+    body[2] = (uint8_t)(s->seq & 0xFFu);
+    body[3] = (uint8_t)(s->seq >> 8);
+    put_u32(&body[4], now_ms);
+
+    uint8_t msg[6 + sizeof(body)];
+    size_t msg_len = 0;
+    (void)grlc_cmd_pack_response(CMD_ID_SUBSCRIBE, (uint16_t)CMD_STATUS_OK, body,
+                                 (uint16_t)(TELEMETRY_HDR_LEN + n), msg, sizeof(msg), &msg_len);
+    if (!grlc_cmd_transport_notify(s->b, (uint16_t)(GRLC_CMD_NOTIFY_SESSION_BASE | id), msg,
+                                   msg_len)) {
+        return 0;
+    }
+    s->seq++;
+    if (s->topic == TELEMETRY_TOPIC_TMP119) {
+        s->last_mask = mask;
+        memcpy(s->last_raw, raw, sizeof(s->last_raw));
+    }
+    return 1;
+}
+
+uint32_t grlc_telemetry_service(struct cmd_transport_binding *b, uint32_t now_ms)
+{
+    uint32_t wait = GRLC_TELEMETRY_IDLE;
+    for (size_t i = 0; i < GRLC_TELEMETRY_MAX_SUBS; ++i) {
+        struct telemetry_sub *s = &s_subs[i];
+        if (!s->b || s->b != b) {
+            continue;
+        }
+        if (grlc_sched_due(s->next_due, s->due_now, now_ms)) {
+            if (notify(s, (uint8_t)(i + 1), now_ms) == 0) {
+                /* Link busy: keep the due time and retry shortly */
+                if (!s->waiting) {
+                    s->delayed++;
+                    s->waiting = true;
+                }
+                if (wait > GRLC_TELEMETRY_RETRY_MS) {
+                    wait = GRLC_TELEMETRY_RETRY_MS;
+                }
+                continue;
+            }
+            s->next_due = grlc_sched_advance(s->next_due, s->due_now, now_ms, s->period_ms);
+            s->due_now = false;
+            s->waiting = false;
+        }
+        uint32_t left = s->next_due - now_ms;
+        if (left < wait) {
+            wait = left;
+        }
+    }
+    return wait;
+}
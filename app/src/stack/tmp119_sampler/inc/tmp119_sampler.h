@@ -0,0 +1,155 @@
+/**
+ * @brief Background TMP119 sampling into an on-device history ring.
+ *
+ * While running, every verified TMP119 (0x48..0x4B) is read once per period
+ * and each reading is stored with its uptime timestamp. Samples carry a
+ * monotonically increasing sequence number so a host can fetch the newest N
+ * or everything since its last fetch in one transfer. One sensor can instead
+ * be sampled at its conversion rate from the ALERT data-ready interrupt.
+ *
+ * Optionally every sample also feeds a per-sensor aggregator (utils/aggregate)
+ * and each closed block is kept as a summary window in a second ring, so a
+ * host can fetch one record per block instead of every sample.
+ *
+ * Wire layout of one sample (little-endian):
+ *   [t_ms:4][addr7:1][raw:2]   raw = temperature register, LSB 1/128 °C
+ * Packed history (utils/delta streams, one per column):
+ *   [t_len:2][a_len:2][t stream][addr stream][raw stream]
+ *   t:    per-sensor order-2 residual of t_ms, coded with order 0
+ *   addr: addr7, coded with order 1
+ *   raw:  per-sensor order-1 residual of raw, coded with order 0
+ *   "Per-sensor" keys predictor state by addr7 & 3 (0x48..0x4B).
+ * Wire layout of one window:
+ *   [t_ms:4][addr7:1][count:2][min:2][max:2][mean:2][ma:2][ema:2]   (raw units)
+ *   t_ms is the time of the block's last sample.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef GRLC_TMP119_SAMPLER_DEPTH
+/** Samples kept in RAM (all sensors share the ring) */
+#define GRLC_TMP119_SAMPLER_DEPTH 256u
+#endif
+
+/** TMP119 shortest conversion cycle is 15.5 ms (Table 8-6) */
+#define GRLC_TMP119_SAMPLER_PERIOD_MIN_MS 20u
+#define GRLC_TMP119_SAMPLER_PERIOD_MAX_MS 60000u
+#define GRLC_TMP119_SAMPLE_WIRE_LEN 7u
+
+#ifndef GRLC_TMP119_WINDOW_DEPTH
+/** Summary windows kept in RAM (all sensors share the ring) */
+#define GRLC_TMP119_WINDOW_DEPTH 64u
+#endif
+#define GRLC_TMP119_WINDOW_WIRE_LEN 17u
+
+/** @brief Sampler state. */
+struct tmp119_sampler_status {
+    uint16_t period_ms; /**< 0 when stopped */
+    uint32_t next_seq;  /**< Sequence number the next sample will get */
+    uint16_t stored;    /**< Samples currently retained */
+    uint32_t errors;    /**< Failed sensor reads since boot */
+    uint8_t drdy_addr;  /**< Sensor sampled from data-ready interrupts, 0 if none */
+    uint16_t agg_block; /**< Samples per summary window, 0 when aggregation is off */
+    uint32_t next_window_seq; /**< Sequence number the next window will get */
+};
+
+/**
+ * @brief Start, retime or stop sampling.
+ *
+ * @param period_ms Sampling period, 0 to stop. History is kept across restarts.
+ * @return 0 on success, -EINVAL if out of range.
+ */
+int grlc_tmp119_sampler_set(uint16_t period_ms);
+
+/**
+ * @brief Take a round of samples if one is due.
+ *
+ * Called by the sampler's work item; exposed so host tests can drive time.
+ *
+ * @param now_ms Current uptime in milliseconds.
+ * @return Number of samples stored by this call.
+ */
+int grlc_tmp119_sampler_poll(uint32_t now_ms);
+
+/**
+ * @brief Record one sensor on every conversion instead of on the timer.
+ *
+ * Uses grlc_tmp119_drdy_enable(); the periodic poll then skips that sensor.
+ * Samples are pushed from the I2C completion interrupt.
+ *
+ * @param addr7  Sensor wired to the ALERT pin (0 with @p enable false: any).
+ * @param enable true to attach, false to detach.
+ * @return 0 on success, -ENODEV if the sensor was not verified, -ENOTSUP
+ *         without an ALERT pin, other negative errno on failure.
+ */
+int grlc_tmp119_sampler_set_drdy(uint8_t addr7, bool enable);
+
+/** @brief Report the sampler state. */
+void grlc_tmp119_sampler_get(struct tmp119_sampler_status *st);
+
+/**
+ * @brief Encode retained samples in wire format.
+ *
+ * Selects samples with sequence >= @p since_seq (clamped to the oldest one
+ * retained) and, if more than @p max qualify, keeps the newest @p max.
+ * Output is oldest first.
+ *
+ * @param since_seq  First sequence number of interest (0 for "newest @p max").
+ * @param max        Upper bound on samples returned.
+ * @param out        Destination buffer.
+ * @param cap        Capacity of @p out in bytes.
+ * @param[out] first_seq Sequence number of the first encoded sample.
+ * @return Number of samples encoded.
+ */
+size_t grlc_tmp119_sampler_encode(uint32_t since_seq, size_t max, uint8_t *out, size_t cap,
+                                  uint32_t *first_seq);
+
+/**
+ * @brief Encode retained samples as packed delta streams.
+ *
+ * Same selection as grlc_tmp119_sampler_encode(); if the packed form of
+ * all selected samples exceeds @p cap, the oldest are dropped until it fits.
+ *
+ * @param since_seq  First sequence number of interest.
+ * @param max        Upper bound on samples returned.
+ * @param out        Destination buffer.
+ * @param cap        Capacity of @p out in bytes.
+ * @param[out] first_seq Sequence number of the first encoded sample.
+ * @param[out] out_len   Bytes written.
+ * @return Number of samples encoded.
+ */
+size_t grlc_tmp119_sampler_encode_packed(uint32_t since_seq, size_t max, uint8_t *out,
+                                         size_t cap, uint32_t *first_seq, size_t *out_len);
+
+/**
+ * @brief Configure on-device aggregation.
+ *
+ * Resets every sensor's aggregator; retained windows are kept.
+ *
+ * @param block     Samples per window per sensor, 0 to turn aggregation off.
+ * @param ma_len    Moving-average length (1..GRLC_AGG_MA_MAX).
+ * @param ema_shift Exponential filter constant k, y += (x - y) / 2^k.
+ * @return 0 on success, -EINVAL if out of range.
+ */
+int grlc_tmp119_sampler_set_aggregate(uint16_t block, uint8_t ma_len, uint8_t ema_shift);
+
+/**
+ * @brief Encode retained summary windows in wire format.
+ *
+ * Same selection rules as grlc_tmp119_sampler_encode(), over the window ring.
+ *
+ * @return Number of windows encoded.
+ */
+size_t grlc_tmp119_sampler_encode_windows(uint32_t since_seq, size_t max, uint8_t *out,
+                                          size_t cap, uint32_t *first_seq);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,397 @@
+#include "stack/tmp119_sampler/inc/tmp119_sampler.h"
+
+#include <errno.h>
+#include <stdbool.h>
+
+#include "commands/inc/system_iface.h"
+#include "drivers/tmp119/inc/tmp119.h"
+#include "utils/aggregate/inc/aggregate.h"
+#include "utils/delta/inc/delta.h"
+#include "utils/schedule/inc/schedule.h"
+
+#ifdef __ZEPHYR__
+#include <zephyr/kernel.h>
+static struct k_spinlock s_lock;
+#define RING_LOCK() k_spinlock_key_t key = k_spin_lock(&s_lock)
+#define RING_UNLOCK() k_spin_unlock(&s_lock, key)
+#else
+#define RING_LOCK()
+#define RING_UNLOCK()
+#endif
+
+struct tmp119_sample {
+    uint32_t t_ms;
+    int16_t raw;
+    uint8_t addr7;
+};
+
+static struct tmp119_sample s_ring[GRLC_TMP119_SAMPLER_DEPTH];
+static uint32_t s_next_seq;
+static uint32_t s_errors;
+static uint16_t s_period_ms;
+static uint32_t s_next_due;
+static bool s_due_now;
+static uint8_t s_drdy_addr; /* 0 when no sensor is interrupt-driven */
+
+struct tmp119_window {
+    uint32_t t_ms;
+    uint8_t addr7;
+    aggregate_window_t w;
+};
+
+/* Aggregation: one aggregator per sensor, closed blocks go to the window ring */
+static aggregate_t s_agg[TMP119_MAX_DEVICES];
+static uint16_t s_agg_block; /* 0 = off */
+static struct tmp119_window s_windows[GRLC_TMP119_WINDOW_DEPTH];
+static uint32_t s_next_window;
+
+/** Record a closed block; called with the ring lock held. */
+static void window_push(uint32_t t_ms, uint8_t addr7, const aggregate_window_t *w)
+{
+    struct tmp119_window *e = &s_windows[s_next_window % GRLC_TMP119_WINDOW_DEPTH];
+    e->t_ms = t_ms;
+    e->addr7 = addr7;
+    e->w = *w;
+    s_next_window++;
+}
+
+static void ring_push(uint32_t t_ms, uint8_t addr7, int16_t raw)
+{
+    RING_LOCK();
+    struct tmp119_sample *s = &s_ring[s_next_seq % GRLC_TMP119_SAMPLER_DEPTH];
+    s->t_ms = t_ms;
+    s->addr7 = addr7;
+    s->raw = raw;
+    s_next_seq++;
+    aggregate_window_t w;
+    if (s_agg_block && addr7 >= TMP119_ADDR_FIRST && addr7 <= TMP119_ADDR_LAST &&
+        grlc_agg_push(&s_agg[addr7 - TMP119_ADDR_FIRST], raw, &w)) {
+        window_push(t_ms, addr7, &w);
+    }
+    RING_UNLOCK();
+}
+
+static uint32_t stored_of(uint32_t next, uint32_t depth)
+{
+    return (next < depth) ? next : depth;
+}
+
+static uint32_t ring_stored(void)
+{
+    return stored_of(s_next_seq, GRLC_TMP119_SAMPLER_DEPTH);
+}
+
+/**
+ * @brief Pick the entries to return from a ring.
+ * @return Number of entries; *first is the sequence number of the first one.
+ */
+static size_t select_range(uint32_t next, uint32_t stored, uint32_t since_seq, size_t max,
+                           uint32_t *first)
+{
+    uint32_t oldest = next - stored;
+    uint32_t f = (since_seq > oldest) ? since_seq : oldest;
+    if (f > next) {
+        f = next;
+    }
+    size_t n = next - f;
+    if (n > max) {
+        f = next - (uint32_t)max;
+        n = max;
+    }
+    *first = f;
+    return n;
+}
+
+int grlc_tmp119_sampler_poll(uint32_t now_ms)
+{
+    if (s_period_ms == 0) {
+        return 0;
+    }
+    if (!grlc_sched_due(s_next_due, s_due_now, now_ms)) {
+        return 0;
+    }
+    s_next_due = grlc_sched_advance(s_next_due, s_due_now, now_ms, s_period_ms);
+    s_due_now = false;
+
+    int n = 0;
+    for (uint8_t a = TMP119_ADDR_FIRST; a <= TMP119_ADDR_LAST; ++a) {
+        if (!grlc_tmp119_is_present(a) || a == s_drdy_addr) {
+            continue;
+        }
+        uint16_t raw = 0;
+        if (grlc_tmp119_read_temperature_raw(a, &raw) != 0) {
+            s_errors++;
+            continue;
+        }
+        ring_push(now_ms, a, (int16_t)raw);
+        n++;
+    }
+    return n;
+}
+
+#ifdef __ZEPHYR__
+/* Blocking I2C reads: runs on the TMP119 work queue, not the system one. */
+static void sampler_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(s_sampler_work, sampler_work_fn);
+
+static void sampler_work_fn(struct k_work *work)
+{
+    ARG_UNUSED(work);
+    if (s_period_ms == 0) {
+        return;
+    }
+    (void)grlc_tmp119_sampler_poll(k_uptime_get_32());
+    int32_t wait = (int32_t)(s_next_due - k_uptime_get_32());
+    (void)k_work_schedule_for_queue(grlc_tmp119_workq(), &s_sampler_work,
+                                    K_MSEC(wait > 0 ? wait : 0));
+}
+#endif
+
+int grlc_tmp119_sampler_set(uint16_t period_ms)
+{
+    if (period_ms != 0 && (period_ms < GRLC_TMP119_SAMPLER_PERIOD_MIN_MS ||
+                           period_ms > GRLC_TMP119_SAMPLER_PERIOD_MAX_MS)) {
+        return -EINVAL;
+    }
+    s_period_ms = period_ms;
+    s_due_now = (period_ms != 0);
+#ifdef __ZEPHYR__
+    if (period_ms) {
+        (void)k_work_reschedule_for_queue(grlc_tmp119_workq(), &s_sampler_work, K_NO_WAIT);
+    } else {
+        (void)k_work_cancel_delayable(&s_sampler_work);
+    }
+#endif
+    return 0;
+}
+
+void grlc_tmp119_sampler_get(struct tmp119_sampler_status *st)
+{
+    if (!st) {
+        return;
+    }
+    RING_LOCK();
+    st->period_ms = s_period_ms;
+    st->next_seq = s_next_seq;
+    st->stored = (uint16_t)ring_stored();
+    st->errors = s_errors;
+    st->drdy_addr = s_drdy_addr;
+    st->agg_block = s_agg_block;
+    st->next_window_seq = s_next_window;
+    RING_UNLOCK();
+}
+
+/** Data-ready reading (ISR context on hardware). */
+static void sampler_drdy_cb(uint8_t addr7, int16_t raw, void *user)
+{
+    (void)user;
+    ring_push((uint32_t)grlc_sys_uptime_ms(), addr7, raw);
+}
+
+int grlc_tmp119_sampler_set_drdy(uint8_t addr7, bool enable)
+{
+    if (!enable) {
+        if (s_drdy_addr && (addr7 == 0 || addr7 == s_drdy_addr)) {
+            grlc_tmp119_drdy_disable();
+            s_drdy_addr = 0;
+        }
+        return 0;
+    }
+    if (!grlc_tmp119_is_present(addr7)) {
+        return -ENODEV;
+    }
+    int rc = grlc_tmp119_drdy_enable(addr7, sampler_drdy_cb, NULL);
+    s_drdy_addr = (rc == 0) ? addr7 : 0;
+    return rc;
+}
+
+size_t grlc_tmp119_sampler_encode(uint32_t since_seq, size_t max, uint8_t *out, size_t cap,
+                                  uint32_t *first_seq)
+{
+    if (cap / GRLC_TMP119_SAMPLE_WIRE_LEN < max) {
+        max = cap / GRLC_TMP119_SAMPLE_WIRE_LEN;
+    }
+    RING_LOCK();
+    uint32_t first = 0;
+    size_t n = select_range(s_next_seq, ring_stored(), since_seq, max, &first);
+    for (size_t i = 0; i < n; ++i) {
+        const struct tmp119_sample *s = &s_ring[(first + i) % GRLC_TMP119_SAMPLER_DEPTH];
+        uint8_t *p = &out[i * GRLC_TMP119_SAMPLE_WIRE_LEN];
+        for (int b = 0; b < 4; ++b) {
+            p[b] = (uint8_t)(s->t_ms >> (8 * b));
+        }
+        p[4] = s->addr7;
+        p[5] = (uint8_t)((uint16_t)s->raw & 0xFFu);
+        p[6] = (uint8_t)((uint16_t)s->raw >> 8);
+    }
+    RING_UNLOCK();
+    if (first_seq) {
+        *first_seq = first;
+    }
+    return n;
+}
+
+int grlc_tmp119_sampler_set_aggregate(uint16_t block, uint8_t ma_len, uint8_t ema_shift)
+{
+    aggregate_t a;
+    if (block && grlc_agg_init(&a, block, ma_len, ema_shift) != 0) {
+        return -EINVAL;
+    }
+    RING_LOCK();
+    for (size_t i = 0; i < TMP119_MAX_DEVICES; ++i) {
+        if (block) {
+            s_agg[i] = a;
+        }
+    }
+    s_agg_block = block;
+    RING_UNLOCK();
+    return 0;
+}
+
+static void put_i16(uint8_t *p, int16_t v)
+{
+    p[0] = (uint8_t)((uint16_t)v & 0xFFu);
+    p[1] = (uint8_t)((uint16_t)v >> 8);
+}
+
+size_t grlc_tmp119_sampler_encode_windows(uint32_t since_seq, size_t max, uint8_t *out,
+                                          size_t cap, uint32_t *first_seq)
+{
+    if (cap / GRLC_TMP119_WINDOW_WIRE_LEN < max) {
+        max = cap / GRLC_TMP119_WINDOW_WIRE_LEN;
+    }
+    RING_LOCK();
+    uint32_t first = 0;
+    size_t n = select_range(s_next_window, stored_of(s_next_window, GRLC_TMP119_WINDOW_DEPTH),
+                            since_seq, max, &first);
+    for (size_t i = 0; i < n; ++i) {
+        const struct tmp119_window *e = &s_windows[(first + i) % GRLC_TMP119_WINDOW_DEPTH];
+        uint8_t *p = &out[i * GRLC_TMP119_WINDOW_WIRE_LEN];
+        for (int b = 0; b < 4; ++b) {
+            p[b] = (uint8_t)(e->t_ms >> (8 * b));
+        }
+        p[4] = e->addr7;
+        p[5] = (uint8_t)(e->w.count & 0xFFu);
+        p[6] = (uint8_t)(e->w.count >> 8);
+        put_i16(&p[7], e->w.min);
+        put_i16(&p[9], e->w.max);
+        put_i16(&p[11], e->w.mean);
+        put_i16(&p[13], e->w.ma);
+        put_i16(&p[15], e->w.ema);
+    }
+    RING_UNLOCK();
+    if (first_seq) {
+        *first_seq = first;
+    }
+    return n;
+}
+
+/* Packed history: the selection is taken under the ring lock and packed
+ * straight from the ring without holding it. A sample overwritten meanwhile
+ * shows up as the ring having moved more than its depth past the first
+ * packed sequence number; the pack is then redone on the newer selection.
+ */
+#define PACK_RETRIES 4
+
+enum { COL_T, COL_ADDR, COL_RAW };
+
+static size_t pack_column(int col, uint32_t first, size_t n, uint8_t *out, size_t cap)
+{
+    uint32_t t1[4] = {0}, t2[4] = {0};
+    uint8_t tc[4] = {0};
+    int16_t r1[4] = {0};
+    delta_enc_t e;
+    grlc_delta_enc_init(&e, (col == COL_ADDR) ? 1u : 0u, out, cap);
+    for (size_t i = 0; i < n; ++i) {
+        const struct tmp119_sample *s = &s_ring[(first + i) % GRLC_TMP119_SAMPLER_DEPTH];
+        uint8_t k = s->addr7 & 3u;
+        if (col == COL_T) {
+            uint32_t pred = (tc[k] == 0) ? 0u : (tc[k] == 1) ? t1[k] : 2u * t1[k] - t2[k];
+            grlc_delta_enc_push(&e, (int32_t)(s->t_ms - pred));
+            t2[k] = t1[k];
+            t1[k] = s->t_ms;
+            if (tc[k] < 2) {
+                tc[k]++;
+            }
+        } else if (col == COL_ADDR) {
+            grlc_delta_enc_push(&e, s->addr7);
+        } else {
+            grlc_delta_enc_push(&e, (int32_t)s->raw - r1[k]);
+            r1[k] = s->raw;
+        }
+    }
+    return grlc_delta_enc_finish(&e);
+}
+
+static size_t packed_size(uint32_t first, size_t n)
+{
+    return 4u + pack_column(COL_T, first, n, NULL, 0) + pack_column(COL_ADDR, first, n, NULL, 0) +
+           pack_column(COL_RAW, first, n, NULL, 0);
+}
+
+static size_t pack_range(uint32_t first, size_t n, uint8_t *out, size_t cap)
+{
+    if (cap < 4) {
+        return 0;
+    }
+    size_t t_len = pack_column(COL_T, first, n, &out[4], cap - 4);
+    size_t a_len = pack_column(COL_ADDR, first, n, &out[4 + t_len], cap - 4 - t_len);
+    size_t r_len =
+        pack_column(COL_RAW, first, n, &out[4 + t_len + a_len], cap - 4 - t_len - a_len);
+    out[0] = (uint8_t)(t_len & 0xFFu);
+    out[1] = (uint8_t)(t_len >> 8);
+    out[2] = (uint8_t)(a_len & 0xFFu);
+    out[3] = (uint8_t)(a_len >> 8);
+    return 4 + t_len + a_len + r_len;
+}
+
+/** True if nothing from @p first on has been overwritten since it was selected. */
+static bool range_intact(uint32_t first)
+{
+    RING_LOCK();
+    bool ok = (s_next_seq - first) <= GRLC_TMP119_SAMPLER_DEPTH;
+    RING_UNLOCK();
+    return ok;
+}
+
+size_t grlc_tmp119_sampler_encode_packed(uint32_t since_seq, size_t max, uint8_t *out,
+                                         size_t cap, uint32_t *first_seq, size_t *out_len)
+{
+    uint32_t first = 0;
+    size_t n = 0;
+    size_t len = 0;
+    for (int attempt = 0; attempt < PACK_RETRIES; ++attempt) {
+        {
+            RING_LOCK();
+            n = select_range(s_next_seq, ring_stored(), since_seq, max, &first);
+            RING_UNLOCK();
+        }
+
+        /* Largest newest-suffix that fits; size grows monotonically with the count */
+        size_t lo = 0, hi = n;
+        while (lo < hi) {
+            size_t mid = (lo + hi + 1) / 2;
+            if (packed_size(first + (uint32_t)(n - mid), mid) <= cap) {
+                lo = mid;
+            } else {
+                hi = mid - 1;
+            }
+        }
+        first += (uint32_t)(n - lo);
+        n = lo;
+        len = pack_range(first, n, out, cap);
+        if (range_intact(first)) {
+            break;
+        }
+        /* Overrun while packing; report nothing unless a retry succeeds */
+        n = 0;
+        len = pack_range(first, 0, out, cap);
+    }
+    if (first_seq) {
+        *first_seq = first;
+    }
+    if (out_len) {
+        *out_len = len;
+    }
+    return n;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file aggregate.h
+ * @brief Fixed-point aggregation of int16 sample streams
+ *
+ * One aggregator tracks, per stream:
+ *  - block statistics (count, min, max, rounded mean) over windows of N samples,
+ *  - a moving average over the last M samples (M <= GRLC_AGG_MA_MAX),
+ *  - an exponential filter y += (x - y) / 2^k, kept in Q16 with a rounding shift so
+ *    it settles on a constant input for every k.
+ * All arithmetic is integer; no division per sample except when a window closes.
+ */
+
+#ifndef AGGREGATE_H
+#define AGGREGATE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef GRLC_AGG_MA_MAX
+#define GRLC_AGG_MA_MAX 32u
+#endif
+#define GRLC_AGG_EMA_SHIFT_MAX 12u
+
+/** @brief Summary emitted when a block closes. */
+typedef struct {
+    uint16_t count; /**< Samples in the block */
+    int16_t min;
+    int16_t max;
+    int16_t mean; /**< Block mean, rounded to nearest */
+    int16_t ma;   /**< Moving average at the end of the block */
+    int16_t ema;  /**< Exponential filter at the end of the block */
+} aggregate_window_t;
+
+/** @brief Aggregator state. */
+typedef struct {
+    uint16_t block;    /**< Samples per window */
+    uint8_t ma_len;    /**< Moving-average length */
+    uint8_t ema_shift; /**< Filter constant k */
+    int16_t ma_buf[GRLC_AGG_MA_MAX];
+    uint8_t ma_pos;
+    uint8_t ma_fill;
+    int32_t ma_sum;
+    int32_t ema_q16;
+    bool ema_init;
+    uint16_t count;
+    int16_t min;
+    int16_t max;
+    int32_t sum;
+} aggregate_t;
+
+/**
+ * @brief Initialize an aggregator.
+ * @param a         Aggregator.
+ * @param block     Samples per window (>= 1).
+ * @param ma_len    Moving-average length (1..GRLC_AGG_MA_MAX).
+ * @param ema_shift Filter constant k (0..GRLC_AGG_EMA_SHIFT_MAX; 0 = no filtering).
+ * @return 0 on success, -1 on invalid parameters.
+ */
+int grlc_agg_init(aggregate_t *a, uint16_t block, uint8_t ma_len, uint8_t ema_shift);
+
+/** @brief Forget all samples, keeping the configuration. */
+void grlc_agg_reset(aggregate_t *a);
+
+/**
+ * @brief Add one sample.
+ * @param a   Aggregator.
+ * @param x   Sample.
+ * @param out Filled when this sample closes a window (may be NULL).
+ * @return true if a window closed.
+ */
+bool grlc_agg_push(aggregate_t *a, int16_t x, aggregate_window_t *out);
+
+/** @brief Current moving average (0 before the first sample). */
+int16_t grlc_agg_ma(const aggregate_t *a);
+
+/** @brief Current exponential filter output (0 before the first sample). */
+int16_t grlc_agg_ema(const aggregate_t *a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AGGREGATE_H */
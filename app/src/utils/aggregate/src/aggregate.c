@@ -0,0 +1,102 @@
+#include "utils/aggregate/inc/aggregate.h"
+
+#include <string.h>
+
+/* Round-to-nearest signed division (d > 0), halves away from zero */
+static int16_t div_round(int32_t n, int32_t d)
+{
+    return (int16_t)((n >= 0) ? (n + d / 2) / d : -((-n + d / 2) / d));
+}
+
+int grlc_agg_init(aggregate_t *a, uint16_t block, uint8_t ma_len, uint8_t ema_shift)
+{
+    if (!a || block == 0 || ma_len == 0 || ma_len > GRLC_AGG_MA_MAX ||
+        ema_shift > GRLC_AGG_EMA_SHIFT_MAX) {
+        return -1;
+    }
+    a->block = block;
+    a->ma_len = ma_len;
+    a->ema_shift = ema_shift;
+    grlc_agg_reset(a);
+    return 0;
+}
+
+void grlc_agg_reset(aggregate_t *a)
+{
+    memset(a->ma_buf, 0, sizeof(a->ma_buf));
+    a->ma_pos = 0;
+    a->ma_fill = 0;
+    a->ma_sum = 0;
+    a->ema_q16 = 0;
+    a->ema_init = false;
+    a->count = 0;
+    a->sum = 0;
+    a->min = INT16_MAX;
+    a->max = INT16_MIN;
+}
+
+bool grlc_agg_push(aggregate_t *a, int16_t x, aggregate_window_t *out)
+{
+    /* Moving average: running sum over a ring of the last ma_len samples */
+    a->ma_sum += x - a->ma_buf[a->ma_pos];
+    a->ma_buf[a->ma_pos] = x;
+    a->ma_pos = (uint8_t)((a->ma_pos + 1u) % a->ma_len);
+    if (a->ma_fill < a->ma_len) {
+        a->ma_fill++;
+    }
+
+    /* Exponential filter in Q16 (int16 * 2^16 fits int32; the gap needs 33 bits).
+     * Round the shifted gap half away from zero on both sides: a floor shift
+     * would leave a dead band of up to 2^k/2^16 counts below a rising input.
+     */
+    int32_t xq = (int32_t)x * 65536;
+    if (!a->ema_init) {
+        a->ema_q16 = xq;
+        a->ema_init = true;
+    } else {
+        int64_t d = (int64_t)xq - a->ema_q16;
+        int64_t half = a->ema_shift ? ((int64_t)1 << (a->ema_shift - 1)) : 0;
+        d = (d >= 0) ? (d + half) >> a->ema_shift : -((-d + half) >> a->ema_shift);
+        a->ema_q16 += (int32_t)d;
+    }
+
+    if (x < a->min) {
+        a->min = x;
+    }
+    if (x > a->max) {
+        a->max = x;
+    }
+    a->sum += x;
+    a->count++;
+    if (a->count < a->block) {
+        return false;
+    }
+    if (out) {
+        out->count = a->count;
+        out->min = a->min;
+        out->max = a->max;
+        out->mean = div_round(a->sum, a->count);
+        out->ma = grlc_agg_ma(a);
+        out->ema = grlc_agg_ema(a);
+    }
+    a->count = 0;
+    a->sum = 0;
+    a->min = INT16_MAX;
+    a->max = INT16_MIN;
+    return true;
+}
+
+int16_t grlc_agg_ma(const aggregate_t *a)
+{
+    return a->ma_fill ? div_round(a->ma_sum, a->ma_fill) : 0;
+}
+
+int16_t grlc_agg_ema(const aggregate_t *a)
+{
+    if (!a->ema_init) {
+        return 0;
+    }
+    /* As div_round(), widened: the Q16 state spans the whole int32 range */
+    int64_t q = a->ema_q16;
+    return (int16_t)((q >= 0) ? (q + 32768) >> 16 : -((-q + 32768) >> 16));
+}
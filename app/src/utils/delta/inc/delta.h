@@ -0,0 +1,78 @@
+/**
+ * @file delta.h
+ * @brief Zigzag-varint delta codec with run-length coded repeats
+ *
+ * Each value is replaced by its residual against a predictor:
+ *   order 0: 0 (values coded as-is)
+ *   order 1: previous value
+ *   order 2: 2 * previous - the one before (constant slope costs nothing)
+ * The first values of a stream are predicted from zeros, so the stream
+ * starts with its base value. Arithmetic wraps modulo 2^32.
+ *
+ * Tokens are unsigned LEB128 varints:
+ *   (zigzag(residual) << 1)     one non-zero residual
+ *   (run << 1) | 1              run >= 1 zero residuals
+ * so residuals in -32..31 take one byte and a run of up to 63 repeats
+ * takes one byte.
+ */
+
+#ifndef DELTA_H
+#define DELTA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GRLC_DELTA_ORDER_MAX 2u
+/** Longest token: 33 significant bits */
+#define GRLC_DELTA_TOKEN_MAX 5u
+
+/** @brief Incremental encoder state. */
+typedef struct {
+    uint8_t *out; /**< Destination, or NULL to only count bytes */
+    size_t cap;
+    size_t len; /**< Bytes produced so far (may exceed cap; excess is not written) */
+    uint8_t order;
+    uint32_t count;
+    uint32_t p1;
+    uint32_t p2;
+    uint32_t run; /**< Pending zero residuals */
+} delta_enc_t;
+
+/**
+ * @brief Start a stream.
+ * @param e     Encoder.
+ * @param order Predictor order (0..GRLC_DELTA_ORDER_MAX).
+ * @param out   Destination buffer, or NULL for a size-only pass.
+ * @param cap   Capacity of @p out.
+ */
+void grlc_delta_enc_init(delta_enc_t *e, uint8_t order, uint8_t *out, size_t cap);
+
+/** @brief Append one value. */
+void grlc_delta_enc_push(delta_enc_t *e, int32_t v);
+
+/**
+ * @brief Flush the pending run.
+ * @return Stream length in bytes; larger than the capacity if the stream did not fit.
+ */
+size_t grlc_delta_enc_finish(delta_enc_t *e);
+
+/**
+ * @brief Decode exactly @p n values.
+ * @param in    Stream bytes.
+ * @param len   Available bytes.
+ * @param order Predictor order used by the encoder.
+ * @param out   Decoded values.
+ * @param n     Number of values to decode.
+ * @return Bytes consumed, or 0 if the stream is truncated or malformed.
+ */
+size_t grlc_delta_decode(const uint8_t *in, size_t len, uint8_t order, int32_t *out, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DELTA_H */
@@ -0,0 +1,109 @@
+#include "utils/delta/inc/delta.h"
+
+static uint32_t predict(uint8_t order, uint32_t count, uint32_t p1, uint32_t p2)
+{
+    if (order == 0 || count == 0) {
+        return 0;
+    }
+    if (order == 1 || count == 1) {
+        return p1;
+    }
+    return 2u * p1 - p2;
+}
+
+static void put_varint(delta_enc_t *e, uint64_t v)
+{
+    do {
+        uint8_t b = (uint8_t)(v & 0x7Fu);
+        v >>= 7;
+        if (v) {
+            b |= 0x80u;
+        }
+        if (e->out && e->len < e->cap) {
+            e->out[e->len] = b;
+        }
+        e->len++;
+    } while (v);
+}
+
+void grlc_delta_enc_init(delta_enc_t *e, uint8_t order, uint8_t *out, size_t cap)
+{
+    e->out = out;
+    e->cap = out ? cap : 0;
+    e->len = 0;
+    e->order = (order > GRLC_DELTA_ORDER_MAX) ? GRLC_DELTA_ORDER_MAX : order;
+    e->count = 0;
+    e->p1 = 0;
+    e->p2 = 0;
+    e->run = 0;
+}
+
+void grlc_delta_enc_push(delta_enc_t *e, int32_t v)
+{
+    uint32_t r = (uint32_t)v - predict(e->order, e->count, e->p1, e->p2);
+    e->p2 = e->p1;
+    e->p1 = (uint32_t)v;
+    e->count++;
+    if (r == 0) {
+        e->run++;
+        return;
+    }
+    if (e->run) {
+        put_varint(e, ((uint64_t)e->run << 1) | 1u);
+        e->run = 0;
+    }
+    /* zigzag: 0,-1,1,-2,... -> 0,1,2,3,... */
+    uint32_t zz = (r << 1) ^ (uint32_t)-(int32_t)(r >> 31);
+    put_varint(e, (uint64_t)zz << 1);
+}
+
+size_t grlc_delta_enc_finish(delta_enc_t *e)
+{
+    if (e->run) {
+        put_varint(e, ((uint64_t)e->run << 1) | 1u);
+        e->run = 0;
+    }
+    return e->len;
+}
+
+size_t grlc_delta_decode(const uint8_t *in, size_t len, uint8_t order, int32_t *out, size_t n)
+{
+    size_t pos = 0;
+    size_t i = 0;
+    uint32_t p1 = 0, p2 = 0;
+    if (order > GRLC_DELTA_ORDER_MAX) {
+        return 0;
+    }
+    while (i < n) {
+        uint64_t tok = 0;
+        unsigned shift = 0;
+        uint8_t b;
+        do {
+            if (pos >= len || shift > 7u * (GRLC_DELTA_TOKEN_MAX - 1u)) {
+                return 0;
+            }
+            b = in[pos++];
+            tok |= (uint64_t)(b & 0x7Fu) << shift;
+            shift += 7;
+        } while (b & 0x80u);
+
+        uint64_t reps = 1;
+        uint32_t r = 0;
+        if (tok & 1u) {
+            reps = tok >> 1;
+            if (reps == 0 || reps > n - i) {
+                return 0;
+            }
+        } else {
+            uint32_t zz = (uint32_t)(tok >> 1);
+            r = (zz >> 1) ^ (uint32_t)-(int32_t)(zz & 1u);
+        }
+        for (; reps; --reps) {
+            uint32_t v = predict(order, (uint32_t)i, p1, p2) + r;
+            out[i++] = (int32_t)v;
+            p2 = p1;
+            p1 = v;
+        }
+    }
+    return pos;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file schedule.h
+ * @brief Fixed-rate deadlines on a wrapping 32-bit millisecond clock
+ *
+ * A periodic job keeps its next due time and a "due now" flag that forces
+ * an immediate run (just started or reconfigured). Deadlines advance by
+ * exactly one period so the average rate does not drift with handler
+ * latency; after a stall longer than a period the schedule restarts from
+ * now instead of bursting to catch up.
+ */
+
+#ifndef SCHEDULE_H
+#define SCHEDULE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief True when a job with deadline @p next_due should run at @p now_ms. */
+bool grlc_sched_due(uint32_t next_due, bool due_now, uint32_t now_ms);
+
+/**
+ * @brief Deadline after a run at @p now_ms.
+ * @param next_due  Deadline that just fired.
+ * @param due_now   The run was forced; the schedule restarts from @p now_ms.
+ * @param now_ms    Time of the run.
+ * @param period_ms Period (> 0).
+ * @return The next deadline.
+ */
+uint32_t grlc_sched_advance(uint32_t next_due, bool due_now, uint32_t now_ms, uint32_t period_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEDULE_H */
@@ -0,0 +1,15 @@
+#include "utils/schedule/inc/schedule.h"
+
+bool grlc_sched_due(uint32_t next_due, bool due_now, uint32_t now_ms)
+{
+    return due_now || (int32_t)(now_ms - next_due) >= 0;
+}
+
+uint32_t grlc_sched_advance(uint32_t next_due, bool due_now, uint32_t now_ms, uint32_t period_ms)
+{
+    /* Resynchronize instead of bursting after a stall */
+    if (due_now || (uint32_t)(now_ms - next_due) >= period_ms) {
+        return now_ms + period_ms;
+    }
+    return next_due + period_ms;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file sha256.h
+ * @brief Incremental SHA-256 (FIPS 180-4)
+ *
+ * Small portable implementation for hashing data as it streams in (e.g. a
+ * firmware image arriving in chunks). No dynamic allocation; about 100 bytes
+ * of state.
+ */
+
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GRLC_SHA256_DIGEST_LEN 32u
+#define GRLC_SHA256_BLOCK_LEN 64u
+
+/** @brief Hash state. */
+typedef struct {
+    uint32_t h[8];
+    uint64_t total; /**< Bytes hashed so far */
+    uint8_t block[GRLC_SHA256_BLOCK_LEN];
+    size_t fill; /**< Bytes waiting in block */
+} sha256_ctx_t;
+
+/** @brief Start a new hash. */
+void grlc_sha256_init(sha256_ctx_t *c);
+
+/** @brief Add @p len bytes (any split gives the same digest). */
+void grlc_sha256_update(sha256_ctx_t *c, const uint8_t *data, size_t len);
+
+/**
+ * @brief Finish and write the digest.
+ *
+ * The context must be re-initialized before reuse.
+ */
+void grlc_sha256_final(sha256_ctx_t *c, uint8_t out[GRLC_SHA256_DIGEST_LEN]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHA256_H */
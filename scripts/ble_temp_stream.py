@@ -15,6 +15,9 @@ Examples:
 
   # Customize sampling interval and count
   python3 scripts/ble_temp_stream.py --address <MAC> --interval 0.5 --count 60
+
+  # Let the device sample every 100 ms and fetch the history in batches
+  python3 scripts/ble_temp_stream.py --address <MAC> --history --interval 0.1
 """
 
 import argparse
@@ -41,9 +44,39 @@ def parse_args():
     p.add_argument("--interval", type=float, default=1.0, help="Seconds between readings")
     p.add_argument("--count", type=int, default=0, help="Number of readings (0=forever)")
     p.add_argument("--addr7", type=lambda x: int(x, 0), default=0x48, help="TMP119 7-bit I2C address (default 0x48)")
+    p.add_argument("--history", action="store_true",
+                   help="Sample on the device at --interval and fetch batches from its history ring")
+    p.add_argument("--fetch", type=float, default=5.0, help="Seconds between history fetches")
     return p.parse_args()
 
 
+def stream_history(cc, args):
+    """Run the on-device sampler and print batches; returns when --count readings are shown."""
+    cc.tmp119_sampler_set(max(20, int(args.interval * 1000)))
+    since = cc.tmp119_history(max_samples=0)['next_seq']
+    n = 0
+    try:
+        while True:
+            time.sleep(max(0.1, args.fetch))
+            try:
+                h = cc.tmp119_history(since_seq=since, timeout=3.0)
+            except Exception as e:
+                print(f"WARN: history fetch failed: {e}", file=sys.stderr, flush=True)
+                continue
+            if h['samples'] and h['samples'][0]['seq'] != since:
+                print(f"WARN: {h['samples'][0]['seq'] - since} samples overwritten", file=sys.stderr)
+            since = h['next_seq']
+            for x in h['samples']:
+                if x['addr7'] != args.addr7:
+                    continue
+                print(f"t={x['t_ms'] / 1000.0:10.3f}s | {x['mc'] / 1000.0:.3f} °C", flush=True)
+                n += 1
+                if args.count and n >= args.count:
+                    return
+    finally:
+        cc.tmp119_sampler_set(0)
+
+
 def main():
     _add_fixtures_to_path()
     from ble_io import BLEGarlicDevice, BLEDeviceConfig
@@ -59,6 +92,9 @@ def main():
     print("Connected. Streaming temperature; Ctrl-C to stop.")
     n = 0
     try:
+        if args.history:
+            stream_history(cc, args)
+            return
         while True:
             try:
                 mc = cc.tmp119_read_temp_mc(args.addr7, timeout=2.0)
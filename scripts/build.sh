@@ -1,7 +1,7 @@
 #!/bin/bash
 
 # Build script for nRF52-DK Zephyr application
-# Usage: ./scripts/build.sh [clean|menuconfig]
+# Usage: ./scripts/build.sh [clean|menuconfig|dfu]
 
 set -e
 
@@ -22,6 +22,11 @@ case "$1" in
         echo -e "${YELLOW}Performing clean build...${NC}"
         BUILD_ARGS="--pristine"
         ;;
+    dfu)
+        # MCUboot + signed app image so the DFU command can swap images
+        echo -e "${YELLOW}Building with MCUboot (sysbuild, dfu.conf)...${NC}"
+        BUILD_ARGS="--sysbuild -- -DSB_CONFIG_BOOTLOADER_MCUBOOT=y -DEXTRA_CONF_FILE=dfu.conf"
+        ;;
     menuconfig)
         echo -e "${YELLOW}Opening menuconfig...${NC}"
         cd /projects/garlic/app
@@ -81,6 +86,9 @@ fi
 if [ -f "${BUILD_DIR}/zephyr/zephyr.bin" ]; then
     echo -e "  ${GREEN}✓${NC} BIN: ${BUILD_DIR}/zephyr/zephyr.bin ($(du -h "${BUILD_DIR}/zephyr/zephyr.bin" | cut -f1))"
 fi
+if [ -f "${BUILD_DIR}/app/zephyr/zephyr.signed.bin" ]; then
+    echo -e "  ${GREEN}✓${NC} DFU image: ${BUILD_DIR}/app/zephyr/zephyr.signed.bin"
+fi
 
 # Display memory usage
 echo ""
@@ -13,6 +13,44 @@ NUS_RX_UUID = "6E400002-B5A3-F393-E0A9-E50E24DCCA9E"  # Write
 NUS_TX_UUID = "6E400003-B5A3-F393-E0A9-E50E24DCCA9E"  # Notify
 
 
+BROADCAST_COMPANY_ID = 0xFFFF
+BROADCAST_TEMP_INVALID = -32768
+
+
+def decode_broadcast(mfg: bytes) -> dict:
+    """Decode the sensor broadcast manufacturer data (without the company ID).
+
+    Layout: [ver:1][seq:2][uptime_s:4][n:1][temp_centi_c:2 * n], little-endian.
+    """
+    import struct
+    ver, seq, uptime_s, n = struct.unpack_from('<BHIB', mfg, 0)
+    temps = struct.unpack_from(f'<{n}h', mfg, 8)
+    return {'version': ver, 'seq': seq, 'uptime_s': uptime_s,
+            'temps_c': [None if t == BROADCAST_TEMP_INVALID else t / 100.0 for t in temps]}
+
+
+def scan_broadcasts(duration: float = 5.0, name: Optional[str] = "GarlicDK") -> list[dict]:
+    """Passively collect decoded sensor broadcasts for ``duration`` seconds (no connection)."""
+    from bleak import BleakScanner
+
+    seen: list[dict] = []
+
+    def _cb(device, adv):
+        mfg = adv.manufacturer_data.get(BROADCAST_COMPANY_ID)
+        if mfg is None or (name and (adv.local_name or device.name) not in (None, name)):
+            return
+        entry = decode_broadcast(bytes(mfg))
+        entry['address'] = device.address
+        seen.append(entry)
+
+    async def _run():
+        async with BleakScanner(detection_callback=_cb, scanning_mode='active'):
+            await asyncio.sleep(duration)
+
+    asyncio.run(_run())
+    return seen
+
+
 @dataclass
 class BLEDeviceConfig:
     name: Optional[str] = "GarlicDK"
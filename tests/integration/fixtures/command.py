@@ -1,5 +1,15 @@
+import binascii
+import hashlib
 import struct
-from transport import TransportCodec
+from transport import NOTIFY_SESSION_BASE, TransportCodec
+
+# SUBSCRIBE topics
+TOPIC_TMP119 = 1
+TOPIC_UPTIME = 2
+TOPIC_LINK_STATS = 3
+
+# Session carrying FLASH_READ_STREAM chunks
+FLASH_STREAM_SESSION = 0xFFFF
 
 
 def pack_request(cmd_id: int, payload: bytes) -> bytes:
@@ -16,6 +26,36 @@ def parse_response(data: bytes):
     return cmd_id, status, payload
 
 
+def decode_delta(data: bytes, order: int, n: int):
+    """Decode n values of a device delta stream (utils/delta); returns (values, bytes used)."""
+    vals, pos, p1, p2 = [], 0, 0, 0
+    while len(vals) < n:
+        tok, shift = 0, 0
+        while True:
+            if pos >= len(data):
+                raise ValueError('truncated delta stream')
+            b = data[pos]
+            pos += 1
+            tok |= (b & 0x7F) << shift
+            shift += 7
+            if not b & 0x80:
+                break
+        if tok & 1:
+            reps, r = tok >> 1, 0
+            if reps == 0 or reps > n - len(vals):
+                raise ValueError('bad run length')
+        else:
+            zz = tok >> 1
+            reps, r = 1, (zz >> 1) ^ -(zz & 1)
+        for _ in range(reps):
+            i = len(vals)
+            pred = 0 if order == 0 or i == 0 else p1 if order == 1 or i == 1 else 2 * p1 - p2
+            v = (pred + r) & 0xFFFFFFFF
+            p2, p1 = p1, v
+            vals.append(v - (1 << 32) if v & 0x80000000 else v)
+    return vals, pos
+
+
 class CommandClient:
     def __init__(self, serial_dev):
         self.ser = serial_dev
@@ -24,7 +64,8 @@ class CommandClient:
 
     def _req(self, cmd_id: int, payload: bytes, timeout: float = 1.0):
         sess = self.tx_session
-        self.tx_session = (self.tx_session + 1) & 0xFFFF
+        # Stay below the device's notification sessions (0xFF00..0xFFFF)
+        self.tx_session = self.tx_session + 1 if self.tx_session + 1 < NOTIFY_SESSION_BASE else 1
         msg = pack_request(cmd_id, payload)
         resp_msg = self.t.request(self.ser, sess, msg, timeout=timeout)
         return parse_response(resp_msg)
@@ -48,6 +89,29 @@ class CommandClient:
             raise RuntimeError(f'ECHO failed: {status}')
         return data
 
+    def get_link(self, timeout: float = 1.0) -> tuple[int, bool, int]:
+        _, status, data = self._req(0x0006, struct.pack('<B', 0x00), timeout)
+        if status != 0 or len(data) != 6:
+            raise RuntimeError(f'SET_LINK GET failed: status={status}')
+        baud, flow, state = struct.unpack('<IBB', data)
+        return baud, flow != 0, state
+
+    def set_link(self, baudrate: int, rtscts: bool = False, confirm_ms: int = 1000,
+                 timeout: float = 1.0) -> None:
+        """Switch device and host to a new baud/flow setting and confirm it.
+
+        The device acknowledges at the old rate, switches once the reply has
+        drained, then reverts unless a valid frame arrives within confirm_ms.
+        """
+        payload = struct.pack('<BIBH', 0x01, baudrate, 1 if rtscts else 0, confirm_ms)
+        _, status, _ = self._req(0x0006, payload, timeout)
+        if status != 0:
+            raise RuntimeError(f'SET_LINK failed: status={status}')
+        self.ser.set_link(baudrate, rtscts)
+        self.t = TransportCodec()
+        # Any valid frame at the new rate commits the switch
+        self.get_uptime_ms(timeout)
+
     def flash_read(self, addr: int, length: int, timeout: float = 1.0) -> bytes:
         if not (0 <= addr < (1<<32)):
             raise ValueError('addr out of range')
@@ -59,6 +123,147 @@ class CommandClient:
             raise RuntimeError(f'FLASH_READ failed: status={status}, len={len(data)}')
         return data
 
+    def flash_read_stream(self, addr: int, length: int, chunk: int = 0,
+                          timeout: float = 2.0) -> bytes:
+        """Read any amount of flash with one request (FLASH_READ_STREAM).
+
+        The device answers with the accepted length and then pushes chunk
+        messages on FLASH_STREAM_SESSION until the region is covered;
+        `timeout` bounds the gap between two chunks.
+        """
+        if not (0 <= addr < (1 << 32)) or not (0 < length and addr + length <= (1 << 32)):
+            raise ValueError('addr/length out of range')
+        keep = self.t.keep_notifications
+        self.t.keep_notifications = True
+        other = []
+        try:
+            payload = struct.pack('<IIH', addr, length, chunk)
+            _, status, data = self._req(0x0007, payload, timeout)
+            if status != 0 or len(data) != 6:
+                raise RuntimeError(f'FLASH_READ_STREAM failed: status={status}')
+            out = bytearray(length)
+            got = 0
+            while got < length:
+                msgs = self.t.listen(self.ser, timeout=timeout, count=1)
+                if not msgs:
+                    raise TimeoutError(f'FLASH_READ_STREAM stalled at {got}/{length} bytes')
+                for sess, msg in msgs:
+                    if sess != FLASH_STREAM_SESSION:
+                        other.append((sess, msg))
+                        continue
+                    _, st, body = parse_response(msg)
+                    off = struct.unpack_from('<I', body, 0)[0]
+                    if st != 0:
+                        raise RuntimeError(f'FLASH_READ_STREAM read error at offset {off}')
+                    chunk_data = body[4:]
+                    out[off:off + len(chunk_data)] = chunk_data
+                    got += len(chunk_data)
+            return bytes(out)
+        finally:
+            self.t.notifications.extend(other)
+            self.t.keep_notifications = keep
+
+    def flash_crc(self, addr: int, length: int, timeout: float = 2.0) -> int:
+        """CRC-32 of a flash region computed on the device (same as binascii.crc32)."""
+        _, status, data = self._req(0x000A, struct.pack('<II', addr, length), timeout)
+        if status != 0 or len(data) != 4:
+            raise RuntimeError(f'FLASH_CRC failed: status={status}, len={len(data)}')
+        return struct.unpack('<I', data)[0]
+
+    def flash_erase(self, addr: int, length: int, timeout: float = 5.0) -> None:
+        """Erase whole pages (addr and length page-aligned)."""
+        _, status, _ = self._req(0x0008, struct.pack('<II', addr, length), timeout)
+        if status != 0:
+            raise RuntimeError(f'FLASH_ERASE failed: status={status}')
+
+    def _flash_write_op(self, op: int, args: bytes = b'', timeout: float = 2.0) -> bytes:
+        _, status, data = self._req(0x0009, bytes([op]) + args, timeout)
+        if status != 0:
+            raise RuntimeError(f'FLASH_WRITE op 0x{op:02x} failed: status={status}')
+        return data
+
+    def flash_write_status(self) -> dict:
+        active, addr, length, written, crc = struct.unpack(
+            '<BIIII', self._flash_write_op(0x05))
+        return {'active': bool(active), 'addr': addr, 'len': length, 'written': written,
+                'crc': crc}
+
+    def flash_write(self, addr: int, data: bytes, chunk: int = 1024,
+                    timeout: float = 2.0) -> int:
+        """Program `data` at page-aligned `addr` (FLASH_WRITE session).
+
+        The device erases as it goes. Returns the CRC-32 after checking that
+        the device's running CRC and its read-back both match the data.
+        """
+        page = struct.unpack('<I', self._flash_write_op(
+            0x01, struct.pack('<II', addr, len(data)), timeout=5.0))[0]
+        try:
+            off = 0
+            while off < len(data):
+                piece = data[off:off + chunk]
+                nxt = struct.unpack('<I', self._flash_write_op(
+                    0x02, struct.pack('<I', off) + piece, timeout))[0]
+                if nxt != off + len(piece):
+                    raise RuntimeError(f'FLASH_WRITE DATA at {off}: device is at {nxt}')
+                off = nxt
+            length, crc = struct.unpack('<II', self._flash_write_op(0x03, b'', timeout))
+        except Exception:
+            self._flash_write_op(0x06)
+            raise
+        want = binascii.crc32(data) & 0xFFFFFFFF
+        if length != len(data) or crc != want:
+            raise RuntimeError(f'FLASH_WRITE CRC mismatch: device {crc:08x}, host {want:08x}')
+        readback = struct.unpack('<I', self._flash_write_op(0x04, b'', timeout=5.0))[0]
+        if readback != want:
+            raise RuntimeError(f'FLASH_WRITE verify failed: flash {readback:08x} (page {page})')
+        return crc
+
+    def _dfu_op(self, op: int, args: bytes = b'', timeout: float = 2.0) -> bytes:
+        _, status, data = self._req(0x0010, bytes([op]) + args, timeout)
+        if status != 0:
+            raise RuntimeError(f'DFU op 0x{op:02x} failed: status={status}')
+        return data
+
+    def dfu_status(self) -> dict:
+        active, verified, pending, slot, size, written = struct.unpack(
+            '<BBBIII', self._dfu_op(0x05))
+        return {'active': bool(active), 'verified': bool(verified), 'pending': bool(pending),
+                'slot': slot, 'size': size, 'written': written}
+
+    def dfu_update(self, image: bytes, permanent: bool = False, chunk: int = 1024,
+                   reboot: bool = True, timeout: float = 2.0) -> None:
+        """Send a signed MCUboot image to the secondary slot and swap into it.
+
+        The device hashes the image as it arrives and only accepts it if its
+        CRC-32 and SHA-256 match. With `permanent` False the new image runs as
+        a test swap and must be confirmed with dfu_confirm() after the reboot,
+        otherwise MCUboot reverts it on the next reset.
+        """
+        slot, size = struct.unpack('<II', self._dfu_op(
+            0x01, struct.pack('<I', len(image)), timeout=5.0))
+        try:
+            off = 0
+            while off < len(image):
+                piece = image[off:off + chunk]
+                nxt = struct.unpack('<I', self._dfu_op(
+                    0x02, struct.pack('<I', off) + piece, timeout))[0]
+                if nxt != off + len(piece):
+                    raise RuntimeError(f'DFU DATA at {off}: device is at {nxt}')
+                off = nxt
+            crc = binascii.crc32(image) & 0xFFFFFFFF
+            sha = hashlib.sha256(image).digest()
+            self._dfu_op(0x03, struct.pack('<I', crc) + sha, timeout)
+        except Exception:
+            self._dfu_op(0x06)
+            raise
+        self._dfu_op(0x04, bytes([1 if permanent else 0]))
+        if reboot:
+            self.reboot()
+
+    def dfu_confirm(self) -> None:
+        """Keep the running image after a test swap."""
+        self._dfu_op(0x07)
+
     def reboot(self, timeout: float = 0.3) -> None:
         # Request reboot; device may reboot before ack on serial or BLE.
         try:
@@ -95,8 +300,10 @@ class CommandClient:
             raise RuntimeError(f'I2C write_read failed: status={status}, len={len(data)}')
         return data
 
-    def i2c_scan(self, timeout: float = 1.0) -> list[int]:
-        payload = struct.pack('<BB', 0x10, 0)  # op=0x10, addr ignored
+    def i2c_scan(self, first: int = 0x03, last: int = 0x77, force: bool = False,
+                 first_only: bool = False, timeout: float = 1.0) -> list[int]:
+        flags = (0x01 if force else 0) | (0x02 if first_only else 0)
+        payload = struct.pack('<BBBBB', 0x10, 0, first, last, flags)  # op=0x10, addr ignored
         _, status, data = self._req(0x0100, payload, timeout)
         if status != 0 or len(data) == 0:
             raise RuntimeError(f'I2C scan failed: status={status}, len={len(data)}')
@@ -104,6 +311,29 @@ class CommandClient:
         addrs = list(data[1:1+count])
         return addrs
 
+    def i2c_scan_info(self, timeout: float = 1.0) -> dict:
+        payload = struct.pack('<BB', 0x11, 0)
+        _, status, data = self._req(0x0100, payload, timeout)
+        if status != 0 or len(data) != 21:
+            raise RuntimeError(f'I2C scan info failed: status={status}, len={len(data)}')
+        gen, mode = struct.unpack_from('<IB', data, 0)
+        bitmap = data[5:21]
+        present = [a for a in range(128) if bitmap[a >> 3] & (1 << (a & 7))]
+        return {'generation': gen, 'read_probe': bool(mode & 1), 'present': present}
+
+    def i2c_set_speed(self, hz: int, timeout: float = 1.0) -> None:
+        payload = struct.pack('<BBI', 0x20, 0, hz)
+        _, status, _ = self._req(0x0100, payload, timeout)
+        if status != 0:
+            raise RuntimeError(f'I2C set speed failed: status={status}')
+
+    def i2c_get_speed(self, timeout: float = 1.0) -> int:
+        payload = struct.pack('<BB', 0x21, 0)
+        _, status, data = self._req(0x0100, payload, timeout)
+        if status != 0 or len(data) != 4:
+            raise RuntimeError(f'I2C get speed failed: status={status}, len={len(data)}')
+        return struct.unpack('<I', data)[0]
+
     def tmp119_read_id(self, addr7: int = 0x48, timeout: float = 1.0) -> int:
         _, status, data = self._req(0x0119, struct.pack('<BB', 0x00, addr7 & 0x7F), timeout)
         if status != 0 or len(data) != 2:
@@ -163,14 +393,214 @@ class CommandClient:
         if status != 0:
             raise RuntimeError(f'TMP119 WRITE_OFFSET failed: status={status}')
 
+    def tmp119_refresh(self, addr7: int = 0x48, timeout: float = 1.0) -> None:
+        _, status, _ = self._req(0x0119, struct.pack('<BB', 0x0E, addr7 & 0x7F), timeout)
+        if status != 0:
+            raise RuntimeError(f'TMP119 REFRESH failed: status={status}')
+
+    def tmp119_sampler_set(self, period_ms: int, timeout: float = 1.0) -> None:
+        payload = struct.pack('<BBH', 0x10, 0, period_ms & 0xFFFF)
+        _, status, _ = self._req(0x0119, payload, timeout)
+        if status != 0:
+            raise RuntimeError(f'TMP119 SAMPLER_SET failed: status={status}')
+
+    def tmp119_history(self, max_samples: int = 0xFFFF, since_seq: int = 0,
+                       timeout: float = 2.0) -> dict:
+        """Fetch sampler history; returns next_seq (pass back as since_seq) and samples."""
+        payload = struct.pack('<BBHI', 0x11, 0, max_samples & 0xFFFF, since_seq & 0xFFFFFFFF)
+        _, status, data = self._req(0x0119, payload, timeout)
+        if status != 0 or len(data) < 12:
+            raise RuntimeError(f'TMP119 HISTORY failed: status={status}, len={len(data)}')
+        next_seq, first_seq, period_ms, n = struct.unpack_from('<IIHH', data, 0)
+        samples = []
+        for i in range(n):
+            t_ms, addr7, raw = struct.unpack_from('<IBh', data, 12 + 7 * i)
+            samples.append({'seq': first_seq + i, 't_ms': t_ms, 'addr7': addr7,
+                            'mc': raw * 1000 // 128})
+        return {'next_seq': next_seq, 'period_ms': period_ms, 'samples': samples}
+
+    def tmp119_history_packed(self, max_samples: int = 0xFFFF, since_seq: int = 0,
+                              timeout: float = 2.0) -> dict:
+        """Same as tmp119_history, fetched as delta-coded columns (op 0x16)."""
+        payload = struct.pack('<BBHI', 0x16, 0, max_samples & 0xFFFF, since_seq & 0xFFFFFFFF)
+        _, status, data = self._req(0x0119, payload, timeout)
+        if status != 0 or len(data) < 16:
+            raise RuntimeError(f'TMP119 HISTORY_PACKED failed: status={status}, len={len(data)}')
+        next_seq, first_seq, period_ms, n, t_len, a_len = struct.unpack_from('<IIHHHH', data, 0)
+        t_res, _ = decode_delta(data[16:16 + t_len], 0, n)
+        addrs, _ = decode_delta(data[16 + t_len:16 + t_len + a_len], 1, n)
+        r_res, _ = decode_delta(data[16 + t_len + a_len:], 0, n)
+        # Undo the per-sensor predictors (keyed by addr7 & 3)
+        t_hist, raw_prev, samples = {}, {}, []
+        for i in range(n):
+            k = addrs[i] & 3
+            h = t_hist.setdefault(k, [])
+            pred = 0 if not h else h[-1] if len(h) == 1 else 2 * h[-1] - h[-2]
+            t_ms = (pred + t_res[i]) & 0xFFFFFFFF
+            t_hist[k] = (h + [t_ms])[-2:]
+            raw = ((raw_prev.get(k, 0) + r_res[i] + 0x8000) & 0xFFFF) - 0x8000
+            raw_prev[k] = raw
+            samples.append({'seq': first_seq + i, 't_ms': t_ms, 'addr7': addrs[i],
+                            'mc': raw * 1000 // 128})
+        return {'next_seq': next_seq, 'period_ms': period_ms, 'samples': samples,
+                'packed_len': len(data)}
+
+    def tmp119_data_ready(self, enable: bool, addr7: int = 0x48, timeout: float = 1.0) -> None:
+        payload = struct.pack('<BBB', 0x12, addr7 & 0x7F, 1 if enable else 0)
+        _, status, _ = self._req(0x0119, payload, timeout)
+        if status != 0:
+            raise RuntimeError(f'TMP119 DATA_READY failed: status={status}')
+
+    def tmp119_aggregate_set(self, block: int, ma_len: int = 8, ema_shift: int = 3,
+                             timeout: float = 1.0) -> None:
+        """Summarize every `block` samples per sensor on the device (block=0 turns it off)."""
+        payload = struct.pack('<BBHBB', 0x14, 0, block & 0xFFFF, ma_len, ema_shift)
+        _, status, _ = self._req(0x0119, payload, timeout)
+        if status != 0:
+            raise RuntimeError(f'TMP119 AGGREGATE_SET failed: status={status}')
+
+    def tmp119_windows(self, max_windows: int = 0xFFFF, since_seq: int = 0,
+                       timeout: float = 2.0) -> dict:
+        """Fetch summary windows; values in milli-Celsius, pass next_seq back as since_seq."""
+        payload = struct.pack('<BBHI', 0x15, 0, max_windows & 0xFFFF, since_seq & 0xFFFFFFFF)
+        _, status, data = self._req(0x0119, payload, timeout)
+        if status != 0 or len(data) < 12:
+            raise RuntimeError(f'TMP119 WINDOWS failed: status={status}, len={len(data)}')
+        next_seq, first_seq, block, n = struct.unpack_from('<IIHH', data, 0)
+        windows = []
+        for i in range(n):
+            t_ms, addr7, count, mn, mx, mean, ma, ema = struct.unpack_from(
+                '<IBHhhhhh', data, 12 + 17 * i)
+            w = {'seq': first_seq + i, 't_ms': t_ms, 'addr7': addr7, 'count': count}
+            for k, v in (('min', mn), ('max', mx), ('mean', mean), ('ma', ma), ('ema', ema)):
+                w[k] = v * 1000 // 128
+            windows.append(w)
+        return {'next_seq': next_seq, 'block': block, 'windows': windows}
+
+    def tmp119_oneshot_all(self, timeout: float = 3.0) -> dict:
+        """Convert on all sensors at once; returns t_ms and {addr7: milli-Celsius}."""
+        _, status, data = self._req(0x0119, struct.pack('<BB', 0x13, 0), timeout)
+        if status != 0 or len(data) < 5:
+            raise RuntimeError(f'TMP119 ONESHOT_ALL failed: status={status}')
+        t_ms, n = struct.unpack_from('<IB', data, 0)
+        temps = {}
+        for i in range(n):
+            addr7, raw = struct.unpack_from('<Bh', data, 5 + 3 * i)
+            temps[addr7] = raw * 1000 // 128
+        return {'t_ms': t_ms, 'temps': temps}
+
+    # --- Telemetry subscriptions ---
+    def subscribe(self, topic: int, period_ms: int, threshold: int = 0,
+                  timeout: float = 1.0) -> int:
+        """Subscribe a topic on this link; returns the subscription id.
+
+        With a threshold, TMP119 readings are checked every period but only
+        pushed when a sensor moves by at least that many raw counts (1/128 C).
+        """
+        payload = struct.pack('<BBHH', 0x01, topic, period_ms & 0xFFFF, threshold & 0xFFFF)
+        _, status, data = self._req(0x0300, payload, timeout)
+        if status != 0 or len(data) != 1:
+            raise RuntimeError(f'SUBSCRIBE ADD failed: status={status}')
+        self.t.keep_notifications = True
+        return data[0]
+
+    def unsubscribe(self, sub_id: int = 0, timeout: float = 1.0) -> None:
+        """Drop one subscription, or all of this link's with sub_id=0."""
+        _, status, _ = self._req(0x0300, struct.pack('<BB', 0x02, sub_id & 0xFF), timeout)
+        if status != 0:
+            raise RuntimeError(f'SUBSCRIBE REMOVE failed: status={status}')
+
+    def subscriptions(self, timeout: float = 1.0) -> list[dict]:
+        _, status, data = self._req(0x0300, struct.pack('<B', 0x03), timeout)
+        if status != 0 or len(data) < 1:
+            raise RuntimeError(f'SUBSCRIBE LIST failed: status={status}')
+        out = []
+        for i in range(data[0]):
+            sid, topic, period, thr, seq, delayed = struct.unpack_from('<BBHHHI', data, 1 + 12 * i)
+            out.append({'id': sid, 'topic': topic, 'period_ms': period, 'threshold': thr,
+                        'seq': seq, 'delayed': delayed})
+        return out
+
+    def notifications(self, timeout: float = 1.0, count: int | None = None) -> list[dict]:
+        """Wait for pushed telemetry and decode it."""
+        out = []
+        for _, msg in self.t.listen(self.ser, timeout=timeout, count=count):
+            cmd_id, status, body = parse_response(msg)
+            if cmd_id != 0x0300 or status != 0 or len(body) < 8:
+                continue
+            sid, topic, seq, t_ms = struct.unpack_from('<BBHI', body, 0)
+            data = body[8:]
+            n = {'id': sid, 'topic': topic, 'seq': seq, 't_ms': t_ms}
+            if topic == TOPIC_TMP119 and data:
+                n['temps'] = {}
+                for k in range(data[0]):
+                    addr7, raw = struct.unpack_from('<Bh', data, 1 + 3 * k)
+                    n['temps'][addr7] = raw * 1000 // 128
+            elif topic == TOPIC_UPTIME and len(data) >= 8:
+                n['uptime_ms'] = struct.unpack_from('<Q', data, 0)[0]
+            elif topic == TOPIC_LINK_STATS and len(data) >= 40:
+                keys = ('frames_ok', 'frames_crc_err', 'frames_sync_drop', 'messages_ok',
+                        'messages_dropped', 'uart_tx_bytes', 'uart_rx_bytes', 'uart_tx_overruns',
+                        'uart_rx_overruns', 'uart_framing_errors')
+                n.update(zip(keys, struct.unpack_from('<10I', data, 0)))
+            out.append(n)
+        return out
+
     # --- BLE control ---
     def ble_get_status(self, timeout: float = 1.0) -> tuple[bool, bool]:
+        adv, count = self.ble_get_status_count(timeout)
+        return (adv, count != 0)
+
+    def ble_get_status_count(self, timeout: float = 1.0) -> tuple[bool, int]:
+        """Advertising flag and number of connected centrals."""
         _, status, data = self._req(0x0200, struct.pack('<B', 0x00), timeout)
         if status != 0 or len(data) != 2:
             raise RuntimeError(f'BLE GET_STATUS failed: status={status}')
-        return (data[0] != 0, data[1] != 0)
+        return (data[0] != 0, data[1])
 
     def ble_set_advertising(self, enable: bool, timeout: float = 1.0) -> None:
         _, status, data = self._req(0x0200, struct.pack('<BB', 0x01, 1 if enable else 0), timeout)
         if status != 0:
             raise RuntimeError(f'BLE SET_ADV failed: status={status}')
+
+    def ble_get_link(self, link: int | None = None, timeout: float = 1.0) -> dict:
+        req = struct.pack('<B', 0x02) + (b'' if link is None else struct.pack('<B', link))
+        _, status, data = self._req(0x0200, req, timeout)
+        if status != 0 or len(data) != 10:
+            raise RuntimeError(f'BLE GET_LINK failed: status={status}')
+        mtu, chunk, tx_len, rx_len, tx_phy, rx_phy = struct.unpack('<HHHHBB', data)
+        return {'att_mtu': mtu, 'tx_chunk': chunk, 'tx_data_len': tx_len,
+                'rx_data_len': rx_len, 'tx_phy': tx_phy, 'rx_phy': rx_phy}
+
+    BLE_PROFILES = {'interactive': 0, 'bulk': 1, 'idle': 2, 'auto': 0xFF}
+
+    def ble_get_conn(self, link: int | None = None, timeout: float = 1.0) -> dict:
+        req = struct.pack('<B', 0x03) + (b'' if link is None else struct.pack('<B', link))
+        _, status, data = self._req(0x0200, req, timeout)
+        if status != 0 or len(data) != 8:
+            raise RuntimeError(f'BLE GET_CONN failed: status={status}')
+        interval, latency, sup_to, profile, auto = struct.unpack('<HHHBB', data)
+        return {'interval_ms': interval * 1.25, 'latency': latency, 'timeout_ms': sup_to * 10,
+                'profile': profile, 'auto': auto != 0}
+
+    def ble_set_broadcast(self, enable: bool, interval_ms: int | None = None,
+                          timeout: float = 1.0) -> None:
+        req = struct.pack('<BB', 0x05, 1 if enable else 0)
+        if interval_ms is not None:
+            req += struct.pack('<H', interval_ms)
+        _, status, _ = self._req(0x0200, req, timeout)
+        if status != 0:
+            raise RuntimeError(f'BLE SET_BROADCAST failed: status={status}')
+
+    def ble_get_broadcast(self, timeout: float = 1.0) -> dict:
+        _, status, data = self._req(0x0200, struct.pack('<B', 0x06), timeout)
+        if status != 0 or len(data) != 6:
+            raise RuntimeError(f'BLE GET_BROADCAST failed: status={status}')
+        en, interval, seq, sensors = struct.unpack('<BHHB', data)
+        return {'enabled': en != 0, 'interval_ms': interval, 'seq': seq, 'sensors': sensors}
+
+    def ble_set_profile(self, profile: str, timeout: float = 1.0) -> None:
+        code = self.BLE_PROFILES[profile]
+        _, status, _ = self._req(0x0200, struct.pack('<BB', 0x04, code), timeout)
+        if status != 0:
+            raise RuntimeError(f'BLE SET_PROFILE failed: status={status}')
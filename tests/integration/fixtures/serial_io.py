@@ -84,6 +84,14 @@ class SerialGarlicDevice:
         if self.serial and self.serial.is_open:
             self.serial.reset_output_buffer()
 
+    def set_link(self, baudrate: int, rtscts: bool = False) -> None:
+        if not self.serial or not self.serial.is_open:
+            raise RuntimeError("Serial connection not open")
+        self.serial.baudrate = baudrate
+        self.serial.rtscts = rtscts
+        self.config.baudrate = baudrate
+        self.serial.reset_input_buffer()
+
     def get_device_info(self) -> dict:
         info = {
             "port": self.config.port,
@@ -1,6 +1,7 @@
 import time
 import struct
 import binascii
+from collections import deque
 
 
 SYNC0 = 0xA5
@@ -11,6 +12,8 @@ FLAG_MIDDLE = 1 << 1
 FLAG_END = 1 << 2
 FLAG_RESP = 1 << 4
 MAX_PAYLOAD = 128
+# Sessions the device uses for unsolicited (subscription) messages
+NOTIFY_SESSION_BASE = 0xFF00
 
 
 def _u16(x: int) -> bytes:
@@ -37,6 +40,15 @@ class TransportCodec:
         self._re_frag_index = 0
         self._re_frag_count = 0
         self._re_is_resp = False
+        # Unsolicited device messages seen while waiting for responses
+        self.notifications = deque(maxlen=4096)
+        # Parse (instead of discard) stale input so queued notifications survive
+        self.keep_notifications = False
+
+    def _collect(self, messages):
+        for sess, msg, is_resp in messages:
+            if not is_resp and sess >= NOTIFY_SESSION_BASE:
+                self.notifications.append((sess, msg))
 
     def encode_message(self, session: int, payload: bytes, is_response: bool) -> bytes:
         out = bytearray()
@@ -136,7 +148,11 @@ class TransportCodec:
         def _attempt(deadline: float) -> bytes | None:
             # Drain stale input to avoid parser confusion from prior frames
             try:
-                if hasattr(ser, 'flush_input'):
+                if self.keep_notifications:
+                    n = getattr(ser.serial, 'in_waiting', 0)
+                    if n:
+                        self._collect(self.feed(ser.read(n)))
+                elif hasattr(ser, 'flush_input'):
                     ser.flush_input()
                 else:
                     # Fallback: best-effort drain using in_waiting
@@ -158,7 +174,9 @@ class TransportCodec:
                     to_read = 1
                 data = ser.read(to_read)
                 if data:
-                    for sess, msg, is_resp in self.feed(data):
+                    msgs = self.feed(data)
+                    self._collect(msgs)
+                    for sess, msg, is_resp in msgs:
                         if is_resp and sess == session:
                             return msg
             return None
@@ -175,3 +193,24 @@ class TransportCodec:
         if msg is not None:
             return msg
         raise TimeoutError('No response message')
+
+    def listen(self, ser, timeout: float = 1.0, count: int | None = None):
+        """Collect unsolicited messages for up to `timeout` seconds.
+
+        Returns (session, message) tuples, including any queued while earlier
+        requests were waiting for their responses. Stops early once `count`
+        messages are available.
+        """
+        deadline = time.time() + timeout
+        while (count is None or len(self.notifications) < count) and time.time() < deadline:
+            try:
+                to_read = getattr(ser.serial, 'in_waiting', 0) or 1
+            except Exception:
+                to_read = 1
+            data = ser.read(to_read)
+            if data:
+                self._collect(self.feed(data))
+        out = []
+        while self.notifications and (count is None or len(out) < count):
+            out.append(self.notifications.popleft())
+        return out
@@ -1,3 +1,4 @@
+import binascii
 import time
 import glob
 import os
@@ -7,7 +8,7 @@ import subprocess
 
 import pytest
 
-from command import CommandClient
+from command import TOPIC_UPTIME, CommandClient
 from transport import TransportCodec
 
 
@@ -84,6 +85,81 @@ def test_flash_read(garlic_device):
     assert len(data) == 16
 
 
+@pytest.mark.hardware
+def test_flash_read_stream_throughput(garlic_device):
+    cc = CommandClient(garlic_device)
+    size = 64 * 1024
+    t0 = time.time()
+    data = cc.flash_read_stream(0x00000000, size, timeout=3.0)
+    dt = time.time() - t0
+    assert len(data) == size
+    # Spot-check against single-message reads
+    for off in (0, 4096, size - 256):
+        assert data[off:off + 256] == cc.flash_read(off, 256, timeout=3.0)
+    print(f"FLASH_READ_STREAM: {size // 1024} KB in {dt:.2f} s = {size / 1024 / dt:.1f} KB/s")
+
+
+@pytest.mark.hardware
+def test_flash_crc_matches_streamed_read(garlic_device):
+    cc = CommandClient(garlic_device)
+    size = 64 * 1024
+    data = cc.flash_read_stream(0x00000000, size, timeout=3.0)
+    t0 = time.time()
+    crc = cc.flash_crc(0x00000000, size)
+    dt = time.time() - t0
+    assert crc == binascii.crc32(data) & 0xFFFFFFFF
+    print(f"FLASH_CRC: {size // 1024} KB in {dt * 1000:.1f} ms (one round trip)")
+    t0 = time.time()
+    cc.flash_crc(0x00000000, 256 * 1024, timeout=3.0)
+    print(f"FLASH_CRC: 256 KB in {(time.time() - t0) * 1000:.1f} ms")
+
+
+@pytest.mark.hardware
+def test_flash_write_erase_scratch(garlic_device):
+    # storage_partition on nrf52dk_nrf52832 (24 KB, unused); override for other layouts
+    addr = int(os.environ.get("GARLIC_FLASH_SCRATCH", "0x7A000"), 0)
+    cc = CommandClient(garlic_device)
+    data = bytes(random.getrandbits(8) for _ in range(3 * 4096 + 123))
+    t0 = time.time()
+    cc.flash_write(addr, data)
+    dt = time.time() - t0
+    assert cc.flash_read_stream(addr, len(data), timeout=3.0) == data
+    print(f"FLASH_WRITE: {len(data)} B in {dt:.2f} s = {len(data) / 1024 / dt:.1f} KB/s")
+    cc.flash_erase(addr, 4 * 4096)
+    assert cc.flash_read(addr, 64, timeout=3.0) == b'\xff' * 64
+    # The running image is refused
+    with pytest.raises(RuntimeError):
+        cc.flash_erase(0, 4096)
+
+
+@pytest.mark.hardware
+def test_dfu_update(garlic_device):
+    # Needs a firmware built with ./scripts/build.sh dfu and its signed image
+    image_path = os.environ.get("GARLIC_DFU_IMAGE")
+    if not image_path:
+        pytest.skip("set GARLIC_DFU_IMAGE to a signed app image (zephyr.signed.bin)")
+    with open(image_path, "rb") as f:
+        image = f.read()
+    cc = CommandClient(garlic_device)
+    t0 = time.time()
+    cc.dfu_update(image, reboot=False)
+    dt = time.time() - t0
+    print(f"DFU: {len(image)} B in {dt:.2f} s = {len(image) / 1024 / dt:.1f} KB/s")
+    assert cc.dfu_status()["pending"]
+    cc.reboot()
+    # MCUboot swaps the slots before the new image starts
+    deadline = time.time() + 60.0
+    while time.time() < deadline:
+        try:
+            cc.get_uptime_ms(timeout=1.0)
+            break
+        except Exception:
+            time.sleep(0.5)
+    else:
+        pytest.fail("Device did not come back after the swap")
+    cc.dfu_confirm()
+
+
 @pytest.mark.hardware
 def test_reboot_command_triggers_reset(garlic_device):
     cc = CommandClient(garlic_device)
@@ -150,3 +226,39 @@ def test_unknown_command_returns_error(garlic_device):
     payload = b"ping"
     got = cc.echo(payload, timeout=2.0)
     assert got == payload
+
+
+@pytest.mark.hardware
+def test_set_link_high_speed_roundtrip(garlic_device):
+    if not hasattr(garlic_device, 'set_link'):
+        pytest.skip('SET_LINK only applies to the serial interface')
+    cc = CommandClient(garlic_device)
+    base = garlic_device.config.baudrate
+    cc.set_link(1000000, rtscts=False, confirm_ms=1000, timeout=2.0)
+    try:
+        baud, flow, state = cc.get_link(timeout=2.0)
+        assert baud == 1000000 and not flow and state == 0
+        payload = bytes((i & 0xFF) for i in range(0, 200))
+        assert cc.echo(payload, timeout=3.0) == payload
+    finally:
+        cc.set_link(base, rtscts=False, timeout=2.0)
+    assert cc.get_link(timeout=2.0)[0] == base
+
+
+@pytest.mark.hardware
+def test_subscribe_uptime_pushes_without_requests(garlic_device):
+    cc = CommandClient(garlic_device)
+    sid = cc.subscribe(TOPIC_UPTIME, period_ms=100)
+    try:
+        got = cc.notifications(timeout=2.0, count=5)
+        assert len(got) == 5
+        assert all(n['id'] == sid and n['topic'] == TOPIC_UPTIME for n in got)
+        assert [n['seq'] for n in got] == list(range(got[0]['seq'], got[0]['seq'] + 5))
+        assert got[-1]['uptime_ms'] > got[0]['uptime_ms']
+        # Requests still get their responses while notifications stream
+        assert cc.echo(b'ping', timeout=2.0) == b'ping'
+        assert any(s['id'] == sid for s in cc.subscriptions())
+    finally:
+        cc.unsubscribe(0)
+    cc.notifications(timeout=0.3)
+    assert cc.notifications(timeout=0.5) == []
@@ -20,6 +20,70 @@ def test_tmp119_id_and_temperature(garlic_device):
     assert -5.0 <= c <= 60.0
 
 
+@pytest.mark.hardware
+def test_i2c_speed_switch(garlic_device):
+    cc = CommandClient(garlic_device)
+    _ = cc.get_uptime_ms(timeout=2.0)
+    assert cc.i2c_get_speed() == 400000
+    try:
+        for hz in (100000, 400000):
+            cc.i2c_set_speed(hz)
+            assert cc.i2c_get_speed() == hz
+            assert cc.tmp119_read_id(0x48, timeout=1.0) == 0x2117
+    finally:
+        cc.i2c_set_speed(400000)
+
+
+@pytest.mark.hardware
+def test_i2c_scan_cached(garlic_device):
+    cc = CommandClient(garlic_device)
+    _ = cc.get_uptime_ms(timeout=2.0)
+    addrs = cc.i2c_scan(force=True)
+    assert 0x48 in addrs
+    gen = cc.i2c_scan_info()['generation']
+    # Repeat scan is answered from the cache without touching the bus
+    assert cc.i2c_scan() == addrs
+    info = cc.i2c_scan_info()
+    assert info['generation'] == gen
+    assert 0x48 in info['present']
+    assert cc.i2c_scan(0x48, 0x4B, force=True, first_only=True) == [0x48]
+
+
+@pytest.mark.hardware
+def test_tmp119_sampler_history(garlic_device):
+    cc = CommandClient(garlic_device)
+    _ = cc.get_uptime_ms(timeout=2.0)
+    start = cc.tmp119_history(max_samples=0)['next_seq']
+    cc.tmp119_sampler_set(50)
+    try:
+        time.sleep(1.0)
+        h = cc.tmp119_history(since_seq=start)
+    finally:
+        cc.tmp119_sampler_set(0)
+    assert h['period_ms'] == 50
+    s = [x for x in h['samples'] if x['addr7'] == 0x48]
+    assert 10 <= len(s) <= 30
+    assert all(b['t_ms'] > a['t_ms'] for a, b in zip(s, s[1:]))
+    assert all(-5000 <= x['mc'] <= 60000 for x in s)
+
+
+@pytest.mark.hardware
+def test_tmp119_history_packed_matches_plain(garlic_device):
+    cc = CommandClient(garlic_device)
+    start = cc.tmp119_history(max_samples=0)['next_seq']
+    cc.tmp119_sampler_set(20)
+    try:
+        time.sleep(1.0)
+    finally:
+        cc.tmp119_sampler_set(0)
+    plain = cc.tmp119_history(since_seq=start)
+    packed = cc.tmp119_history_packed(since_seq=start)
+    assert packed['next_seq'] == plain['next_seq']
+    assert packed['samples'] == plain['samples'][-len(packed['samples']):]
+    assert len(packed['samples']) >= 20
+    assert packed['packed_len'] < 16 + 3 * len(packed['samples'])
+
+
 @pytest.mark.hardware
 def test_tmp119_fatal_on_uninitialized_address(garlic_device):
     # Only run this destructive test when explicitly requested
@@ -35,3 +99,36 @@ def test_tmp119_fatal_on_uninitialized_address(garlic_device):
     # Subsequent echo should also fail due to halted device
     with pytest.raises(TimeoutError):
         _ = cc.echo(b"ping", timeout=0.5)
+
+
+@pytest.mark.hardware
+def test_tmp119_oneshot_all_sensors(garlic_device):
+    cc = CommandClient(garlic_device)
+    cfg = cc.tmp119_read_config(0x48)
+    r = cc.tmp119_oneshot_all()
+    assert 0x48 in r['temps']
+    assert all(-5000 <= mc <= 60000 for mc in r['temps'].values())
+    # The sensors are put back in their previous mode
+    assert cc.tmp119_read_config(0x48) == cfg
+    assert abs(cc.tmp119_read_temp_mc(0x48) - r['temps'][0x48]) < 2000
+
+
+@pytest.mark.hardware
+def test_tmp119_aggregate_windows(garlic_device):
+    cc = CommandClient(garlic_device)
+    start = cc.tmp119_windows(max_windows=0)['next_seq']
+    cc.tmp119_aggregate_set(block=5, ma_len=4, ema_shift=2)
+    cc.tmp119_sampler_set(50)
+    try:
+        time.sleep(1.2)
+        w = cc.tmp119_windows(since_seq=start)
+    finally:
+        cc.tmp119_sampler_set(0)
+        cc.tmp119_aggregate_set(0)
+    assert w['block'] == 5
+    s = [x for x in w['windows'] if x['addr7'] == 0x48]
+    assert 2 <= len(s) <= 6
+    for x in s:
+        assert x['count'] == 5
+        assert x['min'] <= x['mean'] <= x['max']
+        assert x['max'] - x['min'] < 2000
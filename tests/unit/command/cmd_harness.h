@@ -0,0 +1,126 @@
+/**
+ * @file cmd_harness.h
+ * @brief Shared helpers for command tests
+ *
+ * - Little-endian field packing for request/response payloads.
+ * - Direct dispatch of one op of a command (no transport).
+ * - A device and a host transport wired back to back, for commands that
+ *   answer through the transport or push notifications on their own.
+ */
+
+#ifndef CMD_HARNESS_H
+#define CMD_HARNESS_H
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+#include "commands/inc/command.h"
+#include "commands/inc/register_all.h"
+#include "proto/inc/transport.h"
+#include "stack/cmd_transport/inc/cmd_transport.h"
+}
+
+namespace cmd_harness {
+
+inline std::vector<uint8_t> u32le(uint32_t v)
+{
+    return {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+}
+
+inline uint32_t rd32(const std::vector<uint8_t> &b, size_t o)
+{
+    return (uint32_t)b[o] | (b[o + 1] << 8) | (b[o + 2] << 16) | ((uint32_t)b[o + 3] << 24);
+}
+
+// Dispatch one request and return the response payload (up to 64 bytes)
+inline std::vector<uint8_t> dispatch(uint16_t id, const std::vector<uint8_t> &req, uint16_t *st)
+{
+    std::vector<uint8_t> out(64);
+    size_t len = out.size();
+    EXPECT_TRUE(grlc_cmd_dispatch(id, req.data(), req.size(), out.data(), &len, st));
+    out.resize(len);
+    return out;
+}
+
+// Dispatch [op][args...] to command @p id
+inline std::vector<uint8_t> dispatch_op(uint16_t id, uint8_t o, const std::vector<uint8_t> &args,
+                                        uint16_t *st)
+{
+    std::vector<uint8_t> req{o};
+    req.insert(req.end(), args.begin(), args.end());
+    return dispatch(id, req, st);
+}
+
+struct Msg {
+    uint16_t session;
+    std::vector<uint8_t> data;
+    bool is_response;
+};
+
+// Device and host transports wired back to back; the host side records every message
+inline transport_ctx g_dev;
+inline transport_ctx g_host;
+inline cmd_transport_binding g_bind;
+inline std::vector<Msg> g_rx;
+
+inline size_t dev_write(const uint8_t *data, size_t len)
+{
+    grlc_transport_rx_bytes(&g_host, data, len);
+    return len;
+}
+
+inline size_t host_write(const uint8_t *data, size_t len)
+{
+    grlc_transport_rx_bytes(&g_dev, data, len);
+    return len;
+}
+
+inline void host_on_msg(void *, uint16_t session, const uint8_t *msg, size_t len, bool is_response)
+{
+    g_rx.push_back(Msg{session, std::vector<uint8_t>(msg, msg + len), is_response});
+}
+
+inline const transport_lower_if g_dev_lower{dev_write};
+inline const transport_lower_if g_host_lower{host_write};
+
+// Fresh registry and transports; call from SetUp()
+inline void loopback_init()
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+    grlc_cmd_transport_bind(&g_bind, &g_dev);
+    grlc_transport_init(&g_dev, &g_dev_lower, grlc_cmd_get_transport_cb(), &g_bind);
+    grlc_transport_init(&g_host, &g_host_lower, host_on_msg, nullptr);
+    g_rx.clear();
+}
+
+// Send one request from the host and return the response payload
+inline std::vector<uint8_t> loopback_request(uint16_t id, uint16_t session,
+                                             const std::vector<uint8_t> &payload, uint16_t *status)
+{
+    std::vector<uint8_t> buf(payload.size() + 32);
+    size_t len = 0;
+    EXPECT_TRUE(grlc_cmd_pack_request(id, payload.data(), (uint16_t)payload.size(), buf.data(),
+                                      buf.size(), &len));
+    g_rx.clear();
+    EXPECT_TRUE(grlc_transport_send_message(&g_host, session, buf.data(), len, false));
+    EXPECT_EQ(g_rx.size(), 1u);
+    if (g_rx.empty())
+        return {};
+    EXPECT_TRUE(g_rx[0].is_response);
+    EXPECT_EQ(g_rx[0].session, session);
+    uint16_t cmd = 0;
+    const uint8_t *pl = nullptr;
+    uint16_t pl_len = 0;
+    EXPECT_TRUE(grlc_cmd_parse_response(g_rx[0].data.data(), g_rx[0].data.size(), &cmd, status,
+                                        &pl, &pl_len));
+    std::vector<uint8_t> out(pl, pl + pl_len);
+    g_rx.clear();
+    return out;
+}
+
+} // namespace cmd_harness
+
+#endif /* CMD_HARNESS_H */
@@ -1,25 +1,42 @@
 #include "drivers/ble_nus/inc/ble_nus.h"
 
+#include <string.h>
+
 static int s_adv_on;
-static int s_conn;
+static int s_conn[GRLC_BLE_MAX_LINKS];
 static ble_nus_rx_cb_t s_cb;
 static void *s_user;
 static uint8_t s_reason;
+static uint8_t s_profile = BLE_CONN_PROFILE_INTERACTIVE;
+static int s_auto = 1;
+static uint8_t s_mfg[GRLC_BLE_MFG_DATA_MAX];
+static size_t s_mfg_len;
 
 int grlc_ble_init(ble_nus_rx_cb_t rx_cb, void *user)
 {
     s_cb = rx_cb;
     s_user = user;
     s_adv_on = 1;
-    s_conn = 0;
+    memset(s_conn, 0, sizeof(s_conn));
     s_reason = 0;
     return 0;
 }
 
-size_t grlc_ble_send(const uint8_t *data, size_t len)
+void grlc_ble_set_conn_notify(ble_nus_conn_cb_t cb, void *user)
+{
+    (void)cb;
+    (void)user;
+}
+
+size_t grlc_ble_send(uint8_t link, const uint8_t *data, size_t len)
 {
     (void)data;
-    return len;
+    return (link < GRLC_BLE_MAX_LINKS && s_conn[link]) ? len : 0;
+}
+
+void grlc_ble_set_tx_notify(void (*cb)(void))
+{
+    (void)cb;
 }
 
 int grlc_ble_set_advertising(bool enable)
@@ -28,10 +45,101 @@ int grlc_ble_set_advertising(bool enable)
     return 0;
 }
 
+int grlc_ble_set_adv_mfg_data(const uint8_t *data, size_t len)
+{
+    if (data && len > GRLC_BLE_MFG_DATA_MAX) return -1;
+    s_mfg_len = data ? len : 0;
+    if (s_mfg_len) memcpy(s_mfg, data, s_mfg_len);
+    return 0;
+}
+
+/* Test hook: copy out the advertised manufacturer data */
+size_t ble_nus_stub_get_mfg_data(uint8_t *out, size_t cap)
+{
+    size_t n = s_mfg_len < cap ? s_mfg_len : cap;
+    memcpy(out, s_mfg, n);
+    return n;
+}
+
+uint8_t grlc_ble_conn_count(void)
+{
+    uint8_t n = 0;
+    for (size_t i = 0; i < GRLC_BLE_MAX_LINKS; ++i) {
+        n = (uint8_t)(n + (s_conn[i] ? 1 : 0));
+    }
+    return n;
+}
+
 void grlc_ble_get_status(bool *advertising, bool *connected)
 {
     if (advertising) *advertising = s_adv_on != 0;
-    if (connected) *connected = s_conn != 0;
+    if (connected) *connected = grlc_ble_conn_count() != 0;
+}
+
+/* Resolve a link selector like the driver: GRLC_BLE_LINK_ANY = first connected */
+static int stub_link(uint8_t link)
+{
+    if (link == GRLC_BLE_LINK_ANY) {
+        for (size_t i = 0; i < GRLC_BLE_MAX_LINKS; ++i) {
+            if (s_conn[i]) return (int)i;
+        }
+        return -1;
+    }
+    return (link < GRLC_BLE_MAX_LINKS && s_conn[link]) ? (int)link : -1;
+}
+
+void grlc_ble_get_link_info(uint8_t link, struct ble_link_info *info)
+{
+    if (!info) return;
+    if (stub_link(link) >= 0) {
+        info->att_mtu = 247;
+        info->tx_chunk = 244;
+        info->tx_data_len = 251;
+        info->rx_data_len = 251;
+        info->tx_phy = 2;
+        info->rx_phy = 2;
+    } else {
+        memset(info, 0, sizeof(*info));
+    }
+}
+
+int grlc_ble_set_conn_profile(uint8_t profile)
+{
+    if (profile == BLE_CONN_PROFILE_AUTO) {
+        s_auto = 1;
+    } else if (profile < BLE_CONN_PROFILE_COUNT) {
+        s_auto = 0;
+        s_profile = profile;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+void grlc_ble_get_conn_info(uint8_t link, struct ble_conn_info *info)
+{
+    if (!info) return;
+    memset(info, 0, sizeof(*info));
+    int l = stub_link(link);
+    if (l >= 0) {
+        /* Granted interactive parameters: 7.5 ms, no latency, 4 s timeout; link 1 got 15 ms */
+        info->interval = (uint16_t)(l == 0 ? 6 : 12);
+        info->timeout = 400;
+    }
+    info->profile = s_profile;
+    info->auto_sel = (uint8_t)s_auto;
+}
+
+/* Test hook: simulate a connected central with an upgraded link on slot 0 */
+void ble_nus_stub_set_connected(int connected)
+{
+    s_conn[0] = connected;
+}
+
+/* Test hook: connect or disconnect a central on any slot */
+void ble_nus_stub_set_link_connected(uint8_t link, int connected)
+{
+    if (link < GRLC_BLE_MAX_LINKS) s_conn[link] = connected;
 }
 
 uint8_t grlc_ble_last_disc_reason(void)
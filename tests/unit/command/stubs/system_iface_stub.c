@@ -1,5 +1,36 @@
 #include "commands/inc/system_iface.h"
 
+#include <errno.h>
+#include <string.h>
+
+/* Simulated 512 KB NOR flash: 4 KB pages, programming only clears bits.
+ * Initial content is addr & 0xFF; the first 64 KB stand in for the running image.
+ */
+#define STUB_FLASH_SIZE (512u * 1024u)
+#define STUB_PAGE_SIZE 4096u
+#define STUB_IMAGE_END (64u * 1024u)
+/* Secondary image slot for DFU */
+#define STUB_SLOT1_ADDR 0x40000u
+#define STUB_SLOT1_SIZE 0x20000u
+
+static uint8_t s_flash[STUB_FLASH_SIZE];
+static int s_flash_init = 0;
+static unsigned s_erase_count = 0;
+static int s_upgrade_requested = 0; /* 0 none, 1 test, 2 permanent */
+
+static void stub_flash_init(void)
+{
+    if (!s_flash_init) {
+        for (size_t i = 0; i < sizeof(s_flash); ++i) s_flash[i] = (uint8_t)(i & 0xFF);
+        s_flash_init = 1;
+    }
+}
+
+static int in_range(uint32_t addr, size_t len)
+{
+    return (uint64_t)addr + len <= STUB_FLASH_SIZE;
+}
+
 uint64_t grlc_sys_uptime_ms(void)
 {
     return 123456789ULL;
@@ -7,7 +38,73 @@ uint64_t grlc_sys_uptime_ms(void)
 
 size_t grlc_sys_flash_read(uint32_t addr, uint8_t *dst, size_t len)
 {
-    (void)addr;
-    for (size_t i = 0; i < len; ++i) dst[i] = (uint8_t)(i & 0xFF);
+    stub_flash_init();
+    if (!in_range(addr, len)) {
+        return 0;
+    }
+    memcpy(dst, &s_flash[addr], len);
     return len;
 }
+
+size_t grlc_sys_flash_page_size(void)
+{
+    return STUB_PAGE_SIZE;
+}
+
+bool grlc_sys_flash_writable(uint32_t addr, size_t len)
+{
+    return len && in_range(addr, len) && addr >= STUB_IMAGE_END;
+}
+
+int grlc_sys_flash_erase(uint32_t addr, size_t len)
+{
+    stub_flash_init();
+    if (!in_range(addr, len) || addr % STUB_PAGE_SIZE || len % STUB_PAGE_SIZE) {
+        return -EINVAL;
+    }
+    memset(&s_flash[addr], 0xFF, len);
+    s_erase_count += (unsigned)(len / STUB_PAGE_SIZE);
+    return 0;
+}
+
+int grlc_sys_flash_write(uint32_t addr, const uint8_t *src, size_t len)
+{
+    stub_flash_init();
+    if (!in_range(addr, len) || addr % 4u || len % 4u) {
+        return -EINVAL;
+    }
+    for (size_t i = 0; i < len; ++i) s_flash[addr + i] &= src[i];
+    return 0;
+}
+
+/* Test hook: pages erased since start-up */
+unsigned grlc_sys_stub_flash_erase_count(void)
+{
+    return s_erase_count;
+}
+
+bool grlc_sys_dfu_slot(uint32_t *addr, uint32_t *size)
+{
+    *addr = STUB_SLOT1_ADDR;
+    *size = STUB_SLOT1_SIZE;
+    return true;
+}
+
+int grlc_sys_dfu_request_upgrade(bool permanent)
+{
+    s_upgrade_requested = permanent ? 2 : 1;
+    return 0;
+}
+
+int grlc_sys_dfu_confirm(void)
+{
+    return 0;
+}
+
+/* Test hook: last swap request (0 none, 1 test, 2 permanent); clears it */
+int grlc_sys_stub_take_upgrade_request(void)
+{
+    int r = s_upgrade_requested;
+    s_upgrade_requested = 0;
+    return r;
+}
@@ -1,27 +1,45 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <vector>
+
 extern "C" {
 #include "commands/inc/command.h"
 #include "commands/inc/ids.h"
 #include "commands/inc/register_all.h"
+void ble_nus_stub_set_connected(int connected);
+void ble_nus_stub_set_link_connected(uint8_t link, int connected);
+size_t ble_nus_stub_get_mfg_data(uint8_t *out, size_t cap);
+void i2c_mock_set_present_addr(uint8_t a);
+void i2c_mock_set_dev_id(uint16_t id);
+void i2c_mock_set_temp_raw(int16_t raw);
+#include "drivers/ble_nus/inc/ble_nus.h"
+#include "drivers/tmp119/inc/tmp119.h"
+#include "stack/ble_broadcast/inc/ble_broadcast.h"
 }
 
 using ::testing::ElementsAre;
 
 TEST(BLECtrl, StatusAndSetAdv)
 {
-    command_registry_init();
-    command_register_builtin();
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
 
     uint8_t req[8];
     uint8_t out[16];
     size_t out_len = sizeof(out);
     uint16_t status = 0xFFFF;
 
-    // Initially false/false
+    // Start from advertising off, not connected
+    ble_nus_stub_set_connected(0);
+    req[0] = 0x01; // SET_ADV
+    req[1] = 0x00; // disable
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 2, out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
+
+    out_len = sizeof(out);
     req[0] = 0x00;
-    ASSERT_TRUE(command_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
     EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
     ASSERT_EQ(out_len, 2u);
     EXPECT_THAT(std::vector<uint8_t>(out, out + 2), ElementsAre(0, 0));
@@ -30,16 +48,214 @@ TEST(BLECtrl, StatusAndSetAdv)
     out_len = sizeof(out);
     req[0] = 0x01; // SET_ADV
     req[1] = 0x01; // enable
-    ASSERT_TRUE(command_dispatch(CMD_ID_BLE_CTRL, req, 2, out, &out_len, &status));
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 2, out, &out_len, &status));
     EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
     EXPECT_EQ(out_len, 0u);
 
     // Status should reflect advertising on
     out_len = sizeof(out);
     req[0] = 0x00;
-    ASSERT_TRUE(command_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
     EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
     ASSERT_EQ(out_len, 2u);
     EXPECT_THAT(std::vector<uint8_t>(out, out + 2), ElementsAre(1, 0));
 }
 
+TEST(BLECtrl, GetLinkReportsNegotiatedParameters)
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+
+    const uint8_t req[] = {0x02};
+    uint8_t out[16];
+    size_t out_len = sizeof(out);
+    uint16_t status = 0xFFFF;
+
+    ble_nus_stub_set_connected(0);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
+    ASSERT_EQ(out_len, 10u);
+    EXPECT_THAT(std::vector<uint8_t>(out, out + 10), ElementsAre(0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+
+    ble_nus_stub_set_connected(1);
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
+    ASSERT_EQ(out_len, 10u);
+    // MTU 247, chunk 244, DLE 251/251, 2M/2M
+    EXPECT_THAT(std::vector<uint8_t>(out, out + 10),
+                ElementsAre(247, 0, 244, 0, 251, 0, 251, 0, 2, 2));
+    ble_nus_stub_set_connected(0);
+}
+
+TEST(BLECtrl, SetProfileAndGetConn)
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+
+    uint8_t req[2];
+    uint8_t out[16];
+    size_t out_len = sizeof(out);
+    uint16_t status = 0xFFFF;
+
+    ble_nus_stub_set_connected(1);
+    req[0] = 0x03; // GET_CONN
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
+    ASSERT_EQ(out_len, 8u);
+    // 7.5 ms interval, latency 0, 4 s timeout, interactive, auto
+    EXPECT_THAT(std::vector<uint8_t>(out, out + 8), ElementsAre(6, 0, 0, 0, 0x90, 0x01, 0, 1));
+
+    // Force the bulk profile
+    out_len = sizeof(out);
+    req[0] = 0x04; // SET_PROFILE
+    req[1] = 0x01;
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 2, out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
+    EXPECT_EQ(out_len, 0u);
+
+    out_len = sizeof(out);
+    req[0] = 0x03;
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
+    ASSERT_EQ(out_len, 8u);
+    EXPECT_EQ(out[6], 1u);
+    EXPECT_EQ(out[7], 0u);
+
+    // Unknown profile is rejected; missing argument too
+    out_len = sizeof(out);
+    req[0] = 0x04;
+    req[1] = 0x07;
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 2, out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_ERR_INVALID);
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_ERR_INVALID);
+
+    // Back to automatic selection
+    out_len = sizeof(out);
+    req[1] = 0xFF;
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 2, out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
+    out_len = sizeof(out);
+    req[0] = 0x03;
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
+    EXPECT_EQ(out[7], 1u);
+
+    // Not connected: timing fields are zero
+    ble_nus_stub_set_connected(0);
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
+    EXPECT_THAT(std::vector<uint8_t>(out, out + 6), ElementsAre(0, 0, 0, 0, 0, 0));
+}
+
+TEST(BLECtrl, MultipleCentralsReportedPerLink)
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+
+    uint8_t req[2];
+    uint8_t out[16];
+    size_t out_len = sizeof(out);
+    uint16_t status = 0xFFFF;
+
+    ble_nus_stub_set_connected(1);
+    ble_nus_stub_set_link_connected(1, 1);
+
+    // GET_STATUS reports the number of connected centrals
+    req[0] = 0x00;
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
+    ASSERT_EQ(out_len, 2u);
+    EXPECT_EQ(out[1], 2u);
+
+    // GET_CONN per link: slot 1 was granted 15 ms
+    out_len = sizeof(out);
+    req[0] = 0x03;
+    req[1] = 0x01;
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 2, out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
+    ASSERT_EQ(out_len, 8u);
+    EXPECT_EQ(out[0], 12u);
+
+    // First central leaves: the default selector falls through to slot 1
+    ble_nus_stub_set_connected(0);
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 1, out, &out_len, &status));
+    EXPECT_EQ(out[0], 12u);
+    out_len = sizeof(out);
+    req[1] = 0x00;
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, req, 2, out, &out_len, &status));
+    EXPECT_EQ(out[0], 0u);
+
+    ble_nus_stub_set_link_connected(1, 0);
+}
+
+TEST(BLEBroadcast, EncodeLayout)
+{
+    const int16_t temps[2] = {2512, -105};
+    uint8_t out[GRLC_BLE_BCAST_PAYLOAD_MAX];
+    size_t n = grlc_ble_bcast_encode(out, sizeof(out), 0x0102, 0x0A0B0C0D, temps, 2);
+    ASSERT_EQ(n, 14u);
+    EXPECT_THAT(std::vector<uint8_t>(out, out + n),
+                ElementsAre(0xFF, 0xFF, 1, 0x02, 0x01, 0x0D, 0x0C, 0x0B, 0x0A, 2, 0xD0, 0x09,
+                            0x97, 0xFF));
+    // Fits the advertising PDU next to the flags
+    EXPECT_LE(sizeof(out), (size_t)GRLC_BLE_MFG_DATA_MAX);
+    EXPECT_EQ(grlc_ble_bcast_encode(out, 13, 0, 0, temps, 2), 0u);
+    EXPECT_EQ(grlc_ble_bcast_encode(out, sizeof(out), 0, 0, temps, 5), 0u);
+}
+
+TEST(BLECtrl, BroadcastPublishesSensorReadings)
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+    i2c_mock_set_present_addr(0x48);
+    i2c_mock_set_dev_id(0x2117);
+    i2c_mock_set_temp_raw(0x0C80); // 25.00 C
+    ASSERT_GE(grlc_tmp119_boot_init(), 1);
+
+    uint8_t out[16];
+    size_t out_len = 0;
+    uint16_t status = 0xFFFF;
+
+    // Interval out of range is rejected
+    const uint8_t bad[] = {0x05, 0x01, 50, 0};
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, bad, sizeof(bad), out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_ERR_INVALID);
+
+    // Enable at 500 ms: the first payload is published immediately
+    const uint8_t en[] = {0x05, 0x01, 0xF4, 0x01};
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, en, sizeof(en), out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
+
+    uint8_t mfg[GRLC_BLE_MFG_DATA_MAX];
+    size_t mfg_len = ble_nus_stub_get_mfg_data(mfg, sizeof(mfg));
+    ASSERT_EQ(mfg_len, 12u);
+    EXPECT_EQ(mfg[0], 0xFF);
+    EXPECT_EQ(mfg[1], 0xFF);
+    EXPECT_EQ(mfg[2], GRLC_BLE_BCAST_VERSION);
+    EXPECT_EQ(mfg[9], 1u);
+    EXPECT_EQ((int16_t)(mfg[10] | (mfg[11] << 8)), 2500);
+
+    const uint8_t get[] = {0x06};
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, get, 1, out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
+    ASSERT_EQ(out_len, 6u);
+    EXPECT_EQ(out[0], 1u);
+    EXPECT_EQ(out[1] | (out[2] << 8), 500);
+    uint16_t seq = (uint16_t)(out[3] | (out[4] << 8));
+    EXPECT_EQ(seq, (uint16_t)((mfg[3] | (mfg[4] << 8)) + 1));
+    EXPECT_EQ(out[5], 1u);
+
+    // Disable keeps the interval and removes the advertising payload
+    const uint8_t dis[] = {0x05, 0x00};
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, dis, sizeof(dis), out, &out_len, &status));
+    EXPECT_EQ(status, (uint16_t)CMD_STATUS_OK);
+    EXPECT_EQ(ble_nus_stub_get_mfg_data(mfg, sizeof(mfg)), 0u);
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_BLE_CTRL, get, 1, out, &out_len, &status));
+    EXPECT_EQ(out[0], 0u);
+    EXPECT_EQ(out[1] | (out[2] << 8), 500);
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "cmd_harness.h"
+
+extern "C" {
+#include "commands/inc/command.h"
+#include "commands/inc/ids.h"
+#include "commands/inc/register_all.h"
+#include "commands/inc/system_iface.h"
+#include "proto/inc/crc32.h"
+#include "stack/dfu/inc/dfu.h"
+#include "stack/flash_writer/inc/flash_writer.h"
+#include "utils/sha256/inc/sha256.h"
+int grlc_sys_stub_take_upgrade_request(void);
+}
+
+using namespace cmd_harness;
+
+namespace {
+
+// Fake signed image: MCUboot magic followed by a pattern
+std::vector<uint8_t> make_image(size_t n)
+{
+    std::vector<uint8_t> img(n);
+    for (size_t i = 0; i < n; ++i) img[i] = (uint8_t)(i * 13 + 5);
+    const auto magic = u32le(GRLC_DFU_IMAGE_MAGIC);
+    std::copy(magic.begin(), magic.end(), img.begin());
+    return img;
+}
+
+class Dfu : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        grlc_cmd_registry_init();
+        grlc_cmd_register_builtin();
+        (void)grlc_sys_stub_take_upgrade_request();
+    }
+
+    void TearDown() override { grlc_dfu_abort(); }
+
+    static std::vector<uint8_t> op(uint8_t o, const std::vector<uint8_t> &args, uint16_t *st)
+    {
+        return dispatch_op(CMD_ID_DFU, o, args, st);
+    }
+
+    static void send(const std::vector<uint8_t> &img, size_t chunk)
+    {
+        uint16_t st = 0xFFFF;
+        auto r = op(0x01, u32le((uint32_t)img.size()), &st);
+        ASSERT_EQ(st, CMD_STATUS_OK);
+        EXPECT_EQ(rd32(r, 0), 0x40000u);
+        EXPECT_EQ(rd32(r, 4), 0x20000u);
+        for (size_t off = 0; off < img.size(); off += chunk) {
+            size_t n = std::min(chunk, img.size() - off);
+            std::vector<uint8_t> a = u32le((uint32_t)off);
+            a.insert(a.end(), img.begin() + off, img.begin() + off + n);
+            r = op(0x02, a, &st);
+            ASSERT_EQ(st, CMD_STATUS_OK);
+            EXPECT_EQ(rd32(r, 0), off + n);
+            (void)grlc_flash_writer_service();
+        }
+    }
+
+    static std::vector<uint8_t> digests(const std::vector<uint8_t> &img)
+    {
+        std::vector<uint8_t> d = u32le(crc32_ieee(img.data(), img.size()));
+        sha256_ctx_t c;
+        grlc_sha256_init(&c);
+        grlc_sha256_update(&c, img.data(), img.size());
+        uint8_t h[GRLC_SHA256_DIGEST_LEN];
+        grlc_sha256_final(&c, h);
+        d.insert(d.end(), h, h + sizeof(h));
+        return d;
+    }
+};
+
+} // namespace
+
+TEST_F(Dfu, StreamsVerifiesAndRequestsSwap)
+{
+    auto img = make_image(3 * 4096 + 77);
+    send(img, 200);
+
+    // A resent chunk is refused and not hashed twice
+    uint16_t st = 0xFFFF;
+    std::vector<uint8_t> again = u32le(0);
+    again.insert(again.end(), img.begin(), img.begin() + 16);
+    (void)op(0x02, again, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+
+    auto want = digests(img);
+    auto r = op(0x03, want, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    EXPECT_EQ(r, want);
+
+    std::vector<uint8_t> back(img.size());
+    ASSERT_EQ(grlc_sys_flash_read(0x40000, back.data(), back.size()), back.size());
+    EXPECT_EQ(back, img);
+
+    auto s = op(0x05, {}, &st);
+    ASSERT_EQ(s.size(), 15u);
+    EXPECT_EQ(s[0], 0); // transfer done
+    EXPECT_EQ(s[1], 1); // verified
+    EXPECT_EQ(s[2], 0);
+    EXPECT_EQ(rd32(s, 7), img.size());
+
+    (void)op(0x04, {0}, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    EXPECT_EQ(grlc_sys_stub_take_upgrade_request(), 1); // test swap
+    s = op(0x05, {}, &st);
+    EXPECT_EQ(s[2], 1);
+}
+
+TEST_F(Dfu, RefusesMismatchedOrUnsignedImages)
+{
+    uint16_t st = 0xFFFF;
+    (void)op(0x01, u32le(0x20001), &st); // larger than the slot
+    EXPECT_EQ(st, CMD_STATUS_ERR_BOUNDS);
+    (void)op(0x04, {1}, &st); // nothing verified
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+
+    auto img = make_image(5000);
+    send(img, 1024);
+    auto bad = digests(img);
+    bad[10] ^= 1;
+    (void)op(0x03, bad, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+    (void)op(0x04, {1}, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+
+    // Correct digests but no MCUboot header
+    img[0] = 0;
+    send(img, 1024);
+    (void)op(0x03, digests(img), &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    (void)op(0x04, {1}, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+    EXPECT_EQ(grlc_sys_stub_take_upgrade_request(), 0);
+}
+
+TEST_F(Dfu, FlashWriteSessionCancelsUpdate)
+{
+    uint16_t st = 0xFFFF;
+    auto img = make_image(4096);
+    (void)op(0x01, u32le((uint32_t)img.size()), &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    ASSERT_EQ(grlc_flash_writer_begin(0x60000, 64), 0);
+
+    std::vector<uint8_t> a = u32le(0);
+    a.insert(a.end(), img.begin(), img.begin() + 64);
+    (void)op(0x02, a, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+    auto s = op(0x05, {}, &st);
+    EXPECT_EQ(s[0], 0);
+    // The foreign session is left alone
+    struct flash_writer_status ws;
+    grlc_flash_writer_get(&ws);
+    EXPECT_TRUE(ws.active);
+    EXPECT_EQ(ws.addr, 0x60000u);
+    grlc_flash_writer_abort();
+}
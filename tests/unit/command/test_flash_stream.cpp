@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "cmd_harness.h"
+
+extern "C" {
+#include "commands/inc/ids.h"
+#include "stack/flash_stream/inc/flash_stream.h"
+}
+
+using namespace cmd_harness;
+
+namespace {
+
+class FlashStream : public ::testing::Test {
+protected:
+    void SetUp() override { loopback_init(); }
+
+    void TearDown() override { (void)grlc_flash_stream_cancel(&g_bind); }
+
+    // Send FLASH_READ_STREAM and return the response payload
+    static std::vector<uint8_t> request(uint32_t addr, uint32_t len, uint16_t chunk,
+                                        uint16_t *status)
+    {
+        std::vector<uint8_t> payload(10);
+        memcpy(&payload[0], &addr, 4);
+        memcpy(&payload[4], &len, 4);
+        memcpy(&payload[8], &chunk, 2);
+        return loopback_request(CMD_ID_FLASH_READ_STREAM, 0x0051, payload, status);
+    }
+};
+
+} // namespace
+
+TEST_F(FlashStream, StreamsRegionAsChunkMessages)
+{
+    uint16_t st = 0xFFFF;
+    auto r = request(0x1000, 2500, 1000, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    ASSERT_EQ(r.size(), 6u);
+    EXPECT_EQ(r[0] | (r[1] << 8) | (r[2] << 16), 2500);
+    EXPECT_EQ(r[4] | (r[5] << 8), 1000);
+
+    EXPECT_EQ(grlc_flash_stream_service(&g_bind), GRLC_FLASH_STREAM_IDLE);
+    ASSERT_EQ(g_rx.size(), 3u);
+    uint32_t expect_off = 0;
+    for (const Msg &m : g_rx) {
+        EXPECT_FALSE(m.is_response);
+        EXPECT_EQ(m.session, GRLC_FLASH_STREAM_SESSION);
+        uint16_t cmd = 0, mst = 0xFFFF;
+        const uint8_t *pl = nullptr;
+        uint16_t pl_len = 0;
+        ASSERT_TRUE(grlc_cmd_parse_response(m.data.data(), m.data.size(), &cmd, &mst, &pl,
+                                            &pl_len));
+        EXPECT_EQ(cmd, CMD_ID_FLASH_READ_STREAM);
+        EXPECT_EQ(mst, CMD_STATUS_OK);
+        uint32_t off = 0;
+        memcpy(&off, pl, 4);
+        EXPECT_EQ(off, expect_off);
+        size_t want = (expect_off + 1000 <= 2500) ? 1000u : 2500u - expect_off;
+        ASSERT_EQ(pl_len, 4u + want);
+        // Stub flash holds addr & 0xFF
+        EXPECT_EQ(pl[4 + 300], (expect_off + 300) & 0xFF);
+        expect_off += (uint32_t)want;
+    }
+    EXPECT_EQ(expect_off, 2500u);
+
+    g_rx.clear();
+    EXPECT_EQ(grlc_flash_stream_service(&g_bind), GRLC_FLASH_STREAM_IDLE);
+    EXPECT_TRUE(g_rx.empty());
+}
+
+TEST_F(FlashStream, CancelReportsUnsentBytes)
+{
+    uint16_t st = 0xFFFF;
+    (void)request(0, 4096, 0, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    auto r = request(0, 0, 0, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    ASSERT_EQ(r.size(), 6u);
+    EXPECT_EQ(r[0] | (r[1] << 8) | (r[2] << 16), 4096);
+    EXPECT_EQ(grlc_flash_stream_service(&g_bind), GRLC_FLASH_STREAM_IDLE);
+    EXPECT_TRUE(g_rx.empty());
+}
+
+TEST_F(FlashStream, RejectsBadRequestsAndDirectDispatch)
+{
+    uint16_t st = 0xFFFF;
+    (void)request(0, 100, GRLC_FLASH_STREAM_CHUNK_MIN - 1, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+    (void)request(0, 100, GRLC_FLASH_STREAM_CHUNK_MAX + 1, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+    (void)request(0xFFFFFF00u, 0x200, 0, &st); // wraps the address space
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+
+    // Without a link there is nowhere to stream to
+    const uint8_t req[] = {0, 0, 0, 0, 16, 0, 0, 0};
+    uint8_t out[16];
+    size_t out_len = sizeof(out);
+    EXPECT_TRUE(grlc_cmd_dispatch(CMD_ID_FLASH_READ_STREAM, req, sizeof(req), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_ERR_UNSUPPORTED);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "cmd_harness.h"
+
+extern "C" {
+#include "commands/inc/command.h"
+#include "commands/inc/ids.h"
+#include "commands/inc/register_all.h"
+#include "commands/inc/system_iface.h"
+#include "proto/inc/crc32.h"
+#include "stack/flash_writer/inc/flash_writer.h"
+unsigned grlc_sys_stub_flash_erase_count(void);
+}
+
+using namespace cmd_harness;
+
+namespace {
+
+class FlashWrite : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        grlc_cmd_registry_init();
+        grlc_cmd_register_builtin();
+    }
+
+    void TearDown() override { grlc_flash_writer_abort(); }
+
+    static std::vector<uint8_t> op(uint8_t o, const std::vector<uint8_t> &args, uint16_t *st)
+    {
+        return dispatch_op(CMD_ID_FLASH_WRITE, o, args, st);
+    }
+};
+
+} // namespace
+
+TEST_F(FlashWrite, ProgramsPagesWithEraseAhead)
+{
+    const uint32_t base = 0x40000;
+    std::vector<uint8_t> image(2 * 4096 + 102);
+    for (size_t i = 0; i < image.size(); ++i) image[i] = (uint8_t)(i * 31 + 7);
+
+    uint16_t st = 0xFFFF;
+    unsigned e0 = grlc_sys_stub_flash_erase_count();
+    std::vector<uint8_t> args = u32le(base);
+    auto len = u32le((uint32_t)image.size());
+    args.insert(args.end(), len.begin(), len.end());
+    auto r = op(0x01, args, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    EXPECT_EQ(rd32(r, 0), 4096u);
+    EXPECT_EQ(grlc_sys_stub_flash_erase_count(), e0 + 1); // first page only
+
+    // The service erases one page ahead of the one being filled, and no further
+    EXPECT_TRUE(grlc_flash_writer_service());
+    EXPECT_FALSE(grlc_flash_writer_service());
+    EXPECT_EQ(grlc_sys_stub_flash_erase_count(), e0 + 2);
+
+    for (size_t off = 0; off < image.size(); off += 1000) {
+        size_t n = std::min<size_t>(1000, image.size() - off);
+        std::vector<uint8_t> a = u32le((uint32_t)off);
+        a.insert(a.end(), image.begin() + off, image.begin() + off + n);
+        r = op(0x02, a, &st);
+        ASSERT_EQ(st, CMD_STATUS_OK);
+        EXPECT_EQ(rd32(r, 0), off + n);
+        (void)grlc_flash_writer_service();
+    }
+    EXPECT_EQ(grlc_sys_stub_flash_erase_count(), e0 + 3);
+
+    r = op(0x03, {}, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    uint32_t crc = crc32_ieee(image.data(), image.size());
+    EXPECT_EQ(rd32(r, 0), image.size());
+    EXPECT_EQ(rd32(r, 4), crc);
+    r = op(0x04, {}, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    EXPECT_EQ(rd32(r, 0), crc);
+
+    std::vector<uint8_t> back(image.size() + 4);
+    ASSERT_EQ(grlc_sys_flash_read(base, back.data(), back.size()), back.size());
+    EXPECT_TRUE(std::equal(image.begin(), image.end(), back.begin()));
+    // Tail padded to the write block, the rest of the page left erased
+    EXPECT_EQ(back[image.size()], 0xFF);
+    EXPECT_EQ(back[image.size() + 3], 0xFF);
+}
+
+TEST_F(FlashWrite, RejectsOutOfOrderAndProtectedWrites)
+{
+    uint16_t st = 0xFFFF;
+    std::vector<uint8_t> a = u32le(0x1000); // inside the running image
+    auto l = u32le(16);
+    a.insert(a.end(), l.begin(), l.end());
+    (void)op(0x01, a, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+    a = u32le(0x50010); // not page aligned
+    a.insert(a.end(), l.begin(), l.end());
+    (void)op(0x01, a, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+    (void)op(0x02, {0, 0, 0, 0, 1}, &st); // no session
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+
+    a = u32le(0x50000);
+    a.insert(a.end(), l.begin(), l.end());
+    (void)op(0x01, a, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    (void)op(0x02, {8, 0, 0, 0, 1, 2, 3, 4}, &st); // gap
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+    (void)op(0x02, {0, 0, 0, 0, 1, 2, 3, 4}, &st);
+    EXPECT_EQ(st, CMD_STATUS_OK);
+    auto s = op(0x05, {}, &st);
+    ASSERT_EQ(s.size(), 17u);
+    EXPECT_EQ(s[0], 1);
+    EXPECT_EQ(rd32(s, 9), 4u);
+    (void)op(0x03, {}, &st); // incomplete
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+    (void)op(0x06, {}, &st);
+    EXPECT_EQ(st, CMD_STATUS_OK);
+    (void)op(0x03, {}, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+}
+
+TEST_F(FlashWrite, EraseClearsWholePages)
+{
+    uint16_t st = 0xFFFF;
+    std::vector<uint8_t> a = u32le(0x60000);
+    auto l = u32le(4096);
+    a.insert(a.end(), l.begin(), l.end());
+    (void)dispatch(CMD_ID_FLASH_ERASE, a, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    uint8_t b[4096];
+    ASSERT_EQ(grlc_sys_flash_read(0x60000, b, sizeof(b)), sizeof(b));
+    for (uint8_t x : b) ASSERT_EQ(x, 0xFF);
+
+    a = u32le(0x60000);
+    l = u32le(100); // partial page
+    a.insert(a.end(), l.begin(), l.end());
+    (void)dispatch(CMD_ID_FLASH_ERASE, a, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+}
@@ -2,6 +2,11 @@
 #include "commands/inc/command.h"
 #include "commands/inc/ids.h"
 #include <cstring>
+#include <vector>
+
+extern "C" {
+#include "proto/inc/crc32.h"
+}
 
 extern "C" void grlc_cmd_registry_init(void);
 
@@ -48,6 +53,35 @@ TEST(CommandHandlers, FlashRead)
     for (size_t i=0;i<16;++i) EXPECT_EQ(out[i], (uint8_t)i);
 }
 
+TEST(CommandHandlers, FlashCrc)
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+    // Stub flash holds addr & 0xFF
+    std::vector<uint8_t> want(3000);
+    for (size_t i = 0; i < want.size(); ++i) want[i] = (uint8_t)((0x1234 + i) & 0xFF);
+    uint32_t crc = crc32_ieee(want.data(), want.size());
+    const uint8_t req[] = {0x34, 0x12, 0, 0, 0xB8, 0x0B, 0, 0}; // addr 0x1234, len 3000
+    uint16_t st = 0;
+    // The block size follows the response capacity; the result must not
+    for (size_t cap : {2048u, 64u, 5u}) {
+        std::vector<uint8_t> out(cap);
+        size_t out_len = cap;
+        ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_FLASH_CRC, req, sizeof(req), out.data(), &out_len,
+                                      &st));
+        EXPECT_EQ(st, CMD_STATUS_OK);
+        ASSERT_EQ(out_len, 4u);
+        EXPECT_EQ(out[0] | (out[1] << 8) | (out[2] << 16) | ((uint32_t)out[3] << 24), crc);
+    }
+    // Past the end of flash
+    const uint8_t past[] = {0, 0xF0, 0x07, 0, 0, 0x20, 0, 0};
+    uint8_t out[64];
+    size_t out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_FLASH_CRC, past, sizeof(past), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_ERR_INTERNAL);
+    EXPECT_EQ(out_len, 0u);
+}
+
 TEST(CommandHandlers, Echo)
 {
     grlc_cmd_registry_init();
@@ -60,3 +94,48 @@ TEST(CommandHandlers, Echo)
     ASSERT_EQ(out_len, sizeof(req));
     for (size_t i = 0; i < sizeof(req); ++i) EXPECT_EQ(out[i], req[i]);
 }
+
+extern "C" unsigned i2c_mock_get_recover_count(void);
+
+TEST(CommandHandlers, I2cSpeedAndRecoverOnlyOnError)
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+    uint8_t out[16]; size_t out_len = sizeof(out);
+    uint16_t st = 0;
+    // SET_SPEED 100 kHz, then GET_SPEED
+    const uint8_t set100[] = {0x20, 0x00, 0xA0, 0x86, 0x01, 0x00};
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_I2C_TRANSFER, set100, sizeof(set100), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_OK);
+    const uint8_t get[] = {0x21, 0x00};
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_I2C_TRANSFER, get, sizeof(get), out, &out_len, &st));
+    ASSERT_EQ(out_len, 4u);
+    EXPECT_EQ(out[0] | (out[1] << 8) | (out[2] << 16) | ((uint32_t)out[3] << 24), 100000u);
+    // 1 MHz is rejected by the controller, unknown rates are invalid
+    const uint8_t set1m[] = {0x20, 0x00, 0x40, 0x42, 0x0F, 0x00};
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_I2C_TRANSFER, set1m, sizeof(set1m), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_ERR_UNSUPPORTED);
+    const uint8_t set_bad[] = {0x20, 0x00, 0x01, 0x00, 0x00, 0x00};
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_I2C_TRANSFER, set_bad, sizeof(set_bad), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+    const uint8_t set400[] = {0x20, 0x00, 0x80, 0x1A, 0x06, 0x00};
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_I2C_TRANSFER, set400, sizeof(set400), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_OK);
+
+    // A successful read does not toggle SCL; a NACK triggers one recovery
+    unsigned before = i2c_mock_get_recover_count();
+    const uint8_t rd_ok[] = {0x02, 0x48, 0x01, 0x00, 0x02, 0x00, 0x0F};
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_I2C_TRANSFER, rd_ok, sizeof(rd_ok), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_OK);
+    EXPECT_EQ(i2c_mock_get_recover_count(), before);
+    const uint8_t rd_nack[] = {0x02, 0x33, 0x01, 0x00, 0x02, 0x00, 0x0F};
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_I2C_TRANSFER, rd_nack, sizeof(rd_nack), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_ERR_INTERNAL);
+    EXPECT_EQ(i2c_mock_get_recover_count(), before + 1);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "commands/inc/command.h"
+#include "commands/inc/ids.h"
+
+extern "C" {
+#include "drivers/uart/inc/uart.h"
+void uart_dma_test_reset(void);
+void grlc_cmd_register_builtin(void);
+}
+
+TEST(SetLinkCommand, GetReportsDefaultLink)
+{
+    uart_dma_test_reset();
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+    const uint8_t req[] = {0x00};
+    uint8_t out[16]; size_t out_len = sizeof(out);
+    uint16_t st = 0xFFFF;
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_SET_LINK, req, sizeof(req), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_OK);
+    ASSERT_EQ(out_len, 6u);
+    uint32_t baud = out[0] | (out[1] << 8) | (out[2] << 16) | ((uint32_t)out[3] << 24);
+    EXPECT_EQ(baud, 115200u);
+    EXPECT_EQ(out[4], 0u);
+    EXPECT_EQ(out[5], (uint8_t)UART_LINK_STATE_IDLE);
+}
+
+TEST(SetLinkCommand, SetValidatesAndQueuesSwitch)
+{
+    uart_dma_test_reset();
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+    uint8_t out[8]; size_t out_len = sizeof(out);
+    uint16_t st = 0xFFFF;
+
+    // 123456 baud is not a UARTE rate
+    const uint8_t bad[] = {0x01, 0x40, 0xE2, 0x01, 0x00, 0x00, 0x00, 0x00};
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_SET_LINK, bad, sizeof(bad), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+
+    // 1 Mbaud with flow control, confirm window 500 ms
+    const uint8_t good[] = {0x01, 0x40, 0x42, 0x0F, 0x00, 0x01, 0xF4, 0x01};
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_SET_LINK, good, sizeof(good), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_OK);
+    EXPECT_EQ(out_len, 0u);
+
+    out_len = sizeof(out);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_SET_LINK, good, sizeof(good), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_ERR_BUSY);
+
+    uart_link_state state;
+    grlc_uart_link_get(nullptr, &state);
+    EXPECT_EQ(state, UART_LINK_STATE_PENDING);
+    uart_dma_test_reset();
+}
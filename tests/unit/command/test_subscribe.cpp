@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "cmd_harness.h"
+
+extern "C" {
+#include "commands/inc/ids.h"
+#include "drivers/tmp119/inc/tmp119.h"
+#include "stack/telemetry/inc/telemetry.h"
+void i2c_mock_set_present_addr(uint8_t a);
+void i2c_mock_set_temp_raw(int16_t raw);
+}
+
+using namespace cmd_harness;
+
+namespace {
+
+class Subscribe : public ::testing::Test {
+protected:
+    void SetUp() override { loopback_init(); }
+
+    void TearDown() override { (void)grlc_telemetry_unsubscribe(&g_bind, 0); }
+
+    // Send one SUBSCRIBE request and return the response payload
+    static std::vector<uint8_t> request(const std::vector<uint8_t> &payload, uint16_t *status)
+    {
+        return loopback_request(CMD_ID_SUBSCRIBE, 0x0042, payload, status);
+    }
+
+    // Body of notification i: [id][topic][seq u16][t_ms u32][data]
+    static std::vector<uint8_t> notification(size_t i)
+    {
+        const Msg &m = g_rx.at(i);
+        EXPECT_FALSE(m.is_response);
+        uint16_t cmd = 0, st = 0xFFFF;
+        const uint8_t *pl = nullptr;
+        uint16_t pl_len = 0;
+        EXPECT_TRUE(grlc_cmd_parse_response(m.data.data(), m.data.size(), &cmd, &st, &pl,
+                                            &pl_len));
+        EXPECT_EQ(cmd, CMD_ID_SUBSCRIBE);
+        EXPECT_EQ(st, CMD_STATUS_OK);
+        return std::vector<uint8_t>(pl, pl + pl_len);
+    }
+};
+
+} // namespace
+
+TEST_F(Subscribe, PeriodicUptimeIsPushedWithoutRequests)
+{
+    uint16_t st = 0xFFFF;
+    // ADD topic=UPTIME period=100 ms threshold=0
+    auto r = request({0x01, TELEMETRY_TOPIC_UPTIME, 100, 0, 0, 0}, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    ASSERT_EQ(r.size(), 1u);
+    uint8_t id = r[0];
+    ASSERT_GE(id, 1);
+
+    EXPECT_EQ(grlc_telemetry_service(&g_bind, 1000), 100u);
+    ASSERT_EQ(g_rx.size(), 1u);
+    EXPECT_EQ(g_rx[0].session, GRLC_CMD_NOTIFY_SESSION_BASE | id);
+    auto n = notification(0);
+    ASSERT_EQ(n.size(), 16u);
+    EXPECT_EQ(n[0], id);
+    EXPECT_EQ(n[1], TELEMETRY_TOPIC_UPTIME);
+    EXPECT_EQ(n[2] | (n[3] << 8), 0);
+    uint32_t t_ms = 0;
+    uint64_t uptime = 0;
+    memcpy(&t_ms, &n[4], 4);
+    memcpy(&uptime, &n[8], 8);
+    EXPECT_EQ(t_ms, 1000u);
+    EXPECT_EQ(uptime, 123456789ull);
+
+    // Nothing until the next period; then one more with the next sequence number
+    EXPECT_EQ(grlc_telemetry_service(&g_bind, 1050), 50u);
+    EXPECT_EQ(g_rx.size(), 1u);
+    EXPECT_EQ(grlc_telemetry_service(&g_bind, 1100), 100u);
+    ASSERT_EQ(g_rx.size(), 2u);
+    n = notification(1);
+    EXPECT_EQ(n[2] | (n[3] << 8), 1);
+
+    // LIST reports the subscription; REMOVE stops it
+    r = request({0x03}, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+    ASSERT_EQ(r.size(), 1u + 12u);
+    EXPECT_EQ(r[0], 1);
+    EXPECT_EQ(r[1], id);
+    EXPECT_EQ(r[3] | (r[4] << 8), 100);
+    EXPECT_EQ(r[7] | (r[8] << 8), 2);
+    (void)request({0x02, id}, &st);
+    EXPECT_EQ(st, CMD_STATUS_OK);
+    EXPECT_EQ(grlc_telemetry_service(&g_bind, 1200), GRLC_TELEMETRY_IDLE);
+    EXPECT_TRUE(g_rx.empty());
+    (void)request({0x02, id}, &st);
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+}
+
+TEST_F(Subscribe, Tmp119OnChangeSendsOnlyPastThreshold)
+{
+    i2c_mock_set_present_addr(0x48);
+    i2c_mock_set_temp_raw(0x0C80);
+    ASSERT_GE(grlc_tmp119_boot_init(), 1);
+
+    uint16_t st = 0xFFFF;
+    // ADD topic=TMP119 period=20 ms threshold=16 (0.125 C)
+    auto r = request({0x01, TELEMETRY_TOPIC_TMP119, 20, 0, 16, 0}, &st);
+    ASSERT_EQ(st, CMD_STATUS_OK);
+
+    (void)grlc_telemetry_service(&g_bind, 0);
+    ASSERT_EQ(g_rx.size(), 1u);
+    auto n = notification(0);
+    ASSERT_EQ(n.size(), 8u + 1u + 3u);
+    EXPECT_EQ(n[8], 1);
+    EXPECT_EQ(n[9], 0x48);
+    EXPECT_EQ((int16_t)(n[10] | (n[11] << 8)), 0x0C80);
+
+    // Below the threshold: checked but not sent
+    i2c_mock_set_temp_raw(0x0C80 + 15);
+    (void)grlc_telemetry_service(&g_bind, 20);
+    EXPECT_EQ(g_rx.size(), 1u);
+
+    i2c_mock_set_temp_raw(0x0C80 + 16);
+    (void)grlc_telemetry_service(&g_bind, 40);
+    ASSERT_EQ(g_rx.size(), 2u);
+    n = notification(1);
+    EXPECT_EQ(n[2] | (n[3] << 8), 1);
+    EXPECT_EQ((int16_t)(n[10] | (n[11] << 8)), 0x0C80 + 16);
+    i2c_mock_set_temp_raw(0x0C80);
+}
+
+TEST_F(Subscribe, RejectsBadRequestsAndDirectDispatch)
+{
+    uint16_t st = 0xFFFF;
+    (void)request({0x01, 0x7F, 100, 0, 0, 0}, &st); // unknown topic
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+    (void)request({0x01, TELEMETRY_TOPIC_UPTIME, 5, 0, 0, 0}, &st); // period too short
+    EXPECT_EQ(st, CMD_STATUS_ERR_INVALID);
+
+    // Without a link there is nowhere to push to
+    const uint8_t add[] = {0x01, TELEMETRY_TOPIC_UPTIME, 100, 0, 0, 0};
+    uint8_t out[16];
+    size_t out_len = sizeof(out);
+    EXPECT_TRUE(grlc_cmd_dispatch(CMD_ID_SUBSCRIBE, add, sizeof(add), out, &out_len, &st));
+    EXPECT_EQ(st, CMD_STATUS_ERR_UNSUPPORTED);
+}
@@ -6,6 +6,13 @@ extern "C" {
 #include "commands/inc/command.h"
 #include "commands/inc/ids.h"
 #include "commands/inc/register_all.h"
+#include "drivers/tmp119/inc/tmp119.h"
+#include "stack/tmp119_sampler/inc/tmp119_sampler.h"
+#include "utils/delta/inc/delta.h"
+void i2c_mock_set_present_addr(uint8_t a);
+void i2c_mock_set_temp_raw(int16_t raw);
+uint32_t i2c_mock_get_delay_us(void);
+unsigned i2c_mock_get_xfer_count(void);
 }
 
 static std::vector<uint8_t> pack_req(uint16_t cmd, const std::vector<uint8_t> &payload)
@@ -64,3 +71,284 @@ TEST(TMP119Commands, ReadTemp_mC)
     EXPECT_EQ(mc, 25000); // 25.000 C
 }
 
+
+TEST(TMP119Commands, SamplerHistoryReturnsNewestSamples)
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+    i2c_mock_set_present_addr(0x48);
+    ASSERT_GE(grlc_tmp119_boot_init(), 1);
+
+    uint8_t resp[256];
+    size_t out_len = sizeof(resp);
+    uint16_t status = 0xFFFF;
+    const uint8_t bad[] = {0x10, 0x00, 0x05, 0x00}; // 5 ms is below the conversion time
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, bad, sizeof(bad), resp, &out_len, &status));
+    EXPECT_EQ(status, CMD_STATUS_ERR_INVALID);
+    const uint8_t start[] = {0x10, 0x00, 100, 0x00}; // 100 ms
+    out_len = sizeof(resp);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, start, sizeof(start), resp, &out_len, &status));
+    ASSERT_EQ(status, CMD_STATUS_OK);
+
+    struct tmp119_sampler_status ss;
+    grlc_tmp119_sampler_get(&ss);
+    uint32_t base = ss.next_seq;
+    const int16_t temps[] = {0x0C80, 0x0D00, 0x0D80};
+    i2c_mock_set_temp_raw(temps[0]);
+    EXPECT_EQ(1, grlc_tmp119_sampler_poll(1000)); // first round runs immediately
+    EXPECT_EQ(0, grlc_tmp119_sampler_poll(1050)); // not due yet
+    i2c_mock_set_temp_raw(temps[1]);
+    EXPECT_EQ(1, grlc_tmp119_sampler_poll(1100));
+    i2c_mock_set_temp_raw(temps[2]);
+    EXPECT_EQ(1, grlc_tmp119_sampler_poll(1200));
+
+    // Newest two samples, oldest first
+    const uint8_t hist[] = {0x11, 0x00, 0x02, 0x00};
+    out_len = sizeof(resp);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, hist, sizeof(hist), resp, &out_len, &status));
+    ASSERT_EQ(status, CMD_STATUS_OK);
+    ASSERT_EQ(out_len, 12u + 2u * GRLC_TMP119_SAMPLE_WIRE_LEN);
+    auto u32 = [&](size_t o) {
+        return (uint32_t)resp[o] | (resp[o + 1] << 8) | (resp[o + 2] << 16) |
+               ((uint32_t)resp[o + 3] << 24);
+    };
+    EXPECT_EQ(u32(0), base + 3);
+    EXPECT_EQ(u32(4), base + 1);
+    EXPECT_EQ(resp[8] | (resp[9] << 8), 100);
+    EXPECT_EQ(resp[10] | (resp[11] << 8), 2);
+    for (int i = 0; i < 2; ++i) {
+        const uint8_t *p = &resp[12 + i * GRLC_TMP119_SAMPLE_WIRE_LEN];
+        EXPECT_EQ(p[0] | (p[1] << 8), 1100 + 100 * i);
+        EXPECT_EQ(p[4], 0x48);
+        EXPECT_EQ((int16_t)(p[5] | (p[6] << 8)), temps[1 + i]);
+    }
+
+    // Resuming from next_seq yields nothing new
+    uint32_t next = u32(0);
+    const uint8_t since[] = {0x11, 0x00, 0xFF, 0x00, (uint8_t)next, (uint8_t)(next >> 8),
+                             (uint8_t)(next >> 16), (uint8_t)(next >> 24)};
+    out_len = sizeof(resp);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, since, sizeof(since), resp, &out_len, &status));
+    ASSERT_EQ(status, CMD_STATUS_OK);
+    EXPECT_EQ(out_len, 12u);
+
+    const uint8_t stop[] = {0x10, 0x00, 0x00, 0x00};
+    out_len = sizeof(resp);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, stop, sizeof(stop), resp, &out_len, &status));
+    EXPECT_EQ(0, grlc_tmp119_sampler_poll(5000));
+    i2c_mock_set_temp_raw(0x0C80);
+}
+
+TEST(TMP119Commands, DataReadyInterruptFeedsSampler)
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+    i2c_mock_set_present_addr(0x48);
+    ASSERT_GE(grlc_tmp119_boot_init(), 1);
+
+    uint8_t resp[64];
+    size_t out_len = sizeof(resp);
+    uint16_t status = 0xFFFF;
+    const uint8_t on[] = {0x12, 0x48, 0x01};
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, on, sizeof(on), resp, &out_len, &status));
+    ASSERT_EQ(status, CMD_STATUS_OK);
+    uint16_t cfg = 0;
+    ASSERT_EQ(0, grlc_tmp119_read_config(0x48, &cfg));
+    EXPECT_TRUE(cfg & 0x0004); // DR/Alert routes Data_Ready to ALERT
+
+    struct tmp119_sampler_status ss;
+    grlc_tmp119_sampler_get(&ss);
+    EXPECT_EQ(ss.drdy_addr, 0x48);
+    uint32_t base = ss.next_seq;
+    // Each edge yields exactly one sample
+    i2c_mock_set_temp_raw(0x0D00);
+    grlc_tmp119_drdy_isr();
+    i2c_mock_set_temp_raw(0x0D80);
+    grlc_tmp119_drdy_isr();
+    grlc_tmp119_sampler_get(&ss);
+    EXPECT_EQ(ss.next_seq, base + 2);
+    uint8_t out[2 * GRLC_TMP119_SAMPLE_WIRE_LEN];
+    uint32_t first = 0;
+    ASSERT_EQ(2u, grlc_tmp119_sampler_encode(base, 8, out, sizeof(out), &first));
+    EXPECT_EQ(out[4], 0x48);
+    EXPECT_EQ((int16_t)(out[5] | (out[6] << 8)), 0x0D00);
+    EXPECT_EQ((int16_t)(out[12] | (out[13] << 8)), 0x0D80);
+
+    // The periodic poll leaves the interrupt-driven sensor alone
+    ASSERT_EQ(0, grlc_tmp119_sampler_set(100));
+    EXPECT_EQ(0, grlc_tmp119_sampler_poll(10000));
+    ASSERT_EQ(0, grlc_tmp119_sampler_set(0));
+
+    const uint8_t off[] = {0x12, 0x48, 0x00};
+    out_len = sizeof(resp);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, off, sizeof(off), resp, &out_len, &status));
+    ASSERT_EQ(status, CMD_STATUS_OK);
+    ASSERT_EQ(0, grlc_tmp119_read_config(0x48, &cfg));
+    EXPECT_FALSE(cfg & 0x0004);
+    grlc_tmp119_drdy_isr();
+    grlc_tmp119_sampler_get(&ss);
+    EXPECT_EQ(ss.next_seq, base + 2);
+    EXPECT_EQ(ss.drdy_addr, 0);
+    i2c_mock_set_temp_raw(0x0C80);
+}
+
+TEST(TMP119Commands, OneShotAllTriggersEverySensorTogether)
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+    i2c_mock_set_present_addr(0x48);
+    ASSERT_GE(grlc_tmp119_boot_init(), 1);
+    uint16_t cfg_before = 0;
+    ASSERT_EQ(0, grlc_tmp119_read_config(0x48, &cfg_before));
+    i2c_mock_set_temp_raw(0x0D40);
+
+    uint32_t delay0 = i2c_mock_get_delay_us();
+    unsigned xfers0 = i2c_mock_get_xfer_count();
+    uint8_t resp[64];
+    size_t out_len = sizeof(resp);
+    uint16_t status = 0xFFFF;
+    const uint8_t req[] = {0x13, 0x00};
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, req, sizeof(req), resp, &out_len, &status));
+    ASSERT_EQ(status, CMD_STATUS_OK);
+    ASSERT_EQ(out_len, 5u + 3u);
+    EXPECT_EQ(resp[4], 1);
+    EXPECT_EQ(resp[5], 0x48);
+    EXPECT_EQ((int16_t)(resp[6] | (resp[7] << 8)), 0x0D40);
+
+    // Trigger, read, restore; the conversion wait stays off the bus queue
+    EXPECT_EQ(i2c_mock_get_delay_us() - delay0, 0u);
+    EXPECT_EQ(i2c_mock_get_xfer_count() - xfers0, 3u);
+    struct tmp119_reading r[TMP119_MAX_DEVICES];
+    uint32_t conv_us = 0;
+    ASSERT_EQ(1, grlc_tmp119_oneshot_all(r, TMP119_MAX_DEVICES, &conv_us));
+    EXPECT_EQ(conv_us, 17050u); // AVG=0: 15.5 ms + 10%
+    uint16_t cfg_after = 0;
+    ASSERT_EQ(0, grlc_tmp119_refresh(0x48));
+    ASSERT_EQ(0, grlc_tmp119_read_config(0x48, &cfg_after));
+    EXPECT_EQ(cfg_after, cfg_before);
+    i2c_mock_set_temp_raw(0x0C80);
+}
+
+TEST(TMP119Commands, AggregateWindowsSummarizeSamples)
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+    i2c_mock_set_present_addr(0x48);
+    ASSERT_GE(grlc_tmp119_boot_init(), 1);
+
+    uint8_t resp[256];
+    size_t out_len = sizeof(resp);
+    uint16_t status = 0xFFFF;
+    // block=4, ma_len=4, ema_shift=0
+    const uint8_t set[] = {0x14, 0x00, 4, 0, 4, 0};
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, set, sizeof(set), resp, &out_len, &status));
+    ASSERT_EQ(status, CMD_STATUS_OK);
+    struct tmp119_sampler_status ss;
+    grlc_tmp119_sampler_get(&ss);
+    uint32_t base = ss.next_window_seq;
+
+    ASSERT_EQ(0, grlc_tmp119_sampler_set(100));
+    const int16_t temps[] = {0x0C80, 0x0C90, 0x0C70, 0x0CA0, 0x0D00};
+    uint32_t now = 200000;
+    for (int16_t t : temps) {
+        i2c_mock_set_temp_raw(t);
+        ASSERT_EQ(1, grlc_tmp119_sampler_poll(now));
+        now += 100;
+    }
+    ASSERT_EQ(0, grlc_tmp119_sampler_set(0));
+
+    const uint8_t get[] = {0x15, 0x00, 0xFF, 0xFF, (uint8_t)base, (uint8_t)(base >> 8),
+                           (uint8_t)(base >> 16), (uint8_t)(base >> 24)};
+    out_len = sizeof(resp);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, get, sizeof(get), resp, &out_len, &status));
+    ASSERT_EQ(status, CMD_STATUS_OK);
+    ASSERT_EQ(out_len, 12u + GRLC_TMP119_WINDOW_WIRE_LEN);
+    EXPECT_EQ(resp[8] | (resp[9] << 8), 4);   // block
+    EXPECT_EQ(resp[10] | (resp[11] << 8), 1); // one closed window; the 5th sample is pending
+    const uint8_t *w = &resp[12];
+    EXPECT_EQ(w[4], 0x48);
+    EXPECT_EQ(w[5] | (w[6] << 8), 4);
+    EXPECT_EQ((int16_t)(w[7] | (w[8] << 8)), 0x0C70);
+    EXPECT_EQ((int16_t)(w[9] | (w[10] << 8)), 0x0CA0);
+    EXPECT_EQ((int16_t)(w[11] | (w[12] << 8)), (0x0C80 + 0x0C90 + 0x0C70 + 0x0CA0 + 2) / 4);
+    EXPECT_EQ((int16_t)(w[15] | (w[16] << 8)), 0x0CA0);
+
+    const uint8_t off[] = {0x14, 0x00, 0, 0, 0, 0};
+    out_len = sizeof(resp);
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, off, sizeof(off), resp, &out_len, &status));
+    ASSERT_EQ(status, CMD_STATUS_OK);
+    i2c_mock_set_temp_raw(0x0C80);
+}
+
+TEST(TMP119Commands, PackedHistoryMatchesPlainHistory)
+{
+    grlc_cmd_registry_init();
+    grlc_cmd_register_builtin();
+    i2c_mock_set_present_addr(0x48);
+    ASSERT_GE(grlc_tmp119_boot_init(), 1);
+
+    struct tmp119_sampler_status ss;
+    grlc_tmp119_sampler_get(&ss);
+    uint32_t base = ss.next_seq;
+    ASSERT_EQ(0, grlc_tmp119_sampler_set(100));
+    uint32_t now = 300000;
+    for (int i = 0; i < 40; ++i) {
+        i2c_mock_set_temp_raw((int16_t)(0x0C80 + (i % 5) - 2));
+        ASSERT_EQ(1, grlc_tmp119_sampler_poll(now));
+        now += 100;
+    }
+    ASSERT_EQ(0, grlc_tmp119_sampler_set(0));
+
+    const uint8_t req[] = {0x16, 0x00, 0xFF, 0xFF, (uint8_t)base, (uint8_t)(base >> 8),
+                           (uint8_t)(base >> 16), (uint8_t)(base >> 24)};
+    uint8_t resp[512];
+    size_t out_len = sizeof(resp);
+    uint16_t status = 0xFFFF;
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, req, sizeof(req), resp, &out_len, &status));
+    ASSERT_EQ(status, CMD_STATUS_OK);
+    auto u32 = [&](size_t o) {
+        return (uint32_t)resp[o] | (resp[o + 1] << 8) | (resp[o + 2] << 16) |
+               ((uint32_t)resp[o + 3] << 24);
+    };
+    EXPECT_EQ(u32(0), base + 40);
+    EXPECT_EQ(u32(4), base);
+    size_t n = resp[10] | (resp[11] << 8);
+    ASSERT_EQ(n, 40u);
+    // Far smaller than the 7 bytes per sample of HISTORY
+    EXPECT_LT(out_len, 12u + n * GRLC_TMP119_SAMPLE_WIRE_LEN / 3);
+
+    size_t t_len = resp[12] | (resp[13] << 8);
+    size_t a_len = resp[14] | (resp[15] << 8);
+    ASSERT_LE(16 + t_len + a_len, out_len);
+    std::vector<int32_t> t(n), a(n), r(n);
+    ASSERT_EQ(grlc_delta_decode(&resp[16], t_len, 0, t.data(), n), t_len);
+    ASSERT_EQ(grlc_delta_decode(&resp[16 + t_len], a_len, 1, a.data(), n), a_len);
+    size_t r_len = out_len - 16 - t_len - a_len;
+    ASSERT_EQ(grlc_delta_decode(&resp[16 + t_len + a_len], r_len, 0, r.data(), n), r_len);
+    // Single sensor: undo the per-sensor order-2 time and order-1 raw residuals
+    uint32_t t1 = 0, t2 = 0;
+    int16_t r1 = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t pred = (i == 0) ? 0u : (i == 1) ? t1 : 2u * t1 - t2;
+        uint32_t ts = pred + (uint32_t)t[i];
+        t2 = t1;
+        t1 = ts;
+        int16_t raw = (int16_t)(r1 + r[i]);
+        r1 = raw;
+        EXPECT_EQ(ts, 300000u + 100u * i);
+        EXPECT_EQ(a[i], 0x48);
+        EXPECT_EQ(raw, (int16_t)(0x0C80 + (int)(i % 5) - 2));
+    }
+
+    // A short buffer keeps the newest samples that fit
+    out_len = 30;
+    ASSERT_TRUE(grlc_cmd_dispatch(CMD_ID_TMP119, req, sizeof(req), resp, &out_len, &status));
+    ASSERT_EQ(status, CMD_STATUS_OK);
+    EXPECT_LE(out_len, 30u);
+    n = resp[10] | (resp[11] << 8);
+    EXPECT_GT(n, 0u);
+    EXPECT_LT(n, 40u);
+    EXPECT_EQ(u32(0), base + 40);
+    EXPECT_EQ(u32(4), base + 40 - n);
+    i2c_mock_set_temp_raw(0x0C80);
+}
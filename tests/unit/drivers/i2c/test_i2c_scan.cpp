@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <cstdint>
+
+extern "C" {
+#include "drivers/i2c/inc/i2c_scan.h"
+void i2c_mock_set_present_addr(uint8_t a);
+unsigned i2c_mock_get_probe_count(void);
+}
+
+TEST(I2CScan, CachesResultsAndRescansSelectedRange)
+{
+    i2c_mock_set_present_addr(0x48);
+    grlc_i2c_scan_invalidate();
+    struct i2c_scan_info info;
+    grlc_i2c_scan_info(&info);
+    uint32_t gen = info.generation;
+
+    unsigned probes = i2c_mock_get_probe_count();
+    ASSERT_EQ(0, grlc_i2c_scan(GRLC_I2C_SCAN_FIRST, GRLC_I2C_SCAN_LAST, 0, 100));
+    EXPECT_EQ(i2c_mock_get_probe_count() - probes, 0x77u - 0x03u + 1u);
+    uint8_t found[8];
+    ASSERT_EQ(1u, grlc_i2c_scan_list(GRLC_I2C_SCAN_FIRST, GRLC_I2C_SCAN_LAST, found, 8));
+    EXPECT_EQ(found[0], 0x48);
+    grlc_i2c_scan_info(&info);
+    EXPECT_EQ(info.generation, gen + 1);
+    EXPECT_FALSE(info.read_probe);
+    EXPECT_EQ(info.present[0x48 >> 3], 1u << (0x48 & 7));
+
+    // Repeat scan of a known range is served from the cache
+    probes = i2c_mock_get_probe_count();
+    ASSERT_EQ(0, grlc_i2c_scan(0x03, 0x77, 0, 100));
+    EXPECT_EQ(i2c_mock_get_probe_count(), probes);
+    grlc_i2c_scan_info(&info);
+    EXPECT_EQ(info.generation, gen + 1);
+
+    // Forced rescan of a sub-range only touches that range
+    i2c_mock_set_present_addr(0x4A);
+    probes = i2c_mock_get_probe_count();
+    ASSERT_EQ(0, grlc_i2c_scan(0x40, 0x4F, GRLC_I2C_SCAN_FORCE, 100));
+    EXPECT_EQ(i2c_mock_get_probe_count() - probes, 16u);
+    EXPECT_FALSE(grlc_i2c_scan_present(0x48));
+    EXPECT_TRUE(grlc_i2c_scan_present(0x4A));
+
+    // Early abort at the first responder
+    probes = i2c_mock_get_probe_count();
+    ASSERT_EQ(0, grlc_i2c_scan(0x03, 0x77, GRLC_I2C_SCAN_FORCE | GRLC_I2C_SCAN_FIRST_ONLY, 100));
+    EXPECT_EQ(i2c_mock_get_probe_count() - probes, 0x4Au - 0x03u + 1u);
+
+    EXPECT_EQ(-EINVAL, grlc_i2c_scan(0x50, 0x40, 0, 100));
+    i2c_mock_set_present_addr(0x48);
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <cerrno>
 #include <cstdint>
 #include <csignal>
 
@@ -7,6 +8,9 @@ extern "C" {
 void i2c_mock_set_present_addr(uint8_t a);
 void i2c_mock_set_dev_id(uint16_t id);
 void i2c_mock_set_temp_raw(int16_t raw);
+uint32_t i2c_mock_get_delay_us(void);
+unsigned i2c_mock_get_xfer_count(void);
+void i2c_mock_set_config_status(uint16_t flags);
 }
 
 // Death tests require special settings on some platforms.
@@ -35,3 +39,66 @@ TEST(TMP119Init, RequireInitializedAbortsOnMissing)
     }, "project_fatal");
 }
 
+
+TEST(TMP119Init, IsPresentReflectsVerifiedAddresses)
+{
+    i2c_mock_set_present_addr(0x48);
+    i2c_mock_set_dev_id(0x2117);
+    ASSERT_GE(grlc_tmp119_boot_init(), 1);
+    EXPECT_TRUE(grlc_tmp119_is_present(0x48));
+    EXPECT_FALSE(grlc_tmp119_is_present(0x4B));
+}
+
+TEST(TMP119Init, EepromWriteRunsAsOneChain)
+{
+    i2c_mock_set_present_addr(0x48);
+    i2c_mock_set_dev_id(0x2117);
+    ASSERT_GE(grlc_tmp119_boot_init(), 1);
+    uint32_t before = i2c_mock_get_delay_us();
+    EXPECT_EQ(0, grlc_tmp119_write_eeprom(0x48, 2, 0xBEEF));
+    EXPECT_GE(i2c_mock_get_delay_us() - before, 7000u);
+    uint16_t v = 0;
+    EXPECT_EQ(0, grlc_tmp119_read_eeprom(0x48, 2, &v));
+    EXPECT_EQ(v, 0xBEEF);
+    EXPECT_EQ(-EINVAL, grlc_tmp119_write_eeprom(0x48, 4, 0x1234));
+}
+
+TEST(TMP119Init, ShadowServesRegisterReadsWithoutBus)
+{
+    i2c_mock_set_present_addr(0x48);
+    i2c_mock_set_dev_id(0x2117);
+    ASSERT_GE(grlc_tmp119_boot_init(), 1);
+    ASSERT_EQ(0, grlc_tmp119_write_high_limit(0x48, 0x3200));
+    ASSERT_EQ(0, grlc_tmp119_write_config(0x48, 0xF220)); // status bits are read-only
+
+    unsigned before = i2c_mock_get_xfer_count();
+    uint16_t v = 0;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(0, grlc_tmp119_read_high_limit(0x48, &v));
+        EXPECT_EQ(v, 0x3200);
+        EXPECT_EQ(0, grlc_tmp119_read_device_id(0x48, &v));
+        EXPECT_EQ(v, 0x2117);
+    }
+    EXPECT_EQ(i2c_mock_get_xfer_count(), before);
+
+    // Temperature is volatile and always goes to the bus
+    EXPECT_EQ(0, grlc_tmp119_read_temperature_raw(0x48, &v));
+    EXPECT_EQ(i2c_mock_get_xfer_count(), before + 1);
+
+    // CONFIG carries volatile status flags and always goes to the bus
+    EXPECT_EQ(0, grlc_tmp119_read_config(0x48, &v));
+    EXPECT_EQ(v, 0x0220);
+    EXPECT_EQ(i2c_mock_get_xfer_count(), before + 2);
+    i2c_mock_set_config_status(0x2000); // Data_Ready
+    EXPECT_EQ(0, grlc_tmp119_read_config(0x48, &v));
+    EXPECT_EQ(v, 0x2220);
+    EXPECT_EQ(0, grlc_tmp119_read_config(0x48, &v));
+    EXPECT_EQ(v, 0x0220);
+
+    // Refresh reloads from the device
+    before = i2c_mock_get_xfer_count();
+    ASSERT_EQ(0, grlc_tmp119_refresh(0x48));
+    EXPECT_GT(i2c_mock_get_xfer_count(), before);
+    EXPECT_EQ(0, grlc_tmp119_read_high_limit(0x48, &v));
+    EXPECT_EQ(v, 0x3200);
+}
@@ -9,71 +9,165 @@
 static uint8_t g_present_addr = 0x48;    /* Address that ACKs */
 static int16_t g_temp_raw = 0x0C80;      /* 25.000 C */
 static uint16_t g_dev_id = 0x2117;       /* Expected device ID */
+static uint16_t g_regs[16];              /* Writable 16-bit registers */
+static uint16_t g_cfg_status;            /* CONFIG flags, bits 15..12 */
+static uint32_t g_delay_us;              /* Sum of chain DELAY steps */
+static uint32_t g_speed_hz = 400000;     /* Current bus clock */
+static unsigned g_recover_count;         /* grlc_i2c_bus_recover() calls */
+static unsigned g_probe_count;           /* I2C_OP_PROBE steps issued */
+static unsigned g_xfer_count;            /* Bus transactions of any kind */
 
 void i2c_mock_set_present_addr(uint8_t a) { g_present_addr = a & 0x7F; }
 void i2c_mock_set_temp_raw(int16_t raw) { g_temp_raw = raw; }
 void i2c_mock_set_dev_id(uint16_t id) { g_dev_id = id; }
+void i2c_mock_set_config_status(uint16_t flags) { g_cfg_status = flags & 0xF000; }
+uint32_t i2c_mock_get_delay_us(void) { return g_delay_us; }
+unsigned i2c_mock_get_recover_count(void) { return g_recover_count; }
+unsigned i2c_mock_get_probe_count(void) { return g_probe_count; }
+unsigned i2c_mock_get_xfer_count(void) { return g_xfer_count; }
+
+static uint16_t reg_value(uint8_t reg)
+{
+    if (reg == 0x0F)
+        return g_dev_id;
+    if (reg == 0x00)
+        return (uint16_t)g_temp_raw;
+    if (reg == 0x01) {
+        /* Like the device, reading CONFIG clears the latched flags */
+        uint16_t v = (uint16_t)(g_regs[1] | g_cfg_status);
+        g_cfg_status = 0;
+        return v;
+    }
+    return g_regs[reg & 0x0F];
+}
+
+/* Execute one descriptor against the emulated device. */
+static int mock_exec(const struct i2c_op *op)
+{
+    if (op->type == I2C_OP_DELAY) {
+        g_delay_us += op->delay_us;
+        return 0;
+    }
+    g_xfer_count++;
+    g_probe_count += (op->type == I2C_OP_PROBE);
+    if (op->type == I2C_OP_READ && op->rdata && op->rlen)
+        memset(op->rdata, 0, op->rlen);
+    if ((op->addr & 0x7F) != g_present_addr)
+        return -ENODEV;
+    if (op->type == I2C_OP_WRITE && op->wdata && op->wlen >= 3) {
+        uint8_t reg = op->wdata[0];
+        uint16_t v = (uint16_t)((op->wdata[1] << 8) | op->wdata[2]);
+        if (reg == 0x01)
+            v &= 0x0FFF; /* status flags are read-only */
+        if (reg != 0x00 && reg != 0x0F)
+            g_regs[reg & 0x0F] = v;
+    }
+    if (op->type == I2C_OP_WRITE_READ && op->wdata && op->wlen >= 1 && op->rdata) {
+        memset(op->rdata, 0, op->rlen);
+        if (op->rlen >= 2) {
+            uint16_t v = reg_value(op->wdata[0]);
+            op->rdata[0] = (uint8_t)(v >> 8);
+            op->rdata[1] = (uint8_t)(v & 0xFF);
+        }
+    }
+    return 0;
+}
+
+static int mock_run(const struct i2c_op *ops, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        int rc = mock_exec(&ops[i]);
+        if (rc)
+            return rc;
+    }
+    return 0;
+}
 
 int grlc_i2c_init(void) { return 0; }
 
+/* Mirrors the nRF52 TWIM: no fast mode plus */
+int grlc_i2c_set_speed(uint32_t hz)
+{
+    if (hz != 100000u && hz != 400000u && hz != 1000000u)
+        return -EINVAL;
+    if (hz == 1000000u)
+        return -ENOTSUP;
+    g_speed_hz = hz;
+    return 0;
+}
+
+uint32_t grlc_i2c_get_speed(void) { return g_speed_hz; }
+
+int grlc_i2c_chain_submit(struct i2c_chain *chain)
+{
+    if (!chain || !chain->ops || chain->count == 0)
+        return -EINVAL;
+    int rc = mock_run(chain->ops, chain->count);
+    if (chain->cb)
+        chain->cb(rc, chain->user);
+    return 0;
+}
+
+int grlc_i2c_chain_run(const struct i2c_op *ops, size_t count, int timeout_ms)
+{
+    (void)timeout_ms;
+    if (!ops || count == 0)
+        return -EINVAL;
+    return mock_run(ops, count);
+}
+
 int grlc_i2c_write(uint16_t addr, const uint8_t *data, size_t len, i2c_async_cb_t cb, void *user)
-{ if (cb) cb(0, user); return 0; }
+{
+    const struct i2c_op op = I2C_OP_WR(addr, data, len);
+    int rc = mock_exec(&op);
+    if (cb) cb(rc, user);
+    return 0;
+}
 
 int grlc_i2c_read(uint16_t addr, uint8_t *data, size_t len, i2c_async_cb_t cb, void *user)
-{ if (data && len) memset(data, 0, len); if (cb) cb(0, user); return 0; }
+{
+    const struct i2c_op op = I2C_OP_RD(addr, data, len);
+    int rc = mock_exec(&op);
+    if (cb) cb(rc, user);
+    return 0;
+}
 
 int grlc_i2c_write_read(uint16_t addr,
                          const uint8_t *wdata, size_t wlen,
                          uint8_t *rdata, size_t rlen,
                          i2c_async_cb_t cb, void *user)
 {
-    if ((addr & 0x7F) != g_present_addr) {
-        if (cb) cb(-ENODEV, user);
-        return -ENODEV;
-    }
-    if (wdata && wlen >= 1 && rdata && rlen >= 2) {
-        uint8_t reg = wdata[0];
-        if (reg == 0x0F) {
-            rdata[0] = (uint8_t)(g_dev_id >> 8);
-            rdata[1] = (uint8_t)(g_dev_id & 0xFF);
-        } else if (reg == 0x00) {
-            rdata[0] = (uint8_t)((g_temp_raw >> 8) & 0xFF);
-            rdata[1] = (uint8_t)(g_temp_raw & 0xFF);
-        } else {
-            memset(rdata, 0, rlen);
-        }
-    }
-    if (cb) cb(0, user);
-    return 0;
+    const struct i2c_op op = I2C_OP_WR_RD(addr, wdata, wlen, rdata, rlen);
+    int rc = mock_exec(&op);
+    if (cb) cb(rc, user);
+    return rc;
 }
 
 int grlc_i2c_blocking_write(uint16_t addr, const uint8_t *data, size_t len, int timeout_ms)
-{ return ((addr & 0x7F) == g_present_addr) ? 0 : -ENODEV; }
+{
+    const struct i2c_op op = I2C_OP_WR(addr, data, len);
+    return grlc_i2c_chain_run(&op, 1, timeout_ms);
+}
 
 int grlc_i2c_blocking_read(uint16_t addr, uint8_t *data, size_t len, int timeout_ms)
-{ if (data && len) memset(data, 0, len); return ((addr & 0x7F) == g_present_addr) ? 0 : -ENODEV; }
+{
+    const struct i2c_op op = I2C_OP_RD(addr, data, len);
+    return grlc_i2c_chain_run(&op, 1, timeout_ms);
+}
 
 int grlc_i2c_blocking_write_read(uint16_t addr,
                             const uint8_t *wdata, size_t wlen,
                             uint8_t *rdata, size_t rlen,
                             int timeout_ms)
 {
-    if ((addr & 0x7F) != g_present_addr) return -ENODEV;
-    if (wdata && wlen >= 1 && rdata && rlen >= 2) {
-        uint8_t reg = wdata[0];
-        if (reg == 0x0F) {
-            rdata[0] = (uint8_t)(g_dev_id >> 8);
-            rdata[1] = (uint8_t)(g_dev_id & 0xFF);
-        } else if (reg == 0x00) {
-            rdata[0] = (uint8_t)((g_temp_raw >> 8) & 0xFF);
-            rdata[1] = (uint8_t)(g_temp_raw & 0xFF);
-        } else {
-            memset(rdata, 0, rlen);
-        }
-    }
-    return 0;
+    const struct i2c_op op = I2C_OP_WR_RD(addr, wdata, wlen, rdata, rlen);
+    return grlc_i2c_chain_run(&op, 1, timeout_ms);
 }
 
-int grlc_i2c_bus_recover(void) { return 0; }
+int grlc_i2c_bus_recover(void) { g_recover_count++; return 0; }
+
+int grlc_i2c_ping(uint16_t addr) { g_xfer_count++; return ((addr & 0x7F) == g_present_addr) ? 0 : -ENODEV; }
+
+int grlc_i2c_lock(int timeout_ms) { (void)timeout_ms; return 0; }
 
-int grlc_i2c_ping(uint16_t addr) { return ((addr & 0x7F) == g_present_addr) ? 0 : -ENODEV; }
+void grlc_i2c_unlock(void) {}
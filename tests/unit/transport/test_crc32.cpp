@@ -31,3 +31,22 @@ TEST(CRC32, IncrementalEquivalent)
 
     EXPECT_EQ(one, two);
 }
+
+TEST(CRC32, UpdateMatchesOneShotAtEverySplitAndAlignment)
+{
+    std::vector<uint8_t> data(257);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 7 + 3);
+    // Bitwise reference
+    uint32_t ref = 0xFFFFFFFFu;
+    for (uint8_t b : data) {
+        ref ^= b;
+        for (int k = 0; k < 8; ++k) ref = (ref & 1) ? (ref >> 1) ^ 0xEDB88320u : ref >> 1;
+    }
+    ref ^= 0xFFFFFFFFu;
+    EXPECT_EQ(crc32_ieee(data.data(), data.size()), ref);
+    for (size_t mid : {0u, 1u, 3u, 4u, 5u, 128u, 256u, 257u}) {
+        uint32_t c = crc32_ieee_update(0, data.data(), mid);
+        c = crc32_ieee_update(c, data.data() + mid, data.size() - mid);
+        EXPECT_EQ(c, ref) << "split " << mid;
+    }
+}
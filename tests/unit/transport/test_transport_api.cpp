@@ -33,3 +33,34 @@ TEST(TransportApi, SendZeroLengthMessage)
   EXPECT_EQ(s_last_write_len, 2u + 10u + 0u + 4u);
 }
 
+
+static size_t ctx_write(void* ctx, const uint8_t* data, size_t len)
+{
+  (void)data;
+  *static_cast<size_t*>(ctx) += len;
+  return len;
+}
+
+TEST(TransportApi, ContextWriteRoutesPerTransport)
+{
+  size_t a_bytes = 0, b_bytes = 0;
+  struct transport_lower_if lower_a = {nullptr, ctx_write, &a_bytes};
+  struct transport_lower_if lower_b = {nullptr, ctx_write, &b_bytes};
+  struct transport_ctx ta = {}, tb = {};
+  grlc_transport_init(&ta, &lower_a, nullptr, nullptr);
+  grlc_transport_init(&tb, &lower_b, nullptr, nullptr);
+  const uint8_t msg[3] = {1, 2, 3};
+  ASSERT_TRUE(grlc_transport_send_message(&ta, 1, msg, sizeof(msg), false));
+  EXPECT_EQ(a_bytes, 2u + 10u + 3u + 4u);
+  EXPECT_EQ(b_bytes, 0u);
+  ASSERT_TRUE(grlc_transport_send_message(&tb, 2, msg, 1, true));
+  EXPECT_EQ(b_bytes, 2u + 10u + 1u + 4u);
+
+  // write_ctx takes precedence over write
+  s_last_write_len = 0;
+  lower_a.write = test_write;
+  a_bytes = 0;
+  ASSERT_TRUE(grlc_transport_send_message(&ta, 3, msg, 2, false));
+  EXPECT_EQ(a_bytes, 2u + 10u + 2u + 4u);
+  EXPECT_EQ(s_last_write_len, 0u);
+}
@@ -3,6 +3,10 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
 extern "C" {
 #include "drivers/uart/inc/uart.h"
 #include "drivers/uart/inc/uart_test.h"
@@ -45,23 +49,34 @@ static int hal_rx_enable_intercept(const device *, unsigned char *buf, unsigned
 
 } // namespace
 
-TEST(UartDma, AlternatesRxBuffersOnRequest)
+TEST(UartDma, RotatesThroughRxChunkPoolOnRequest)
 {
+    static unsigned char *handed[UART_DMA_RX_CHUNK_COUNT + 1];
+    static int n = 0;
+    n = 0;
     uart_dma_test_reset();
-    uart_dma_test_set_hal_rx_buf_rsp(&hal_rx_buf_rsp_intercept);
-    // Request 1 -> expect buf0
+    uart_dma_test_set_hal_rx_buf_rsp(+[](const device *, unsigned char *buf, unsigned long len) {
+        EXPECT_EQ(len, (unsigned long)UART_DMA_RX_CHUNK_SIZE);
+        handed[n++] = buf;
+        return 0;
+    });
     uart_event e{}; e.type = UART_RX_BUF_REQUEST;
-    uart_dma_test_invoke_event(&e);
-    ASSERT_EQ(rx_buf_rsp_calls, 1);
-    EXPECT_EQ(last_rx_buf_rsp_idx, 0);
-    // Request 2 -> expect buf1
-    uart_dma_test_invoke_event(&e);
-    ASSERT_EQ(rx_buf_rsp_calls, 2);
-    EXPECT_EQ(last_rx_buf_rsp_idx, 1);
-    // Request 3 -> back to buf0
-    uart_dma_test_invoke_event(&e);
-    ASSERT_EQ(rx_buf_rsp_calls, 3);
-    EXPECT_EQ(last_rx_buf_rsp_idx, 0);
+    for (int i = 0; i <= UART_DMA_RX_CHUNK_COUNT; ++i) {
+        uart_dma_test_invoke_event(&e);
+    }
+    ASSERT_EQ(n, UART_DMA_RX_CHUNK_COUNT + 1);
+    // Every chunk of the pool is used once before wrapping back to the first
+    for (int i = 0; i < UART_DMA_RX_CHUNK_COUNT; ++i) {
+        for (int j = i + 1; j < UART_DMA_RX_CHUNK_COUNT; ++j) {
+            EXPECT_NE(handed[i], handed[j]);
+        }
+    }
+    EXPECT_EQ(handed[UART_DMA_RX_CHUNK_COUNT], handed[0]);
+    uart_statistics s{}; grlc_uart_get_statistics(&s);
+    EXPECT_EQ(s.isr_rx_buf_req, (uint32_t)UART_DMA_RX_CHUNK_COUNT + 1);
+
+    // Restore the interceptor used by the remaining tests
+    uart_dma_test_set_hal_rx_buf_rsp(&hal_rx_buf_rsp_intercept);
 }
 
 TEST(UartDma, RestartSetsIndexAndEnables)
@@ -109,3 +124,129 @@ TEST(UartDma, RxStoppedUpdatesStatsAndRestart)
     // We expect rx_enable to have been called on each stop when initialized
     EXPECT_GE(rx_enable_calls, 1);
 }
+
+TEST(UartDma, NotifyHookFiresOnRxAndTxDone)
+{
+    static uint32_t seen = 0;
+    static int calls = 0;
+    seen = 0;
+    calls = 0;
+    uart_dma_test_reset();
+    grlc_uart_set_notify(+[](uint32_t ev) {
+        seen |= ev;
+        calls++;
+    });
+
+    unsigned char chunk[4] = {1, 2, 3, 4};
+    uart_event rx{}; rx.type = UART_RX_RDY; rx.data.rx.buf = chunk; rx.data.rx.len = 4; rx.data.rx.offset = 0;
+    uart_dma_test_invoke_event(&rx);
+    EXPECT_EQ(seen, UART_NOTIFY_RX);
+    EXPECT_EQ(grlc_uart_rx_available(), 4u);
+
+    uart_event tx{}; tx.type = UART_TX_DONE; tx.data.tx.len = 0;
+    uart_dma_test_invoke_event(&tx);
+    EXPECT_EQ(seen, UART_NOTIFY_RX | UART_NOTIFY_TX);
+    EXPECT_EQ(calls, 2);
+
+    // Removing the hook stops notifications
+    grlc_uart_set_notify(nullptr);
+    uart_dma_test_invoke_event(&rx);
+    EXPECT_EQ(calls, 2);
+    uart_dma_test_reset();
+}
+
+TEST(UartDma, RxTimeoutTracksBaudRate)
+{
+    static unsigned int last_timeout = 0;
+    static int disables = 0;
+    disables = 0;
+    uart_dma_test_reset();
+    uart_dma_test_set_hal_rx_enable(+[](const device *, unsigned char *, unsigned long,
+                                        unsigned int timeout) {
+        last_timeout = timeout;
+        return 0;
+    });
+    uart_dma_test_set_hal_rx_disable(+[](const device *) {
+        disables++;
+        return 0;
+    });
+    uart_dma_test_set_hal_configure(+[](const device *, const uart_config *) { return 0; });
+
+    // 115200 baud: 4 chars * 10 bits ~= 348 us
+    uart_event dis{}; dis.type = UART_RX_DISABLED;
+    uart_dma_test_invoke_event(&dis);
+    EXPECT_EQ(last_timeout, 348u);
+    uart_statistics s{}; grlc_uart_get_statistics(&s);
+    EXPECT_EQ(s.rx_timeout_us, 348u);
+    EXPECT_EQ(s.isr_rx_restarts, 1u);
+
+    // Switching to 1 Mbaud restarts RX; the new timeout is clamped to the floor
+    uart_link_cfg cfg{1000000, false};
+    ASSERT_EQ(grlc_uart_link_request(&cfg, 100), UART_DMA_STATUS_OK);
+    EXPECT_EQ(grlc_uart_link_service(0, false), UART_LINK_STATE_PROBATION);
+    EXPECT_EQ(disables, 1);
+    uart_dma_test_invoke_event(&dis);
+    EXPECT_EQ(last_timeout, 100u);
+
+    // Slow links are capped at the ceiling
+    uart_dma_test_reset();
+    uart_link_cfg slow{1200, false};
+    ASSERT_EQ(grlc_uart_link_request(&slow, 100), UART_DMA_STATUS_OK);
+    EXPECT_EQ(grlc_uart_link_service(0, false), UART_LINK_STATE_PROBATION);
+    uart_dma_test_invoke_event(&dis);
+    EXPECT_EQ(last_timeout, 20000u);
+
+    uart_dma_test_set_hal_rx_disable(nullptr);
+    uart_dma_test_set_hal_rx_enable(&hal_rx_enable_intercept);
+    uart_dma_test_reset();
+}
+
+TEST(UartDma, RxConsumeHandsSpansAcrossWrap)
+{
+    struct Sink {
+        uint8_t data[UART_DMA_RX_BUFFER_SIZE];
+        size_t len;
+        int calls;
+        size_t limit;
+    };
+    static Sink sink;
+    auto consume = [](const uint8_t *d, size_t n, void *user) -> size_t {
+        Sink *k = static_cast<Sink *>(user);
+        size_t take = n < k->limit ? n : k->limit;
+        memcpy(&k->data[k->len], d, take);
+        k->len += take;
+        k->limit -= take;
+        k->calls++;
+        return take;
+    };
+
+    uart_dma_test_reset();
+    // Push the ring indices near the end so the next write wraps
+    std::vector<unsigned char> fill(UART_DMA_RX_BUFFER_SIZE - 10, 0xEE);
+    uart_event rx{}; rx.type = UART_RX_RDY; rx.data.rx.buf = fill.data(); rx.data.rx.len = fill.size();
+    uart_dma_test_invoke_event(&rx);
+    sink = Sink{};
+    sink.limit = SIZE_MAX;
+    ASSERT_EQ(grlc_uart_rx_consume(consume, &sink), fill.size());
+
+    unsigned char pattern[32];
+    for (int i = 0; i < 32; ++i) pattern[i] = (unsigned char)i;
+    rx.data.rx.buf = pattern; rx.data.rx.len = sizeof(pattern);
+    uart_dma_test_invoke_event(&rx);
+
+    sink = Sink{};
+    sink.limit = SIZE_MAX;
+    EXPECT_EQ(grlc_uart_rx_consume(consume, &sink), sizeof(pattern));
+    EXPECT_EQ(sink.calls, 2); // split at the wrap
+    ASSERT_EQ(sink.len, sizeof(pattern));
+    EXPECT_EQ(0, memcmp(sink.data, pattern, sizeof(pattern)));
+    EXPECT_EQ(grlc_uart_rx_available(), 0u);
+
+    // A consumer that stops early leaves the rest queued
+    uart_dma_test_invoke_event(&rx);
+    sink = Sink{};
+    sink.limit = 5;
+    EXPECT_EQ(grlc_uart_rx_consume(consume, &sink), 5u);
+    EXPECT_EQ(grlc_uart_rx_available(), sizeof(pattern) - 5);
+    uart_dma_test_reset();
+}
@@ -0,0 +1,113 @@
+// Unit tests for UART link negotiation (baud/flow switch with rollback)
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "drivers/uart/inc/uart.h"
+#include "drivers/uart/inc/uart_test.h"
+}
+
+namespace {
+
+static int cfg_calls = 0;
+static int cfg_rc = 0;
+static unsigned int last_baud = 0;
+static unsigned char last_flow = 0;
+
+static int stub_configure(const device *, const uart_config *cfg)
+{
+    cfg_calls++;
+    last_baud = cfg->baudrate;
+    last_flow = cfg->flow_ctrl;
+    return cfg_rc;
+}
+
+static int stub_tx(const device *, const unsigned char *, unsigned long, unsigned int)
+{
+    return 0;
+}
+
+class UartLink : public ::testing::Test {
+  protected:
+    void SetUp() override
+    {
+        cfg_calls = 0;
+        cfg_rc = 0;
+        last_baud = 0;
+        last_flow = 0;
+        uart_dma_test_set_hal_configure(&stub_configure);
+        uart_dma_test_set_hal_tx(&stub_tx);
+        uart_dma_test_reset();
+    }
+};
+
+} // namespace
+
+TEST_F(UartLink, RejectsUnsupportedBaud)
+{
+    EXPECT_TRUE(grlc_uart_link_baud_supported(1000000));
+    EXPECT_FALSE(grlc_uart_link_baud_supported(123456));
+    uart_link_cfg cfg{123456, false};
+    EXPECT_EQ(grlc_uart_link_request(&cfg, 500), UART_DMA_STATUS_ERROR);
+    uart_link_state st;
+    grlc_uart_link_get(nullptr, &st);
+    EXPECT_EQ(st, UART_LINK_STATE_IDLE);
+}
+
+TEST_F(UartLink, SwitchWaitsForTxDrainThenCommitsOnFrame)
+{
+    uart_link_cfg cfg{1000000, true};
+    ASSERT_EQ(grlc_uart_link_request(&cfg, 500), UART_DMA_STATUS_OK);
+    EXPECT_EQ(grlc_uart_link_request(&cfg, 500), UART_DMA_STATUS_BUSY);
+
+    // Response still in flight: no reconfigure yet
+    const uint8_t ack[4] = {1, 2, 3, 4};
+    ASSERT_EQ(grlc_uart_send(ack, sizeof(ack)), UART_DMA_STATUS_OK);
+    EXPECT_EQ(grlc_uart_link_service(0, false), UART_LINK_STATE_PENDING);
+    EXPECT_EQ(cfg_calls, 0);
+
+    uart_event e{};
+    e.type = UART_TX_DONE;
+    e.data.tx.len = sizeof(ack);
+    uart_dma_test_invoke_event(&e);
+
+    EXPECT_EQ(grlc_uart_link_service(10, false), UART_LINK_STATE_PROBATION);
+    EXPECT_EQ(cfg_calls, 1);
+    EXPECT_EQ(last_baud, 1000000u);
+    EXPECT_EQ(last_flow, 1u);
+
+    EXPECT_EQ(grlc_uart_link_service(100, true), UART_LINK_STATE_IDLE);
+    uart_link_cfg now{};
+    grlc_uart_link_get(&now, nullptr);
+    EXPECT_EQ(now.baudrate, 1000000u);
+    EXPECT_TRUE(now.flow_ctrl);
+}
+
+TEST_F(UartLink, RollsBackWithoutConfirmation)
+{
+    uart_link_cfg cfg{921600, false};
+    ASSERT_EQ(grlc_uart_link_request(&cfg, 200), UART_DMA_STATUS_OK);
+    EXPECT_EQ(grlc_uart_link_service(1000, false), UART_LINK_STATE_PROBATION);
+    EXPECT_EQ(grlc_uart_link_service(1199, false), UART_LINK_STATE_PROBATION);
+    EXPECT_EQ(grlc_uart_link_service(1200, false), UART_LINK_STATE_IDLE);
+    EXPECT_EQ(cfg_calls, 2);
+    EXPECT_EQ(last_baud, 115200u);
+
+    uart_link_cfg now{};
+    grlc_uart_link_get(&now, nullptr);
+    EXPECT_EQ(now.baudrate, 115200u);
+    uart_statistics stats{};
+    grlc_uart_get_statistics(&stats);
+    EXPECT_EQ(stats.link_rollbacks, 1u);
+}
+
+TEST_F(UartLink, ConfigureFailureKeepsCurrentSettings)
+{
+    cfg_rc = -5;
+    uart_link_cfg cfg{230400, false};
+    ASSERT_EQ(grlc_uart_link_request(&cfg, 0), UART_DMA_STATUS_OK);
+    EXPECT_EQ(grlc_uart_link_service(0, false), UART_LINK_STATE_IDLE);
+    uart_link_cfg now{};
+    grlc_uart_link_get(&now, nullptr);
+    EXPECT_EQ(now.baudrate, 115200u);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file test_aggregate.cpp
+ * @brief Unit tests for fixed-point sample aggregation
+ */
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "utils/aggregate/inc/aggregate.h"
+}
+
+TEST(Aggregate, RejectsInvalidConfiguration)
+{
+    aggregate_t a;
+    EXPECT_EQ(-1, grlc_agg_init(&a, 0, 1, 0));
+    EXPECT_EQ(-1, grlc_agg_init(&a, 4, 0, 0));
+    EXPECT_EQ(-1, grlc_agg_init(&a, 4, GRLC_AGG_MA_MAX + 1, 0));
+    EXPECT_EQ(-1, grlc_agg_init(&a, 4, 4, GRLC_AGG_EMA_SHIFT_MAX + 1));
+    EXPECT_EQ(0, grlc_agg_init(&a, 4, 4, 2));
+}
+
+TEST(Aggregate, BlockStatisticsCloseEveryNSamples)
+{
+    aggregate_t a;
+    ASSERT_EQ(0, grlc_agg_init(&a, 4, 2, 0));
+    aggregate_window_t w{};
+    EXPECT_FALSE(grlc_agg_push(&a, 10, &w));
+    EXPECT_FALSE(grlc_agg_push(&a, -3, &w));
+    EXPECT_FALSE(grlc_agg_push(&a, 7, &w));
+    ASSERT_TRUE(grlc_agg_push(&a, 1, &w));
+    EXPECT_EQ(w.count, 4);
+    EXPECT_EQ(w.min, -3);
+    EXPECT_EQ(w.max, 10);
+    EXPECT_EQ(w.mean, 4);  // 15 / 4 = 3.75
+    EXPECT_EQ(w.ma, 4);    // (7 + 1) / 2
+    EXPECT_EQ(w.ema, 1);   // k = 0 tracks the input
+
+    // Next block starts fresh
+    for (int16_t x : {-5, -6, -6}) EXPECT_FALSE(grlc_agg_push(&a, x, &w));
+    ASSERT_TRUE(grlc_agg_push(&a, -6, &w));
+    EXPECT_EQ(w.min, -6);
+    EXPECT_EQ(w.max, -5);
+    EXPECT_EQ(w.mean, -6); // -23 / 4 = -5.75
+}
+
+TEST(Aggregate, MovingAverageAndFilterTrackAStep)
+{
+    aggregate_t a;
+    ASSERT_EQ(0, grlc_agg_init(&a, 1000, 8, 3));
+    for (int i = 0; i < 8; ++i) grlc_agg_push(&a, 3200, nullptr);
+    EXPECT_EQ(grlc_agg_ma(&a), 3200);
+    EXPECT_EQ(grlc_agg_ema(&a), 3200);
+
+    // Step up by 800: the moving average reaches it after 8 samples,
+    // the filter closes 1/8 of the gap per sample
+    grlc_agg_push(&a, 4000, nullptr);
+    EXPECT_EQ(grlc_agg_ma(&a), 3300);
+    EXPECT_EQ(grlc_agg_ema(&a), 3300);
+    for (int i = 0; i < 7; ++i) grlc_agg_push(&a, 4000, nullptr);
+    EXPECT_EQ(grlc_agg_ma(&a), 4000);
+    int16_t ema = grlc_agg_ema(&a);
+    EXPECT_GT(ema, 3600);
+    EXPECT_LT(ema, 4000);
+    for (int i = 0; i < 200; ++i) grlc_agg_push(&a, 4000, nullptr);
+    EXPECT_EQ(grlc_agg_ema(&a), 4000);
+
+    // Reset keeps the configuration
+    grlc_agg_reset(&a);
+    EXPECT_EQ(grlc_agg_ma(&a), 0);
+    grlc_agg_push(&a, -128, nullptr);
+    EXPECT_EQ(grlc_agg_ma(&a), -128);
+    EXPECT_EQ(grlc_agg_ema(&a), -128);
+}
+
+TEST(Aggregate, SlowFilterSettlesOnAStep)
+{
+    // k = 12: a Q8 state would stall up to 15 counts below a rising input
+    aggregate_t a;
+    ASSERT_EQ(0, grlc_agg_init(&a, 1000, 1, GRLC_AGG_EMA_SHIFT_MAX));
+    grlc_agg_push(&a, 0, nullptr);
+    for (int i = 0; i < 40000; ++i) grlc_agg_push(&a, 100, nullptr);
+    EXPECT_EQ(grlc_agg_ema(&a), 100);
+    for (int i = 0; i < 40000; ++i) grlc_agg_push(&a, -100, nullptr);
+    EXPECT_EQ(grlc_agg_ema(&a), -100);
+
+    // Full-scale swings do not overflow the state
+    for (int i = 0; i < 80000; ++i) grlc_agg_push(&a, INT16_MAX, nullptr);
+    EXPECT_EQ(grlc_agg_ema(&a), INT16_MAX);
+    for (int i = 0; i < 80000; ++i) grlc_agg_push(&a, INT16_MIN, nullptr);
+    EXPECT_EQ(grlc_agg_ema(&a), INT16_MIN);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file test_delta.cpp
+ * @brief Unit tests for the zigzag-varint delta codec
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+extern "C" {
+#include "utils/delta/inc/delta.h"
+}
+
+static std::vector<uint8_t> encode(uint8_t order, const std::vector<int32_t> &v)
+{
+    delta_enc_t sz;
+    grlc_delta_enc_init(&sz, order, nullptr, 0);
+    for (int32_t x : v) grlc_delta_enc_push(&sz, x);
+    std::vector<uint8_t> out(grlc_delta_enc_finish(&sz));
+
+    delta_enc_t e;
+    grlc_delta_enc_init(&e, order, out.data(), out.size());
+    for (int32_t x : v) grlc_delta_enc_push(&e, x);
+    EXPECT_EQ(grlc_delta_enc_finish(&e), out.size());
+    return out;
+}
+
+static std::vector<int32_t> decode(uint8_t order, const std::vector<uint8_t> &in, size_t n)
+{
+    std::vector<int32_t> out(n);
+    EXPECT_EQ(grlc_delta_decode(in.data(), in.size(), order, out.data(), n), in.size());
+    return out;
+}
+
+TEST(Delta, RoundTripsEveryOrder)
+{
+    const std::vector<int32_t> v = {3200, 3201, 3199, -5, 0, INT32_MAX, INT32_MIN, 7, 7, 7};
+    for (uint8_t order = 0; order <= GRLC_DELTA_ORDER_MAX; ++order) {
+        EXPECT_EQ(decode(order, encode(order, v), v.size()), v) << "order " << int(order);
+    }
+}
+
+TEST(Delta, PredictorsCollapseRegularSeries)
+{
+    // Constant: one base literal, then a single run token (2 bytes each)
+    std::vector<int32_t> flat(100, 3200);
+    EXPECT_EQ(encode(1, flat).size(), 2u + 2u);
+
+    // Linear timestamps: order 2 reduces them to base, slope, run
+    std::vector<int32_t> ts;
+    for (int i = 0; i < 100; ++i) ts.push_back(50000 + 1000 * i);
+    auto packed = encode(2, ts);
+    EXPECT_LE(packed.size(), 3u + 3u + 1u);
+    EXPECT_EQ(decode(2, packed, ts.size()), ts);
+
+    // Small residuals take one byte each
+    std::vector<int32_t> noisy = {0, 1, -1, 31, -32};
+    EXPECT_EQ(encode(0, noisy).size(), 1u + 4u);
+}
+
+TEST(Delta, SizeOnlyPassMatchesAndShortBufferIsNotOverrun)
+{
+    std::vector<int32_t> v = {100000, -100000, 1, 2, 3};
+    auto full = encode(0, v);
+    uint8_t small[4] = {0xAA, 0xAA, 0xAA, 0xAA};
+    delta_enc_t e;
+    grlc_delta_enc_init(&e, 0, small, 2);
+    for (int32_t x : v) grlc_delta_enc_push(&e, x);
+    EXPECT_EQ(grlc_delta_enc_finish(&e), full.size());
+    EXPECT_EQ(small[2], 0xAA);
+    EXPECT_EQ(small[3], 0xAA);
+}
+
+TEST(Delta, RejectsMalformedStreams)
+{
+    int32_t out[4];
+    // Truncated varint
+    const uint8_t trunc[] = {0x80};
+    EXPECT_EQ(grlc_delta_decode(trunc, sizeof(trunc), 0, out, 1), 0u);
+    // Too few tokens
+    const uint8_t one[] = {0x02};
+    EXPECT_EQ(grlc_delta_decode(one, sizeof(one), 0, out, 2), 0u);
+    // Run longer than requested, and an empty run
+    const uint8_t run5[] = {(5 << 1) | 1};
+    EXPECT_EQ(grlc_delta_decode(run5, sizeof(run5), 1, out, 4), 0u);
+    const uint8_t run0[] = {0x01};
+    EXPECT_EQ(grlc_delta_decode(run0, sizeof(run0), 1, out, 1), 0u);
+    // Token longer than GRLC_DELTA_TOKEN_MAX bytes
+    const uint8_t longtok[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x00};
+    EXPECT_EQ(grlc_delta_decode(longtok, sizeof(longtok), 0, out, 1), 0u);
+    // Unknown order
+    EXPECT_EQ(grlc_delta_decode(one, sizeof(one), GRLC_DELTA_ORDER_MAX + 1, out, 1), 0u);
+}
@@ -0,0 +1,34 @@
+/**
+ * @file test_schedule.cpp
+ * @brief Unit tests for the fixed-rate scheduling helpers
+ */
+
+#include <gtest/gtest.h>
+
+extern "C" {
+#include "utils/schedule/inc/schedule.h"
+}
+
+TEST(Schedule, DueAtDeadlineOrWhenForced)
+{
+    EXPECT_FALSE(grlc_sched_due(1000, false, 999));
+    EXPECT_TRUE(grlc_sched_due(1000, false, 1000));
+    EXPECT_TRUE(grlc_sched_due(1000, true, 0));
+    // Across the 32-bit wrap
+    EXPECT_FALSE(grlc_sched_due(5, false, 0xFFFFFFF0u));
+    EXPECT_TRUE(grlc_sched_due(0xFFFFFFF0u, false, 5));
+}
+
+TEST(Schedule, AdvancesByOnePeriodWithoutDrift)
+{
+    // Late by less than a period: keep the original phase
+    EXPECT_EQ(grlc_sched_advance(1000, false, 1030, 100), 1100u);
+    EXPECT_EQ(grlc_sched_advance(0xFFFFFFC0u, false, 0xFFFFFFD0u, 100), 0x24u);
+}
+
+TEST(Schedule, RestartsAfterStallOrForcedRun)
+{
+    EXPECT_EQ(grlc_sched_advance(1000, false, 1100, 100), 1200u);
+    EXPECT_EQ(grlc_sched_advance(1000, false, 5000, 100), 5100u);
+    EXPECT_EQ(grlc_sched_advance(1000, true, 400, 100), 500u);
+}